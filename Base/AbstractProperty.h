@@ -11,10 +11,14 @@
 #ifndef GUI_ABSTRACT_PROPERTY_H
 #define GUI_ABSTRACT_PROPERTY_H
 
+#include "PoolAllocator.h"
 #include <Util/ReferenceCounter.h>
+#include <Util/References.h>
 #include <Util/TypeNameMacro.h>
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace GUI{
 typedef uint8_t propertyId_t;
@@ -28,9 +32,13 @@ class DisplayProperty : public Util::ReferenceCounter<DisplayProperty> {
 
 		propertyId_t propertyId;
 	public:
-		DisplayProperty(propertyId_t _propertyId) : propertyId(_propertyId) {}
+		DisplayProperty(propertyId_t _propertyId) : propertyId(_propertyId),modificationCount(0) {}
 		virtual ~DisplayProperty() {}
 
+		//! DisplayProperties are allocated from the PoolAllocator.
+		static void * operator new(size_t size)				{	return PoolAllocator::getDefault().allocate(size);	}
+		static void operator delete(void * p,size_t size)	{	PoolAllocator::getDefault().deallocate(p,size);	}
+
 		propertyId_t getPropertyId()const			{	return propertyId;	}
 
 		void enable(StyleManager & s)		{	doEnable(s);	}
@@ -39,8 +47,19 @@ class DisplayProperty : public Util::ReferenceCounter<DisplayProperty> {
 		//! ---o
 		virtual void doEnable(StyleManager & s)=0;
 		virtual void doDisable(StyleManager & s)=0;
+
+		/*! Counter that is increased whenever a value of this property is changed.
+			Used by the StyleManager to detect outdated resolved styles of the components using the property. */
+		uint32_t getModificationCount()const		{	return modificationCount;	}
+	protected:
+		//! Has to be called by subclasses whenever a value influencing doEnable(...) is changed.
+		void markModified()							{	++modificationCount;	}
+	private:
+		uint32_t modificationCount;
 };
 
+typedef std::vector<Util::Reference<DisplayProperty>,PoolAllocatorAdapter<Util::Reference<DisplayProperty>>> displayPropertyList_t;
+
 }
 
 #endif // GUI_ABSTRACT_PROPERTY_H
@@ -20,7 +20,8 @@ class Component;
 	To start an animation, an appropriate AnimationHandler has to be created
 	and registered at the GUI_Manager via addAnimationHandler.
 	The GUI_Manager deletes the AnimationHandler Object when the animation has
-	finished. */
+	finished.
+	\see TweenAnimation for animating a single value (e.g. a rect, a position or a color). */
 class AnimationHandler{
 	public:
 
@@ -0,0 +1,182 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Animator.h"
+#include "AnimationHandler.h"
+#include "../Components/Component.h"
+
+namespace GUI{
+
+//! (ctor)
+Animator::Slot::Slot() : component(nullptr),generation(0),activeIndex(0),prevOfComponent(NONE),nextOfComponent(NONE) {
+}
+
+//! (ctor)
+Animator::Animator() : firstFree(NONE),executing(false) {
+}
+
+//! (dtor)
+Animator::~Animator() = default;
+
+//! (internal)
+int32_t Animator::getSlotIndex(handle_t handle)const{
+	const uint32_t index = static_cast<uint32_t>(handle);
+	if(index>=slots.size() || slots[index].generation!=static_cast<uint32_t>(handle>>32) || (slots[index].generation&1)==0)
+		return NONE;
+	return static_cast<int32_t>(index);
+}
+
+Animator::handle_t Animator::add(AnimationHandler * handler,float startTime){
+	if(handler==nullptr)
+		return 0;
+	int32_t index = firstFree;
+	if(index==NONE){
+		index = static_cast<int32_t>(slots.size());
+		slots.emplace_back();
+	}else{
+		firstFree = slots[index].nextOfComponent;
+	}
+	Slot & slot = slots[index];
+	++slot.generation;
+	slot.handler.reset(handler);
+	slot.component = handler->getComponent();
+	slot.activeIndex = static_cast<uint32_t>(active.size());
+	active.push_back(index);
+
+	// link as first animation of the component
+	slot.prevOfComponent = NONE;
+	const auto it = firstOfComponent.find(slot.component);
+	if(it==firstOfComponent.end()){
+		slot.nextOfComponent = NONE;
+		firstOfComponent.emplace(slot.component,index);
+	}else{
+		slot.nextOfComponent = it->second;
+		slots[it->second].prevOfComponent = index;
+		it->second = index;
+	}
+
+	handler->setStartTime(startTime);
+	return toHandle(index,slot.generation);
+}
+
+//! (internal)
+std::unique_ptr<AnimationHandler> Animator::remove(int32_t index){
+	Slot & slot = slots[index];
+
+	// unlink from the component's list
+	if(slot.prevOfComponent!=NONE){
+		slots[slot.prevOfComponent].nextOfComponent = slot.nextOfComponent;
+	}else if(slot.nextOfComponent!=NONE){
+		firstOfComponent[slot.component] = slot.nextOfComponent;
+	}else{
+		firstOfComponent.erase(slot.component);
+	}
+	if(slot.nextOfComponent!=NONE)
+		slots[slot.nextOfComponent].prevOfComponent = slot.prevOfComponent;
+
+	// remove from the dense array by moving the last entry into the gap
+	const int32_t lastIndex = active.back();
+	active[slot.activeIndex] = lastIndex;
+	slots[lastIndex].activeIndex = slot.activeIndex;
+	active.pop_back();
+
+	std::unique_ptr<AnimationHandler> handler = std::move(slot.handler);
+	++slot.generation;
+	slot.component = nullptr;
+	slot.prevOfComponent = NONE;
+	slot.nextOfComponent = firstFree;
+	firstFree = index;
+	return handler;
+}
+
+//! (internal)
+void Animator::dispose(std::unique_ptr<AnimationHandler> handler){
+	if(executing)
+		disposedHandlers.emplace_back(std::move(handler));
+}
+
+bool Animator::cancel(handle_t handle){
+	const int32_t index = getSlotIndex(handle);
+	if(index==NONE)
+		return false;
+	dispose(remove(index));
+	return true;
+}
+
+bool Animator::finish(handle_t handle){
+	const int32_t index = getSlotIndex(handle);
+	if(index==NONE)
+		return false;
+	std::unique_ptr<AnimationHandler> handler = remove(index);
+	handler->finish();
+	dispose(std::move(handler));
+	return true;
+}
+
+bool Animator::isRunning(handle_t handle)const{
+	return getSlotIndex(handle)!=NONE;
+}
+
+//! (internal)
+void Animator::collectHandles(const Component * c,std::vector<handle_t> & handles)const{
+	const auto it = firstOfComponent.find(c);
+	if(it==firstOfComponent.end())
+		return;
+	for(int32_t index=it->second;index!=NONE;index=slots[index].nextOfComponent)
+		handles.push_back(toHandle(index,slots[index].generation));
+}
+
+void Animator::stopAnimations(const Component * c){
+	const auto it = firstOfComponent.find(c);
+	if(it==firstOfComponent.end())
+		return;
+	int32_t index = it->second;
+	while(index!=NONE){
+		const int32_t next = slots[index].nextOfComponent;
+		dispose(remove(index));
+		index = next;
+	}
+}
+
+void Animator::finishAnimations(const Component * c){
+	// finish() may start new animations; only the animations running now are finished.
+	std::vector<handle_t> handles;
+	collectHandles(c,handles);
+	for(const auto & handle : handles)
+		finish(handle);
+}
+
+void Animator::execute(float time){
+	if(executing)
+		return;
+	executing = true;
+	executedHandles.clear();
+	for(const auto & index : active)
+		executedHandles.push_back(toHandle(index,slots[index].generation));
+
+	for(const auto & handle : executedHandles){
+		const int32_t index = getSlotIndex(handle);
+		if(index==NONE) // removed by a previous animation
+			continue;
+		AnimationHandler * handler = slots[index].handler.get();
+		const bool running = handler->animate(time);
+		if(getSlotIndex(handle)==NONE) // removed by itself
+			continue;
+		if(running){
+			handler->updateLastTime(time);
+		}else{
+			dispose(remove(index));
+		}
+	}
+	executing = false;
+	disposedHandlers.clear();
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_ANIMATOR_H
+#define GUI_ANIMATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace GUI{
+class AnimationHandler;
+class Component;
+
+/*! Storage and execution of the running AnimationHandlers (used by the GUI_Manager).
+	The handlers are kept in a dense array that is iterated once per frame; additionally, the
+	handlers of each component are linked in a list, so that stopping or finishing the animations
+	of one component only touches these animations. Adding and canceling an animation is O(1).
+	Handlers that are removed while the animations are executed are deleted after the execution,
+	so an animation may safely stop or finish animations (including itself).	*/
+class Animator{
+	public:
+		//! Identifies a running animation; 0 is never used as a valid handle.
+		typedef uint64_t handle_t;
+
+		GUIAPI Animator();
+		GUIAPI ~Animator();
+
+		//! Take ownership of the handler and start it at the given time.
+		GUIAPI handle_t add(AnimationHandler * handler,float startTime);
+		//! Remove the animation without calling finish(). Returns false if the animation is not running.
+		GUIAPI bool cancel(handle_t handle);
+		//! Call finish() and remove the animation. Returns false if the animation is not running.
+		GUIAPI bool finish(handle_t handle);
+		GUIAPI bool isRunning(handle_t handle)const;
+
+		//! Remove all animations of the component without calling finish().
+		GUIAPI void stopAnimations(const Component * c);
+		//! Call finish() for all animations of the component and remove them.
+		GUIAPI void finishAnimations(const Component * c);
+		bool hasAnimations(const Component * c)const			{	return firstOfComponent.count(c)>0;	}
+
+		size_t getAnimationCount()const							{	return active.size();	}
+		bool empty()const										{	return active.empty();	}
+
+		/*! Call animate() for every running animation (animations added in the meantime start with the next call)
+			and remove the finished animations.	*/
+		GUIAPI void execute(float time);
+
+	private:
+		Animator(const Animator &) = delete;
+		Animator & operator=(const Animator &) = delete;
+
+		static const int32_t NONE = -1;
+		struct Slot{
+			std::unique_ptr<AnimationHandler> handler;
+			const Component * component;
+			uint32_t generation;		//!< odd while the slot is used
+			uint32_t activeIndex;		//!< position in active
+			int32_t prevOfComponent;
+			int32_t nextOfComponent;	//!< also used for the list of free slots
+			Slot(); // not inline, as AnimationHandler is incomplete here
+		};
+
+		static handle_t toHandle(int32_t index,uint32_t generation)	{	return (static_cast<uint64_t>(generation)<<32) | static_cast<uint32_t>(index);	}
+		int32_t getSlotIndex(handle_t handle)const;
+		//! (internal) Unlink the animation and release its slot; returns the handler.
+		std::unique_ptr<AnimationHandler> remove(int32_t index);
+		//! (internal) Delete the handler (or keep it until the end of execute()).
+		void dispose(std::unique_ptr<AnimationHandler> handler);
+		void collectHandles(const Component * c,std::vector<handle_t> & handles)const;
+
+		std::vector<Slot> slots;
+		int32_t firstFree;
+		std::vector<int32_t> active; //!< indices of the used slots
+		std::unordered_map<const Component *,int32_t> firstOfComponent;
+
+		bool executing;
+		std::vector<handle_t> executedHandles;
+		std::vector<std::unique_ptr<AnimationHandler>> disposedHandlers;
+};
+
+}
+#endif // GUI_ANIMATOR_H
@@ -11,6 +11,7 @@
 */
 #include "Draw.h"
 
+#include "DrawList.h"
 #include "Fonts/AbstractFont.h"
 #include "BasicColors.h"
 #include "../Style/Colors.h" // \todo remove this!!!
@@ -40,12 +41,7 @@
 
 namespace GUI {
 
-struct Vertex {
-	Vertex(const Geometry::Vec2& pos, const Geometry::Vec2& uv, const Util::Color4f& col) : pos(pos), uv(uv), col(col) { }
-	Geometry::Vec2 pos;
-	Geometry::Vec2 uv;
-	Util::Color4f col;
-};
+typedef DrawList::Vertex Vertex;
 
 static const uint32_t maxVertexCount = 3*32768;
 
@@ -120,8 +116,7 @@ struct DrawCommand {
 
 struct DrawContext {
 	uint32_t meshOffset = 0;
-	Geometry::Vec2i position,screenSize;
-	Geometry::Rect_i scissor;
+	Geometry::Vec2i screenSize;
 	Geometry::Vec2 scale;
 	
 	RenderingContext* rc;
@@ -130,7 +125,6 @@ struct DrawContext {
 	Util::Reference<TexCoordAttributeAccessor> posAcc;
 	Util::Reference<ColorAttributeAccessor> colAcc;
 	Util::Reference<TexCoordAttributeAccessor> uvAcc;
-	Util::Reference<ImageData> activeTexture;
 	
 	std::deque<DrawCommand> commands;
 };
@@ -143,13 +137,17 @@ static void updateVertex(uint32_t index, const Vertex& v) {
 	ctxt.colAcc->setColor(index, v.col);
 }
 
+static void updateVertices(uint32_t index, const Vertex* vertices, uint32_t count) {
+	for(uint32_t i=0; i<count; ++i)
+		updateVertex(index+i, vertices[i]);
+}
+
 //-------------------------------------------
 #else // GUI_BACKEND_RENDERING
 
 struct DrawContext {
 	uint32_t meshOffset = 0;
-	Geometry::Vec2i position,screenSize;
-	Geometry::Rect_i scissor;
+	Geometry::Vec2i screenSize;
 	Geometry::Vec2 scale;
 	
 	GLuint shaderProg = 0;
@@ -158,8 +156,6 @@ struct DrawContext {
 	GLint u_texture, u_textureEnabled, u_posOffset, u_screenScale;
 	uint8_t* vboPtr = nullptr;
 	
-	Util::Reference<ImageData> activeTexture;
-	
 	std::deque<DrawCommand> commands;
 };
 
@@ -237,35 +233,83 @@ static void updateVertex(uint32_t index, const Vertex& v) {
 	std::memcpy(ctxt.vboPtr + index * sizeof(Vertex), reinterpret_cast<const uint8_t*>(&v), sizeof(Vertex));
 }
 
+static void updateVertices(uint32_t index, const Vertex* vertices, uint32_t count) {
+	std::memcpy(ctxt.vboPtr + index * sizeof(Vertex), reinterpret_cast<const uint8_t*>(vertices), count * sizeof(Vertex));
+}
+
 //-------------------------------------------
 #endif // GUI_BACKEND_RENDERING
 
+//-------------------------------------------
+
+/*! Cursor, scissor and texture set by the drawing functions. While a thread records a frame, it uses a state
+	of its own, so that another thread can submit the previous frame in the meantime.	*/
+struct DrawState {
+	Geometry::Vec2i position,screenSize;
+	Geometry::Rect_i scissor;
+	Util::Reference<ImageData> activeTexture;
+	std::shared_ptr<DrawList> recording; // nullptr if drawn directly
+};
+
+static DrawState immediateState;
+static thread_local DrawState * state = &immediateState;
+
+//! (internal) Returns the index of the first of @p count new vertices.
+static uint32_t allocateVertices(uint32_t count) {
+	if(state->recording) {
+		state->recording->_getVertices().reserve(state->recording->_getVertices().size()+count);
+		return static_cast<uint32_t>(state->recording->_getVertices().size());
+	}
+	if(ctxt.meshOffset+count > maxVertexCount)
+		Draw::flush();
+	const uint32_t start = ctxt.meshOffset;
+	ctxt.meshOffset += count;
+	return start;
+}
+
+//! (internal) Set the vertices allocated by allocateVertices() in ascending order.
+static void storeVertex(uint32_t index, const Vertex& v) {
+	if(state->recording)
+		state->recording->_getVertices().push_back(v);
+	else
+		updateVertex(index, v);
+}
+
+//! (internal)
+static void addCommand(uint32_t start, uint32_t count, draw_mode_t mode, bool blending, const Util::Reference<ImageData> & texture=nullptr) {
+	if(state->recording) {
+		// the submitting thread uploads a copy of changed data, as the bitmap may be changed for the next frame.
+		if(texture.isNotNull()) {
+			Util::Reference<Util::Bitmap> changedData = texture->_takeChangedData();
+			if(changedData.isNotNull())
+				state->recording->_getTextureUploads().emplace_back(texture, std::move(changedData));
+		}
+		state->recording->_getCommands().emplace_back(DrawList::Command::DRAW, start, count, state->position, state->scissor,
+												static_cast<uint32_t>(mode), blending, texture, Util::Color4ub());
+	} else
+		ctxt.commands.emplace_back(start, count, state->position, state->scissor, mode, blending, texture);
+}
+
 static void drawVertices(const draw_mode_t mode, const std::vector<Geometry::Vec2>& vertices, const Util::Color4f& color, bool blending=false, uint32_t offset=0, uint32_t count=0) {
 	if(count == 0)
 		count = static_cast<uint32_t>(vertices.size());
 
-	if(ctxt.meshOffset+count > maxVertexCount)
-		Draw::flush();
-	
+	const uint32_t start = allocateVertices(count);
 	for(uint32_t i=0; i<count; ++i)
-		updateVertex(ctxt.meshOffset+i, {vertices[offset+i], {0,0}, color});
+		storeVertex(start+i, {vertices[offset+i], {0,0}, color});
 	
-	ctxt.commands.emplace_back(ctxt.meshOffset, count, ctxt.position, ctxt.scissor, mode, blending);
-	ctxt.meshOffset += count;
+	addCommand(start, count, mode, blending);
 }
 
 static void drawVertices(const draw_mode_t mode, const std::vector<Geometry::Vec2>& vertices, const std::vector<Util::Color4f>& colors, bool blending=false, uint32_t offset=0, uint32_t count=0) {
 	if(count == 0)
 		count = static_cast<uint32_t>(vertices.size());
 
-	if(ctxt.meshOffset+count > maxVertexCount)
-		Draw::flush();
-
+	const uint32_t start = allocateVertices(count);
 	for(uint32_t i=0; i<count; ++i)
-		updateVertex(ctxt.meshOffset+i, {vertices[offset+i], {0,0}, colors[offset+i]});
+		storeVertex(start+i, {vertices[offset+i], {0,0}, colors[offset+i]});
 	
-	ctxt.commands.emplace_back(ctxt.meshOffset, count, ctxt.position, ctxt.scissor, mode, blending);
-	ctxt.meshOffset += count;
+	addCommand(start, count, mode, blending);
 }
 
 static void drawTexturedVertices(const draw_mode_t mode, const std::vector<Geometry::Vec2>& vertices, const std::vector<Geometry::Vec2>& uvs, const Util::Color4f& color, bool blending=false, uint32_t offset=0, uint32_t count=0) {
@@ -273,14 +317,11 @@ static void drawTexturedVertices(const draw_mode_t mode, const std::vector<Geome
 	if(count == 0)
 		count = static_cast<uint32_t>(vertices.size());
 
-	if(ctxt.meshOffset+count > maxVertexCount)
-		Draw::flush();
-		
+	const uint32_t start = allocateVertices(count);
 	for(uint32_t i=0; i<count; ++i)
-		updateVertex(ctxt.meshOffset+i, {vertices[offset+i], uvs[offset+i], color});
+		storeVertex(start+i, {vertices[offset+i], uvs[offset+i], color});
 	
-	ctxt.commands.emplace_back(ctxt.meshOffset, count, ctxt.position, ctxt.scissor, mode, blending, ctxt.activeTexture);
-	ctxt.meshOffset += count;
+	addCommand(start, count, mode, blending, state->activeTexture);
 }
 
 //! (internal)
@@ -390,8 +431,9 @@ void Draw::beginDrawing(Rendering::RenderingContext& rc, const Geometry::Vec2i &
 		init();
 	}
 	
-	ctxt.position = Geometry::Vec2(0,0);
-	ctxt.activeTexture = nullptr;
+	state->position = Geometry::Vec2(0,0);
+	state->activeTexture = nullptr;
+	state->screenSize = screenSize;
 	ctxt.screenSize = screenSize;
 	ctxt.scale = renderScale;
 	ctxt.meshOffset = 0;
@@ -427,8 +469,9 @@ void Draw::beginDrawing(const Geometry::Vec2i & screenSize){
 	
 	GET_GL_ERROR();
 	
-	ctxt.position = Geometry::Vec2(0,0);
-	ctxt.activeTexture = nullptr;
+	state->position = Geometry::Vec2(0,0);
+	state->activeTexture = nullptr;
+	state->screenSize = screenSize;
 	ctxt.screenSize = screenSize;
 	ctxt.meshOffset = 0;
 	resetScissor();
@@ -444,7 +487,7 @@ void Draw::beginDrawing(const Geometry::Vec2i & screenSize){
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	glUseProgram(ctxt.shaderProg);
-	glUniform2f(ctxt.u_posOffset,ctxt.position.x(),ctxt.position.y());
+	glUniform2f(ctxt.u_posOffset,state->position.x(),state->position.y());
 	glUniform1i(ctxt.u_texture,0);
 	glUniform1i(ctxt.u_textureEnabled,0);
 	glUniform2f(ctxt.u_screenScale,2.0/screenSize.getWidth(),-2.0/screenSize.getHeight());
@@ -452,7 +495,7 @@ void Draw::beginDrawing(const Geometry::Vec2i & screenSize){
 	
 	// use 1x1 white texture as backup for graphic drivers that access the sampler even in disabled branches...
 	glBindTexture(GL_TEXTURE_2D, 0);
-	ctxt.activeTexture = nullptr;
+	state->activeTexture = nullptr;
 	
 	// bind vertex buffer
 	glBindBuffer(GL_ARRAY_BUFFER, ctxt.vertexBuffer);
@@ -499,14 +542,16 @@ void Draw::endDrawing() {
 		glDisableVertexAttribArray(ctxt.attr_color);
 		glDisableVertexAttribArray(ctxt.attr_uv);
 		glBindTexture(GL_TEXTURE_2D,0);
-		ctxt.activeTexture = nullptr;
+		state->activeTexture = nullptr;
 	#endif // GUI_BACKEND_RENDERING
 	GET_GL_ERROR();
 }
 
 
 //! (static)
-void Draw::flush() {	
+void Draw::flush() {
+	if(state->recording) // the commands are kept in the draw list
+		return;
 	#ifdef GUI_BACKEND_RENDERING
 		BlendingParameters blending(BlendingParameters::SRC_ALPHA, BlendingParameters::ONE_MINUS_SRC_ALPHA);
 		ctxt.mesh->openVertexData().markAsChanged();
@@ -562,21 +607,26 @@ void Draw::flush() {
 
 //! (static)
 void Draw::moveCursor(const Geometry::Vec2i & pos) {
-	ctxt.position += pos;
+	state->position += pos;
 }
 
 //! (static)
 void Draw::setScissor(const Geometry::Rect_i & rect) {
-	ctxt.scissor = {rect.getX(), ctxt.screenSize.getHeight()-rect.getY()-rect.getHeight(), rect.getWidth(), rect.getHeight()};
+	state->scissor = {rect.getX(), state->screenSize.getHeight()-rect.getY()-rect.getHeight(), rect.getWidth(), rect.getHeight()};
 }
 
 //! (static)
 void Draw::resetScissor() {
-	ctxt.scissor = {0,0,ctxt.screenSize.getWidth(),ctxt.screenSize.getHeight()};
+	state->scissor = {0,0,state->screenSize.getWidth(),state->screenSize.getHeight()};
 }
 
 //! (static)
 void Draw::clearScreen(const Util::Color4ub & color) {
+	if(state->recording) {
+		state->recording->_getCommands().emplace_back(DrawList::Command::CLEAR, 0, 0, state->position, state->scissor,
+												0, false, nullptr, color);
+		return;
+	}
 	flush();
 	#ifdef GUI_BACKEND_RENDERING
 		ctxt.rc->clearScreen(color);
@@ -588,8 +638,10 @@ void Draw::clearScreen(const Util::Color4ub & color) {
 
 //! (static)
 Geometry::Rect_i Draw::queryViewport() {
+	if(state->recording)
+		return {0,0,state->screenSize.getWidth(),state->screenSize.getHeight()};
 	#ifdef GUI_BACKEND_RENDERING
-		return {0,0,ctxt.screenSize.getWidth(),ctxt.screenSize.getHeight()};
+		return {0,0,state->screenSize.getWidth(),state->screenSize.getHeight()};
 	#else // GUI_BACKEND_RENDERING
 		GLint viewport[4];
 		glGetIntegerv(GL_VIEWPORT, viewport );
@@ -948,11 +1000,87 @@ void Draw::drawTriangleFan(const std::vector<float> & vertices,const std::vector
 // texture
 
 void Draw::disableTexture() {
-	ctxt.activeTexture = nullptr;
+	state->activeTexture = nullptr;
 }
 	
 void Draw::enableTexture(ImageData* texture) {
-	ctxt.activeTexture = texture;
+	state->activeTexture = texture;
+}
+
+//----------------------------------------------------------------------------------
+// recording
+
+//! (static)
+void Draw::beginRecording(const Geometry::Vec2i & screenSize, const Geometry::Vec2 & renderScale) {
+	if(state->recording) {
+		WARN("Draw::beginRecording: already recording.");
+		return;
+	}
+	static thread_local DrawState recordingState;
+	recordingState.recording = std::make_shared<DrawList>(screenSize, renderScale);
+	recordingState.position = Geometry::Vec2i(0,0);
+	recordingState.screenSize = screenSize;
+	recordingState.activeTexture = nullptr;
+	state = &recordingState;
+	resetScissor();
+}
+
+//! (static)
+std::shared_ptr<const DrawList> Draw::endRecording() {
+	std::shared_ptr<DrawList> list;
+	if(state->recording) {
+		std::swap(list, state->recording);
+		state->activeTexture = nullptr;
+		state = &immediateState;
+	} else {
+		WARN("Draw::endRecording: not recording.");
+	}
+	return list;
+}
+
+//! (static)
+bool Draw::isRecording() {
+	return static_cast<bool>(state->recording);
+}
+
+//! (static)
+void Draw::uploadTextures(const DrawList & list) {
+	#ifndef GUI_BACKEND_RENDERING
+		for(const auto & upload : list.getTextureUploads())
+			upload.texture->uploadGLTexture(*upload.data.get());
+	#endif // GUI_BACKEND_RENDERING
+}
+
+#ifdef GUI_BACKEND_RENDERING
+//! (static)
+void Draw::submit(Rendering::RenderingContext& rc, const DrawList & list) {
+	beginDrawing(rc, list.getScreenSize(), list.getRenderScale());
+#else // GUI_BACKEND_RENDERING
+//! (static)
+void Draw::submit(const DrawList & list) {
+	beginDrawing(list.getScreenSize());
+#endif // GUI_BACKEND_RENDERING
+	uploadTextures(list);
+	const auto & vertices = list.getVertices();
+	for(const auto & cmd : list.getCommands()) {
+		if(cmd.type == DrawList::Command::CLEAR) {
+			clearScreen(cmd.clearColor);
+			continue;
+		}
+		if(cmd.count == 0)
+			continue;
+		if(cmd.count > maxVertexCount) {
+			WARN("Draw::submit: too many vertices in a single command.");
+			continue;
+		}
+		if(ctxt.meshOffset+cmd.count > maxVertexCount)
+			flush();
+		updateVertices(ctxt.meshOffset, vertices.data()+cmd.start, cmd.count);
+		ctxt.commands.emplace_back(ctxt.meshOffset, cmd.count, cmd.offset, cmd.scissor, static_cast<draw_mode_t>(cmd.mode),
+									cmd.blending, cmd.texture);
+		ctxt.meshOffset += cmd.count;
+	}
+	endDrawing();
 }
 
 //----------------------------------------------------------------------------------
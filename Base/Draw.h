@@ -14,6 +14,7 @@
 #include <Geometry/Vec2.h>
 #include <Geometry/Rect.h>
 #include <Util/Graphics/Color.h>
+#include <memory>
 
 #ifdef GUI_BACKEND_RENDERING
 namespace Rendering {
@@ -23,6 +24,7 @@ class RenderingContext;
 namespace GUI {
 
 class AbstractFont;
+class DrawList;
 class ImageData;
 
 class Draw {
@@ -89,6 +91,25 @@ class Draw {
 		// textures
 		GUIAPI static void enableTexture(ImageData* texture);
 		GUIAPI static void disableTexture();
+
+		// recording
+		/*! Record the following drawing operations of the calling thread into a DrawList instead of
+			drawing them (beginDrawing()/endDrawing() are not called while recording). Other threads are
+			not affected, so the previous frame can be submitted concurrently.
+			\note Operations which need the graphics context (like getRenderingContext()) are not available while recording.	*/
+		GUIAPI static void beginRecording(const Geometry::Vec2i & screenSize, const Geometry::Vec2 & renderScale={1.0f,1.0f});
+		//! Finish the recording of the calling thread; returns nullptr if it was not recording.
+		GUIAPI static std::shared_ptr<const DrawList> endRecording();
+		GUIAPI static bool isRecording();
+		/*! Upload the texture data copied while recording the list (part of submit()). Has to be called on the
+			thread owning the graphics context for recorded lists that are not submitted (e.g. dropped frames).	*/
+		GUIAPI static void uploadTextures(const DrawList & list);
+		//! Draw a recorded list (including beginDrawing() and endDrawing()) on the thread owning the graphics context.
+#ifdef GUI_BACKEND_RENDERING
+		GUIAPI static void submit(Rendering::RenderingContext& rc, const DrawList & list);
+#else // GUI_BACKEND_RENDERING
+		GUIAPI static void submit(const DrawList & list);
+#endif // GUI_BACKEND_RENDERING
 };
 
 }
@@ -0,0 +1,87 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_DRAW_LIST_H
+#define GUI_DRAW_LIST_H
+
+#include "ImageData.h"
+#include <Geometry/Rect.h>
+#include <Geometry/Vec2.h>
+#include <Util/Graphics/Bitmap.h>
+#include <Util/Graphics/Color.h>
+#include <Util/References.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GUI{
+
+/*! Self-contained recording of a frame (see Draw::beginRecording()): All vertices, the draw commands,
+	references to the used textures and copies of the texture data that changed since the previous frame.
+	A recorded list is not changed anymore, so it can be submitted by another thread (see Draw::submit()
+	and RenderThread) while the next frame is recorded.	*/
+class DrawList{
+	public:
+		struct Vertex {
+			Vertex(const Geometry::Vec2& pos, const Geometry::Vec2& uv, const Util::Color4f& col) : pos(pos), uv(uv), col(col) { }
+			Geometry::Vec2 pos;
+			Geometry::Vec2 uv;
+			Util::Color4f col;
+		};
+
+		struct Command {
+			enum type_t { DRAW, CLEAR };
+			type_t type;
+			uint32_t start;				//!< index of the first vertex in the list
+			uint32_t count;
+			Geometry::Vec2f offset;
+			Geometry::Rect_i scissor;
+			uint32_t mode;				//!< primitive type of the backend
+			bool blending;
+			Util::Reference<ImageData> texture;
+			Util::Color4ub clearColor;	//!< only used by CLEAR
+			Command(type_t type, uint32_t start, uint32_t count, Geometry::Vec2f offset, Geometry::Rect_i scissor,
+					uint32_t mode, bool blending, Util::Reference<ImageData> texture, Util::Color4ub clearColor) :
+				type(type), start(start), count(count), offset(offset), scissor(scissor), mode(mode), blending(blending),
+				texture(std::move(texture)), clearColor(clearColor) {}
+		};
+
+		//! Texture data to upload before the commands are executed (see ImageData::_takeChangedData()).
+		struct TextureUpload {
+			Util::Reference<ImageData> texture;
+			Util::Reference<Util::Bitmap> data;
+			TextureUpload(Util::Reference<ImageData> texture, Util::Reference<Util::Bitmap> data) :
+				texture(std::move(texture)), data(std::move(data)) {}
+		};
+
+		DrawList(const Geometry::Vec2i & _screenSize, const Geometry::Vec2 & _renderScale) :
+				screenSize(_screenSize), renderScale(_renderScale) {}
+
+		const Geometry::Vec2i & getScreenSize()const			{	return screenSize;	}
+		const Geometry::Vec2 & getRenderScale()const			{	return renderScale;	}
+		const std::vector<Vertex> & getVertices()const			{	return vertices;	}
+		const std::vector<Command> & getCommands()const			{	return commands;	}
+		const std::vector<TextureUpload> & getTextureUploads()const	{	return textureUploads;	}
+		//! (internal) Used by Draw while recording.
+		std::vector<Vertex> & _getVertices()					{	return vertices;	}
+		//! (internal) Used by Draw while recording.
+		std::vector<Command> & _getCommands()					{	return commands;	}
+		//! (internal) Used by Draw while recording.
+		std::vector<TextureUpload> & _getTextureUploads()		{	return textureUploads;	}
+	private:
+		Geometry::Vec2i screenSize;
+		Geometry::Vec2 renderScale;
+		std::vector<Vertex> vertices;
+		std::vector<Command> commands;
+		std::vector<TextureUpload> textureUploads;
+};
+
+}
+#endif // GUI_DRAW_LIST_H
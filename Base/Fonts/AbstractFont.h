@@ -33,6 +33,7 @@ class AbstractFont : public Util::ReferenceCounter<AbstractFont> {
 		virtual void enable()	{	}
 		virtual void disable()	{	}
 		virtual void renderText( const Geometry::Vec2 & pos, const std::string & text, const Util::Color4ub & color )=0;
+		//! \note Has to be thread safe, as it is called by the threads of the parallel layout (see Component::INDEPENDENT_LAYOUT).
 		virtual Geometry::Vec2 getRenderedTextSize( const std::string & text )=0;
 
 		uint32_t getLineHeight()const				{	return lineHeight;	}
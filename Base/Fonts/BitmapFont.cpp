@@ -160,6 +160,7 @@ void BitmapFont::renderText( const Vec2 & _pos, const std::string & text, const
 }
 
 //!	---|> AbstractFont
+//! \note Thread safe as long as no glyphs or kerning pairs are added, as the tables are only read.
 Vec2 BitmapFont::getRenderedTextSize( const std::string & text ){
 	float maxX = 0;
 	float x = 0;
@@ -11,6 +11,7 @@
 #include "ImageData.h"
 
 #include "Draw.h"
+#include <Util/Graphics/Bitmap.h>
 #include <Util/Graphics/PixelAccessor.h>
 
 #ifdef GUI_BACKEND_RENDERING
@@ -73,6 +74,21 @@ bool ImageData::uploadGLTexture() {
 	return true;
 }
 
+bool ImageData::uploadGLTexture(const Util::Bitmap & /*bitmap*/) {
+	// ignore
+	return true;
+}
+
+bool ImageData::prepareGLTexture() {
+	// ignore
+	return true;
+}
+
+Util::Reference<Util::Bitmap> ImageData::_takeChangedData() {
+	// the texture is uploaded by the rendering context
+	return nullptr;
+}
+
 void ImageData::removeGLData() {
 	// ignore
 }
@@ -85,10 +101,10 @@ uint32_t ImageData::getTextureId() {
 #else // GUI_BACKEND_RENDERING
 
 struct ImageData::InternalData {
-	InternalData(Util::Reference<Util::Bitmap>& _bitmap) : bitmap(_bitmap) {}
+	InternalData(Util::Reference<Util::Bitmap>& _bitmap) : bitmap(_bitmap), dataHasChanged(true) {}
 	Util::Reference<Util::Bitmap> bitmap;
-	uint32_t textureId = 0;
-	bool dataHasChanged = true;
+	uint32_t textureId = 0; // only accessed by the thread owning the graphics context
+	std::atomic<bool> dataHasChanged; // set by the GUI's thread, cleared when the data is uploaded or copied for an upload
 };
 
 //! (ctor)
@@ -108,14 +124,16 @@ const Util::Reference<Util::Bitmap> ImageData::getBitmap() const {
 }
 
 bool ImageData::enable() {
-	if( (data->textureId == 0 || data->dataHasChanged) && !uploadGLTexture() )
+	// while a frame is recorded, the texture is uploaded when the frame is submitted.
+	if( !Draw::isRecording() && !prepareGLTexture() )
 		return false;
 	Draw::enableTexture(this);
 	return true;
 }
 
 void ImageData::disable() {
-	if (data->textureId != 0)
+	// while a frame is recorded, the textureId belongs to the submitting thread.
+	if (Draw::isRecording() || data->textureId != 0)
 		Draw::disableTexture();
 }
 
@@ -124,6 +142,15 @@ void ImageData::dataChanged() {
 }
 
 bool ImageData::uploadGLTexture() {
+	data->dataHasChanged = false;
+	if( !uploadGLTexture(*data->bitmap.get()) ) {
+		data->dataHasChanged = true;
+		return false;
+	}
+	return true;
+}
+
+bool ImageData::uploadGLTexture(const Util::Bitmap & bitmap) {
 	if( data->textureId == 0 ) {
 		glPixelStorei(GL_UNPACK_ALIGNMENT,1);
 		glGenTextures(1,&data->textureId);
@@ -140,7 +167,7 @@ bool ImageData::uploadGLTexture() {
 	if( data->textureId == 0 )
 		return false;
 	
-	auto pixelFormat = data->bitmap->getPixelFormat();
+	auto pixelFormat = bitmap.getPixelFormat();
 	GLint glInternalFormat;
 	GLint glFormat;
 	if(pixelFormat==Util::PixelFormat::RGBA){
@@ -171,19 +198,32 @@ bool ImageData::uploadGLTexture() {
 	}
 
 	glBindTexture(GL_TEXTURE_2D, data->textureId);
-	glTexImage2D(GL_TEXTURE_2D,0, glInternalFormat,	data->bitmap->getWidth(), data->bitmap->getHeight(), /*border*/0, glFormat, glDataType, data->bitmap->data());
+	glTexImage2D(GL_TEXTURE_2D,0, glInternalFormat,	bitmap.getWidth(), bitmap.getHeight(), /*border*/0, glFormat, glDataType, bitmap.data());
 	glBindTexture(GL_TEXTURE_2D, 0);	
 
-	data->dataHasChanged = false;
 	return true; 
 }
 
+bool ImageData::prepareGLTexture() {
+	return (data->textureId != 0 && !data->dataHasChanged) || uploadGLTexture();
+}
+
+Util::Reference<Util::Bitmap> ImageData::_takeChangedData() {
+	if( !data->dataHasChanged.exchange(false) )
+		return nullptr;
+	const Util::Bitmap & bitmap = *data->bitmap.get();
+	Util::Reference<Util::Bitmap> copy = new Util::Bitmap(bitmap.getWidth(), bitmap.getHeight(), bitmap.getPixelFormat());
+	std::copy(bitmap.data(), bitmap.data() + bitmap.getDataSize(), copy->data());
+	return copy;
+}
+
 void ImageData::removeGLData() {
 	if(data->textureId != 0) {
 		GLuint glId = static_cast<GLuint>(data->textureId);
 		glDeleteTextures(1,&glId);
 	}
 	data->textureId = 0;
+	data->dataHasChanged = true; // upload again when used
 }
 
 uint32_t ImageData::getTextureId() {
@@ -13,6 +13,7 @@
 
 #include <Util/ReferenceCounter.h>
 #include <Util/References.h>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 
@@ -69,6 +70,15 @@ class ImageData: public Util::ReferenceCounter<ImageData> {
 		GUIAPI Util::Reference<Util::PixelAccessor> createPixelAccessor();
 		
 		GUIAPI bool uploadGLTexture();
+		//! Upload the given data (e.g. a copy taken while recording a frame) instead of the current bitmap.
+		GUIAPI bool uploadGLTexture(const Util::Bitmap & bitmap);
+		//! Upload the texture if it does not exist or its data has changed (on the thread owning the graphics context).
+		GUIAPI bool prepareGLTexture();
+		/*! (internal) Used while recording a frame (see Draw::beginRecording()): If the data has changed since the
+			last call or upload (or the texture has been removed), a copy of the bitmap is returned, which the
+			submitting thread uploads. Otherwise, nullptr is returned. The submitting thread never reads the bitmap
+			itself, so the data may be changed while a recorded frame is submitted.	*/
+		GUIAPI Util::Reference<Util::Bitmap> _takeChangedData();
 		GUIAPI void removeGLData();
 		GUIAPI uint32_t getTextureId();
 	private:
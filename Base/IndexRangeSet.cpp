@@ -0,0 +1,138 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "IndexRangeSet.h"
+#include <algorithm>
+
+namespace GUI{
+
+bool IndexRangeSet::contains(size_t index)const{
+	// first range beginning behind the index
+	auto it = std::upper_bound(ranges.begin(),ranges.end(),index,
+								[](size_t i,const range_t & r){	return i<r.first;	});
+	return it!=ranges.begin() && index<(--it)->second;
+}
+
+void IndexRangeSet::add(size_t first,size_t end){
+	if(first>=end)
+		return;
+	// ranges [lo,hi) overlap or touch [first,end)
+	auto lo = std::lower_bound(ranges.begin(),ranges.end(),first,
+								[](const range_t & r,size_t i){	return r.second<i;	});
+	auto hi = std::upper_bound(lo,ranges.end(),end,
+								[](size_t i,const range_t & r){	return i<r.first;	});
+	if(lo!=hi){
+		first = std::min(first,lo->first);
+		end = std::max(end,(hi-1)->second);
+		for(auto it=lo;it!=hi;++it)
+			indexCount -= it->second-it->first;
+		*lo = range_t(first,end);
+		ranges.erase(lo+1,hi);
+	}else{
+		ranges.insert(lo,range_t(first,end));
+	}
+	indexCount += end-first;
+}
+
+void IndexRangeSet::remove(size_t first,size_t end){
+	if(first>=end)
+		return;
+	// ranges [lo,hi) overlap [first,end)
+	auto lo = std::lower_bound(ranges.begin(),ranges.end(),first,
+								[](const range_t & r,size_t i){	return r.second<=i;	});
+	auto hi = std::lower_bound(lo,ranges.end(),end,
+								[](const range_t & r,size_t i){	return r.first<i;	});
+	if(lo==hi)
+		return;
+	const range_t left(lo->first,first);
+	const range_t right(end,(hi-1)->second);
+	for(auto it=lo;it!=hi;++it)
+		indexCount -= it->second-it->first;
+
+	std::vector<range_t> remainders;
+	if(left.first<left.second)
+		remainders.push_back(left);
+	if(right.first<right.second)
+		remainders.push_back(right);
+	for(const auto & r : remainders)
+		indexCount += r.second-r.first;
+
+	const size_t pos = static_cast<size_t>(lo-ranges.begin());
+	ranges.erase(lo,hi);
+	ranges.insert(ranges.begin()+pos,remainders.begin(),remainders.end());
+}
+
+void IndexRangeSet::toggle(size_t first,size_t end){
+	if(first>=end)
+		return;
+	// collect the gaps between the contained indices
+	std::vector<range_t> gaps;
+	auto it = std::lower_bound(ranges.begin(),ranges.end(),first,
+								[](const range_t & r,size_t i){	return r.second<=i;	});
+	size_t pos = first;
+	for(;it!=ranges.end() && it->first<end;++it){
+		if(it->first>pos)
+			gaps.emplace_back(pos,it->first);
+		pos = std::max(pos,it->second);
+	}
+	if(pos<end)
+		gaps.emplace_back(pos,end);
+	remove(first,end);
+	for(const auto & gap : gaps)
+		add(gap.first,gap.second);
+}
+
+void IndexRangeSet::insertIndices(size_t index,size_t count){
+	if(count==0)
+		return;
+	// first range ending behind the index
+	auto it = std::upper_bound(ranges.begin(),ranges.end(),index,
+								[](size_t i,const range_t & r){	return i<r.second;	});
+	if(it!=ranges.end() && it->first<index){ // split the range containing the index
+		const range_t tail(index,it->second);
+		it->second = index;
+		it = ranges.insert(it+1,tail);
+	}
+	for(;it!=ranges.end();++it){
+		it->first += count;
+		it->second += count;
+	}
+}
+
+void IndexRangeSet::eraseIndices(size_t first,size_t end){
+	if(first>=end)
+		return;
+	remove(first,end);
+	const size_t count = end-first;
+	auto it = std::lower_bound(ranges.begin(),ranges.end(),end,
+								[](const range_t & r,size_t i){	return r.first<i;	});
+	const size_t pos = static_cast<size_t>(it-ranges.begin());
+	for(;it!=ranges.end();++it){
+		it->first -= count;
+		it->second -= count;
+	}
+	// the ranges before and behind the removed indices may touch now
+	if(pos>0 && pos<ranges.size() && ranges[pos-1].second==ranges[pos].first){
+		ranges[pos-1].second = ranges[pos].second;
+		ranges.erase(ranges.begin()+pos);
+	}
+}
+
+std::vector<size_t> IndexRangeSet::toVector()const{
+	std::vector<size_t> indices;
+	indices.reserve(indexCount);
+	for(const auto & r : ranges){
+		for(size_t i=r.first;i<r.second;++i)
+			indices.push_back(i);
+	}
+	return indices;
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_INDEX_RANGE_SET_H
+#define GUI_INDEX_RANGE_SET_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace GUI{
+
+/*! Set of indices stored as sorted, disjoint and non-adjacent ranges (e.g. the marked entries of a ListView).
+	Large contiguous selections need constant memory; membership tests are O(log r) for r ranges.	*/
+class IndexRangeSet{
+	public:
+		typedef std::pair<size_t,size_t> range_t; //!< [first, end)
+
+		IndexRangeSet() : indexCount(0) {}
+
+		bool empty()const									{	return ranges.empty();	}
+		//! Number of contained indices.
+		size_t size()const									{	return indexCount;	}
+		const std::vector<range_t> & getRanges()const		{	return ranges;	}
+		//! The greatest contained index; the set must not be empty.
+		size_t back()const									{	return ranges.back().second-1;	}
+
+		GUIAPI bool contains(size_t index)const;
+
+		//! Add the indices [@p first, @p end).
+		GUIAPI void add(size_t first,size_t end);
+		//! Remove the indices [@p first, @p end).
+		GUIAPI void remove(size_t first,size_t end);
+		//! Add the missing and remove the contained indices of [@p first, @p end).
+		GUIAPI void toggle(size_t first,size_t end);
+		void clear()										{	ranges.clear();	indexCount = 0;	}
+
+		//! Make room for @p count new (not contained) indices at @p index; the following indices are shifted.
+		GUIAPI void insertIndices(size_t index,size_t count);
+		//! Remove the indices [@p first, @p end) and shift the following indices by end-first.
+		GUIAPI void eraseIndices(size_t first,size_t end);
+
+		//! All contained indices in ascending order.
+		GUIAPI std::vector<size_t> toVector()const;
+
+		bool operator==(const IndexRangeSet & other)const	{	return ranges==other.ranges;	}
+		bool operator!=(const IndexRangeSet & other)const	{	return ranges!=other.ranges;	}
+
+	private:
+		std::vector<range_t> ranges;
+		size_t indexCount;
+};
+
+}
+#endif // GUI_INDEX_RANGE_SET_H
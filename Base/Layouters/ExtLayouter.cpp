@@ -15,10 +15,11 @@
 namespace GUI{
 
 static Geometry::Vec2 getChildrensSize(Component * c){
-	Container * container = dynamic_cast<Container*>(c);
+	Container * container = castTo<Container>(c);
 	float x = 0.0f, y = 0.0f;
 	if(container){
-		for(Component * child=container->getFirstChild();child!=nullptr;child=child->getNext()){
+		for(const auto & childRef : container->getChildren()){
+			Component * child = childRef.get();
 			x = std::max( x, child->getWidth()+child->getPosition().x() );
 			y = std::max( y, child->getHeight()+child->getPosition().y() );
 		}
@@ -9,9 +9,8 @@
 #ifndef GUI_LISTENER_H
 #define GUI_LISTENER_H
 
-#include <Util/Registry.h>
+#include "ListenerRegistry.h"
 #include <functional>
-#include <list>
 
 namespace Geometry {
 template<typename T_> class _Vec2;
@@ -114,21 +113,21 @@ typedef std::function<bool (Component *,
 
 
 //! Registry for functions reacting on actions.
-typedef Util::Registry<std::list<HandleActionFun>> ActionListenerRegistry;
+typedef ListenerRegistry<HandleActionFun> ActionListenerRegistry;
 //! Registry for functions reacting on the destruction of a component.
-typedef Util::Registry<std::list<HandleComponentDestructionFun>> ComponentDestructionListenerRegistry;
+typedef ListenerRegistry<HandleComponentDestructionFun> ComponentDestructionListenerRegistry;
 //! Registry for functions reacting on a change of a component's data.
-typedef Util::Registry<std::list<HandleDataChangeFun>> DataChangeListenerRegistry;
+typedef ListenerRegistry<HandleDataChangeFun> DataChangeListenerRegistry;
 //! Registry for functions reacting on the end of a frame.
-typedef Util::Registry<std::list<FrameListenerFun>> FrameListenerRegistry;
+typedef ListenerRegistry<FrameListenerFun> FrameListenerRegistry;
 //! Registry for functions reacting on global key events.
-typedef Util::Registry<std::list<HandleKeyFun>> KeyListenerRegistry;
+typedef ListenerRegistry<HandleKeyFun> KeyListenerRegistry;
 //! Registry for functions reacting on a mouse button event.
-typedef Util::Registry<std::list<HandleMouseButtonFun>> MouseButtonListenerRegistry;
+typedef ListenerRegistry<HandleMouseButtonFun> MouseButtonListenerRegistry;
 //! Registry for functions reacting on a mouse click.
-typedef Util::Registry<std::list<HandleMouseClickFun>> MouseClickListenerRegistry;
+typedef ListenerRegistry<HandleMouseClickFun> MouseClickListenerRegistry;
 //! Registry for functions reacting on a mouse motion event.
-typedef Util::Registry<std::list<HandleMouseMotionFun>> MouseMotionListenerRegistry;
+typedef ListenerRegistry<HandleMouseMotionFun> MouseMotionListenerRegistry;
 
 
 
@@ -0,0 +1,116 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_LISTENER_REGISTRY_H
+#define GUI_LISTENER_REGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace GUI {
+
+/**
+ * Registry for listener functions using copy-on-write.
+ * The registered functions are stored in an immutable, shared list (snapshot)
+ * that is only rebuilt when a function is registered or unregistered.
+ * Dispatching takes a reference to the current snapshot and iterates over it;
+ * this does not allocate any memory. Functions that are registered or
+ * unregistered during a dispatch do not affect the running dispatch, which
+ * matches the former behavior of iterating over a copy of the elements.
+ *
+ * @code
+ * const auto listeners = registry.getSnapshot(); // keeps the snapshot alive
+ * for(const auto & fun : *listeners) { fun(...); }
+ * @endcode
+ */
+template<typename function_t>
+class ListenerRegistry {
+	public:
+		typedef function_t element_t;
+		typedef std::vector<function_t> elements_t;
+		//! Immutable, shared list of the registered functions.
+		typedef std::shared_ptr<const elements_t> snapshot_t;
+		//! Handle identifying a registered function; @c 0 is never used.
+		typedef uint32_t handle_t;
+
+		ListenerRegistry() : snapshot(getEmptySnapshot()), nextHandle(0) {
+		}
+
+		//! Register a function and return the handle needed to unregister it.
+		handle_t registerElement(function_t fun) {
+			return registerElement(std::move(fun), ++nextHandle);
+		}
+
+		/**
+		 * Register a function using a handle chosen by the caller (e.g. taken
+		 * from a counter shared by several registries). The handle must not be
+		 * in use by this registry and must not be @c 0.
+		 */
+		handle_t registerElement(function_t fun, handle_t handle) {
+			auto elements = std::make_shared<elements_t>();
+			elements->reserve(snapshot->size() + 1);
+			elements->insert(elements->end(), snapshot->begin(), snapshot->end());
+			elements->push_back(std::move(fun));
+			snapshot = std::move(elements);
+			handles.push_back(handle);
+			return handle;
+		}
+
+		//! Unregister the function identified by @p handle. Unknown handles are ignored.
+		void unregisterElement(handle_t && handle) {
+			size_t index = 0;
+			while(index < handles.size() && handles[index] != handle) {
+				++index;
+			}
+			if(index == handles.size()) {
+				return;
+			}
+			handles.erase(handles.begin() + index);
+			if(handles.empty()) {
+				snapshot = getEmptySnapshot();
+				return;
+			}
+			auto elements = std::make_shared<elements_t>();
+			elements->reserve(snapshot->size() - 1);
+			elements->insert(elements->end(), snapshot->begin(), snapshot->begin() + index);
+			elements->insert(elements->end(), snapshot->begin() + index + 1, snapshot->end());
+			snapshot = std::move(elements);
+		}
+
+		//! Return the current snapshot. Keep a copy of the pointer while iterating.
+		const snapshot_t & getSnapshot() const {
+			return snapshot;
+		}
+		const elements_t & getElements() const {
+			return *snapshot;
+		}
+		bool empty() const {
+			return handles.empty();
+		}
+		size_t size() const {
+			return handles.size();
+		}
+
+	private:
+		//! Shared snapshot of all empty registries of this type.
+		static const snapshot_t & getEmptySnapshot() {
+			static const snapshot_t emptySnapshot = std::make_shared<elements_t>();
+			return emptySnapshot;
+		}
+
+		snapshot_t snapshot;
+		//! Handles of the registered functions; same order as the snapshot.
+		std::vector<handle_t> handles;
+		handle_t nextHandle;
+};
+
+}
+
+#endif // GUI_LISTENER_REGISTRY_H
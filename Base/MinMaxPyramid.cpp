@@ -0,0 +1,77 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "MinMaxPyramid.h"
+#include <algorithm>
+#include <limits>
+
+namespace GUI{
+
+void MinMaxPyramid::append(float value){
+	size_t block = values.size();
+	values.push_back(value);
+	for(auto & level : levels){
+		block /= FACTOR;
+		if(block==level.mins.size()){ // first value of a new block
+			level.mins.push_back(value);
+			level.maxs.push_back(value);
+		}else{
+			level.mins.back() = std::min(level.mins.back(),value);
+			level.maxs.back() = std::max(level.maxs.back(),value);
+		}
+	}
+	// the top level always consists of a single block
+	while((levels.empty() ? values.size() : levels.back().mins.size())>1){
+		Level level;
+		const std::vector<float> & lowerMins = levels.empty() ? values : levels.back().mins;
+		const std::vector<float> & lowerMaxs = levels.empty() ? values : levels.back().maxs;
+		for(size_t i=0;i<lowerMins.size();i+=FACTOR){
+			const size_t end = std::min(i+FACTOR,lowerMins.size());
+			level.mins.push_back(*std::min_element(lowerMins.begin()+i,lowerMins.begin()+end));
+			level.maxs.push_back(*std::max_element(lowerMaxs.begin()+i,lowerMaxs.begin()+end));
+		}
+		levels.push_back(std::move(level));
+	}
+}
+
+void MinMaxPyramid::append(const float * newValues,size_t count){
+	values.reserve(values.size()+count);
+	for(size_t i=0;i<count;++i)
+		append(newValues[i]);
+}
+
+bool MinMaxPyramid::getRange(size_t first,size_t end,float & min,float & max)const{
+	end = std::min(end,values.size());
+	if(first>=end)
+		return false;
+	min = std::numeric_limits<float>::max();
+	max = std::numeric_limits<float>::lowest();
+	while(first<end){
+		// the largest block beginning at first that lies inside the range
+		size_t levelCount = 0;
+		size_t blockSize = 1;
+		while(levelCount<levels.size() && first%(blockSize*FACTOR)==0 && first+blockSize*FACTOR<=end){
+			blockSize *= FACTOR;
+			++levelCount;
+		}
+		if(levelCount==0){
+			min = std::min(min,values[first]);
+			max = std::max(max,values[first]);
+		}else{
+			const Level & level = levels[levelCount-1];
+			min = std::min(min,level.mins[first/blockSize]);
+			max = std::max(max,level.maxs[first/blockSize]);
+		}
+		first += blockSize;
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_MIN_MAX_PYRAMID_H
+#define GUI_MIN_MAX_PYRAMID_H
+
+#include <cstddef>
+#include <vector>
+
+namespace GUI{
+
+/*! Append-only sequence of values with a multi-resolution envelope: level l stores the minimum and
+	maximum of each block of FACTOR^(l+1) values (the last block of a level may be incomplete).
+	Appending a value is O(log n); the extremes of any range of values are found in O(FACTOR*log n)
+	by combining the largest aligned blocks (e.g. for drawing a series of many samples per pixel).
+	The levels need about 2/(FACTOR-1) times the memory of the values.	*/
+class MinMaxPyramid{
+	public:
+		static const size_t FACTOR = 8;
+
+		size_t size()const									{	return values.size();	}
+		bool empty()const									{	return values.empty();	}
+		float get(size_t index)const						{	return values[index];	}
+		size_t getLevelCount()const							{	return levels.size();	}
+
+		GUIAPI void append(float value);
+		GUIAPI void append(const float * newValues,size_t count);
+		void clear()										{	values.clear();	levels.clear();	}
+
+		/*! Determine the minimum and maximum of the values [@p first, @p end) (@p end is clamped to size());
+			returns false if the range is empty.	*/
+		GUIAPI bool getRange(size_t first,size_t end,float & min,float & max)const;
+
+	private:
+		struct Level{
+			std::vector<float> mins;
+			std::vector<float> maxs;
+		};
+		std::vector<float> values;
+		std::vector<Level> levels;
+};
+
+}
+#endif // GUI_MIN_MAX_PYRAMID_H
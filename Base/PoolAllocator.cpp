@@ -0,0 +1,108 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "PoolAllocator.h"
+#include <new>
+
+namespace GUI{
+
+//! (static)
+PoolAllocator & PoolAllocator::getDefault(){
+	// intentionally never deleted: components may be destroyed during static destruction.
+	static PoolAllocator * allocator = new PoolAllocator;
+	return *allocator;
+}
+
+//! (ctor)
+PoolAllocator::PoolAllocator() : freeLists(getSizeClass(MAX_POOLED_SIZE)+1,nullptr) {
+	stats.liveObjectsPerSizeClass.resize(freeLists.size(),0);
+}
+
+//! (dtor)
+PoolAllocator::~PoolAllocator(){
+	for(void * chunk : chunks)
+		::operator delete(chunk);
+}
+
+void * PoolAllocator::allocate(size_t size){
+	std::lock_guard<std::mutex> lock(mutex);
+	return doAllocate(size);
+}
+
+void PoolAllocator::deallocate(void * p,size_t size){
+	std::lock_guard<std::mutex> lock(mutex);
+	doDeallocate(p,size);
+}
+
+PoolAllocator::Statistics PoolAllocator::getStatistics()const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+//! (internal)
+void * PoolAllocator::doAllocate(size_t size){
+	++stats.allocationCount;
+	if(size==0)
+		size = 1;
+	if(size>MAX_POOLED_SIZE){
+		++stats.oversizedCount;
+		return ::operator new(size);
+	}
+	const size_t sizeClass = getSizeClass(size);
+	if(freeLists[sizeClass]==nullptr)
+		refill(sizeClass);
+	FreeNode * node = freeLists[sizeClass];
+	freeLists[sizeClass] = node->next;
+
+	++stats.liveObjectsPerSizeClass[sizeClass];
+	stats.usedBytes += (sizeClass+1)*GRANULARITY;
+	return node;
+}
+
+//! (internal)
+void PoolAllocator::doDeallocate(void * p,size_t size){
+	if(p==nullptr)
+		return;
+	++stats.deallocationCount;
+	if(size==0)
+		size = 1;
+	if(size>MAX_POOLED_SIZE){
+		::operator delete(p);
+		return;
+	}
+	const size_t sizeClass = getSizeClass(size);
+	FreeNode * node = static_cast<FreeNode*>(p);
+	node->next = freeLists[sizeClass];
+	freeLists[sizeClass] = node;
+
+	--stats.liveObjectsPerSizeClass[sizeClass];
+	stats.usedBytes -= (sizeClass+1)*GRANULARITY;
+}
+
+//! (internal)
+void PoolAllocator::refill(size_t sizeClass){
+	const size_t slotSize = (sizeClass+1)*GRANULARITY;
+	const size_t slotCount = CHUNK_SIZE/slotSize;
+	uint8_t * chunk = static_cast<uint8_t*>(::operator new(slotCount*slotSize));
+	chunks.push_back(chunk);
+	++stats.chunkCount;
+	stats.reservedBytes += slotCount*slotSize;
+
+	// link the slots in ascending order so that consecutive allocations are adjacent in memory.
+	FreeNode * next = freeLists[sizeClass];
+	for(size_t i=slotCount;i>0;--i){
+		FreeNode * node = reinterpret_cast<FreeNode*>(chunk+(i-1)*slotSize);
+		node->next = next;
+		next = node;
+	}
+	freeLists[sizeClass] = next;
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_POOL_ALLOCATOR_H
+#define GUI_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace GUI{
+
+/*! Size-class pool allocator for Components, DisplayProperties and their internal arrays.
+	Memory is taken from large chunks and recycled via per size class free lists, which
+	makes creating and destroying many small objects much cheaper than using malloc/free and
+	keeps objects of similar size close together.
+	Requests larger than MAX_POOLED_SIZE are forwarded to the global operator new.
+	\note The allocator is shared by all GUI_Managers and objects may be released by any thread (e.g. inside
+		a posted task or by the parallel layout), so every call takes the allocator's lock.
+	\note The memory of the chunks is kept for later allocations and is not returned to the system. */
+class PoolAllocator{
+	public:
+		static const size_t GRANULARITY = 16;
+		static const size_t MAX_POOLED_SIZE = 512;
+		static const size_t CHUNK_SIZE = 64*1024;
+
+		struct Statistics{
+			size_t allocationCount;		//!< number of allocations (including oversized ones)
+			size_t deallocationCount;	//!< number of deallocations (including oversized ones)
+			size_t oversizedCount;		//!< number of allocations forwarded to the global operator new
+			size_t usedBytes;			//!< bytes currently used by living objects (rounded up to the size classes)
+			size_t reservedBytes;		//!< bytes currently reserved in chunks
+			size_t chunkCount;
+			std::vector<size_t> liveObjectsPerSizeClass; //!< index i -> objects of size (i+1)*GRANULARITY
+			Statistics() : allocationCount(0),deallocationCount(0),oversizedCount(0),usedBytes(0),reservedBytes(0),chunkCount(0) {}
+		};
+
+		//! The allocator used by all GUI objects. It is never destroyed, so objects may safely be released at exit.
+		GUIAPI static PoolAllocator & getDefault();
+
+		GUIAPI PoolAllocator();
+		GUIAPI ~PoolAllocator();
+
+		GUIAPI void * allocate(size_t size);
+		//! @p size has to be the same size used for the allocation.
+		GUIAPI void deallocate(void * p,size_t size);
+
+		//! A copy of the current statistics.
+		GUIAPI Statistics getStatistics()const;
+	private:
+		PoolAllocator(const PoolAllocator &) = delete;
+		PoolAllocator & operator=(const PoolAllocator &) = delete;
+
+		struct FreeNode{	FreeNode * next;	};
+		static size_t getSizeClass(size_t size)		{	return (size+GRANULARITY-1)/GRANULARITY - 1;	}
+
+		//! (internal) Allocate a new chunk and put its slots into the free list of the given size class.
+		void refill(size_t sizeClass);
+		void * doAllocate(size_t size);
+		void doDeallocate(void * p,size_t size);
+
+		std::vector<FreeNode*> freeLists; // size class -> first free slot
+		std::vector<void*> chunks;
+		Statistics stats;
+		mutable std::mutex mutex;
+};
+
+/*! Standard conforming allocator using the default PoolAllocator; used for the small internal
+	arrays of components (children, properties, layouters).	*/
+template<typename T>
+class PoolAllocatorAdapter{
+	public:
+		typedef T value_type;
+
+		PoolAllocatorAdapter() {}
+		template<typename U>
+		PoolAllocatorAdapter(const PoolAllocatorAdapter<U> &) {}
+
+		T * allocate(size_t n)						{	return static_cast<T*>(PoolAllocator::getDefault().allocate(n*sizeof(T)));	}
+		void deallocate(T * p,size_t n)				{	PoolAllocator::getDefault().deallocate(p,n*sizeof(T));	}
+
+		template<typename U>
+		struct rebind{	typedef PoolAllocatorAdapter<U> other;	};
+
+		template<typename U>
+		bool operator==(const PoolAllocatorAdapter<U> &)const	{	return true;	}
+		template<typename U>
+		bool operator!=(const PoolAllocatorAdapter<U> &)const	{	return false;	}
+};
+
+}
+#endif // GUI_POOL_ALLOCATOR_H
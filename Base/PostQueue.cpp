@@ -0,0 +1,99 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "PostQueue.h"
+
+namespace GUI{
+
+//! (ctor)
+PostQueue::PostQueue() : head(&stub),tail(&stub),pendingCount(0),postedCount(0),
+		executedCount(0),budgetExceededCount(0),maxPendingCount(0),lastExecutionDuration(0) {
+}
+
+//! (dtor)
+PostQueue::~PostQueue(){
+	task_t task;
+	while(pop(task))
+		task = nullptr;
+	if(tail!=&stub)
+		delete tail;
+}
+
+void PostQueue::post(task_t task){
+	Node * node = new Node(std::move(task));
+	postedCount.fetch_add(1,std::memory_order_relaxed);
+	const size_t prevPendingCount = pendingCount.fetch_add(1,std::memory_order_relaxed);
+	Node * prev = head.exchange(node,std::memory_order_acq_rel);
+	// the node becomes visible to the consumer as soon as it is linked
+	prev->next.store(node,std::memory_order_release);
+	if(prevPendingCount==0 && notifier)
+		notifier();
+}
+
+//! (internal)
+bool PostQueue::pop(task_t & task){
+	Node * next = tail->next.load(std::memory_order_acquire);
+	if(next==nullptr) // empty (or a producer has not yet linked its node)
+		return false;
+	// 'next' becomes the new dummy node; its task is moved out.
+	task = std::move(next->task);
+	next->task = nullptr;
+	if(tail!=&stub)
+		delete tail;
+	tail = next;
+	pendingCount.fetch_sub(1,std::memory_order_relaxed);
+	return true;
+}
+
+size_t PostQueue::execute(double timeBudget,const std::function<double ()> & clock){
+	const size_t pending = getPendingCount();
+	if(pending>maxPendingCount)
+		maxPendingCount = pending;
+	if(pending==0){
+		lastExecutionDuration = 0;
+		return 0;
+	}
+	const double start = clock();
+	size_t count = 0;
+	task_t task;
+	while(pop(task)){
+		task();
+		task = nullptr;
+		++count;
+		if(clock()-start>=timeBudget){
+			if(getPendingCount()>0)
+				++budgetExceededCount;
+			break;
+		}
+	}
+	executedCount += count;
+	lastExecutionDuration = clock()-start;
+	return count;
+}
+
+PostQueue::Statistics PostQueue::getStatistics()const{
+	Statistics s;
+	s.postedCount = postedCount.load(std::memory_order_relaxed);
+	s.executedCount = executedCount;
+	s.budgetExceededCount = budgetExceededCount;
+	s.pendingCount = getPendingCount();
+	s.maxPendingCount = maxPendingCount;
+	s.lastExecutionDuration = lastExecutionDuration;
+	return s;
+}
+
+void PostQueue::resetStatistics(){
+	executedCount = 0;
+	budgetExceededCount = 0;
+	maxPendingCount = getPendingCount();
+	lastExecutionDuration = 0;
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_POST_QUEUE_H
+#define GUI_POST_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace GUI{
+
+/*! Lock-free multi-producer single-consumer queue of tasks.
+	Any thread may post() tasks without ever blocking; the tasks are executed in the order of
+	their posting by the thread owning the GUI via execute() (called in GUI_Manager::display()).
+	The queue is an intrusive linked list (Vyukov's MPSC queue): posting is a single atomic exchange,
+	the consumer needs no atomic read-modify-write operations at all.	*/
+class PostQueue{
+	public:
+		typedef std::function<void ()> task_t;
+		//! Called by the posting thread when a task is posted into an empty queue (e.g. to wake up the main loop).
+		typedef std::function<void ()> notifier_t;
+
+		struct Statistics{
+			uint64_t postedCount;			//!< number of posted tasks
+			uint64_t executedCount;			//!< number of executed tasks
+			uint64_t budgetExceededCount;	//!< number of calls of execute() stopped by the time budget
+			size_t pendingCount;			//!< number of tasks currently waiting (approximated while tasks are posted)
+			size_t maxPendingCount;			//!< highest number of waiting tasks seen by execute()
+			double lastExecutionDuration;	//!< duration of the last call of execute() in seconds
+			Statistics() : postedCount(0),executedCount(0),budgetExceededCount(0),pendingCount(0),maxPendingCount(0),lastExecutionDuration(0) {}
+		};
+
+		GUIAPI PostQueue();
+		//! Remaining tasks are deleted without being executed.
+		GUIAPI ~PostQueue();
+
+		//! (thread safe) Add a task.
+		GUIAPI void post(task_t task);
+		//! (thread safe)
+		size_t getPendingCount()const						{	return pendingCount.load(std::memory_order_relaxed);	}
+
+		/*! Set the notifier; has to be called before tasks are posted from other threads.
+			\note The notifier is called by the posting threads.	*/
+		void setNotifier(notifier_t n)						{	notifier = std::move(n);	}
+
+		/*! (consumer thread only) Execute the waiting tasks in the order of their posting.
+			If the execution takes longer than @p timeBudget seconds (measured with @p clock), the remaining
+			tasks are kept for the next call; at least one task is executed per call.
+			Returns the number of executed tasks.	*/
+		GUIAPI size_t execute(double timeBudget,const std::function<double ()> & clock);
+
+		//! (consumer thread only)
+		GUIAPI Statistics getStatistics()const;
+		//! (consumer thread only) Reset the counters of the consumer side.
+		GUIAPI void resetStatistics();
+
+	private:
+		PostQueue(const PostQueue &) = delete;
+		PostQueue & operator=(const PostQueue &) = delete;
+
+		struct Node{
+			std::atomic<Node*> next;
+			task_t task;
+			Node() : next(nullptr) {}
+			explicit Node(task_t t) : next(nullptr),task(std::move(t)) {}
+		};
+		//! (consumer thread only) Move the next task into @p task; returns false if the queue is empty.
+		bool pop(task_t & task);
+
+		Node stub;
+		std::atomic<Node*> head;		//!< last posted node (producers)
+		Node * tail;					//!< node before the next task (consumer)
+		std::atomic<size_t> pendingCount;
+		std::atomic<uint64_t> postedCount;
+		notifier_t notifier;
+
+		uint64_t executedCount;
+		uint64_t budgetExceededCount;
+		size_t maxPendingCount;
+		double lastExecutionDuration;
+};
+
+}
+#endif // GUI_POST_QUEUE_H
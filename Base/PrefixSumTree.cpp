@@ -0,0 +1,88 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "PrefixSumTree.h"
+#include <algorithm>
+
+namespace GUI{
+
+static inline size_t lowBit(size_t i)	{	return i & (~i+1);	}
+
+void PrefixSumTree::set(size_t index,double value){
+	const double delta = value-values[index];
+	values[index] = value;
+	for(size_t i=index+1;i<=tree.size();i+=lowBit(i))
+		tree[i-1] += delta;
+}
+
+double PrefixSumTree::getPrefixSum(size_t count)const{
+	double sum = 0;
+	for(size_t i=std::min(count,tree.size());i>0;i-=lowBit(i))
+		sum += tree[i-1];
+	return sum;
+}
+
+size_t PrefixSumTree::findIndex(double sum)const{
+	if(sum<0)
+		return 0;
+	size_t step = 1;
+	while(step*2<=tree.size())
+		step *= 2;
+	size_t pos = 0;
+	for(;step>0;step/=2){
+		if(pos+step<=tree.size() && tree[pos+step-1]<=sum){
+			pos += step;
+			sum -= tree[pos-1];
+		}
+	}
+	return pos;
+}
+
+void PrefixSumTree::pushBack(double value){
+	values.push_back(value);
+	const size_t i = values.size();
+	// the new node covers the values (i-lowbit(i), i]
+	tree.push_back(value + getPrefixSum(i-1) - getPrefixSum(i-lowBit(i)));
+}
+
+void PrefixSumTree::assign(size_t count,double value){
+	values.assign(count,value);
+	rebuild();
+}
+
+void PrefixSumTree::insert(size_t index,size_t count,double value){
+	index = std::min(index,values.size());
+	if(index==values.size() && count==1){
+		pushBack(value);
+		return;
+	}
+	values.insert(values.begin()+index,count,value);
+	rebuild();
+}
+
+void PrefixSumTree::erase(size_t first,size_t end){
+	end = std::min(end,values.size());
+	if(first>=end)
+		return;
+	values.erase(values.begin()+first,values.begin()+end);
+	rebuild();
+}
+
+//! (internal) O(n) construction of the tree.
+void PrefixSumTree::rebuild(){
+	tree = values;
+	for(size_t i=1;i<=tree.size();++i){
+		const size_t parent = i+lowBit(i);
+		if(parent<=tree.size())
+			tree[parent-1] += tree[i-1];
+	}
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_PREFIX_SUM_TREE_H
+#define GUI_PREFIX_SUM_TREE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace GUI{
+
+/*! Sequence of non-negative values with O(log n) prefix sums (Fenwick tree); e.g. the heights of
+	the rows of a list: the offset of a row is the prefix sum of the preceding rows' heights.
+	Changing a value or appending one is O(log n); inserting or erasing in the middle is O(n).	*/
+class PrefixSumTree{
+	public:
+		size_t size()const									{	return values.size();	}
+		bool empty()const									{	return values.empty();	}
+		double get(size_t index)const						{	return values[index];	}
+		GUIAPI void set(size_t index,double value);
+
+		//! Sum of the first @p count values.
+		GUIAPI double getPrefixSum(size_t count)const;
+		double getTotal()const								{	return getPrefixSum(values.size());	}
+		/*! Return the index i with getPrefixSum(i) <= @p sum < getPrefixSum(i+1)
+			(0 for negative sums; size() if @p sum is not less than the total).	*/
+		GUIAPI size_t findIndex(double sum)const;
+
+		GUIAPI void pushBack(double value);
+		GUIAPI void assign(size_t count,double value);
+		//! Insert @p count copies of @p value before @p index.
+		GUIAPI void insert(size_t index,size_t count,double value);
+		//! Erase the values [@p first, @p end).
+		GUIAPI void erase(size_t first,size_t end);
+		void clear()										{	values.clear();	tree.clear();	}
+
+	private:
+		void rebuild();
+
+		std::vector<double> values;
+		std::vector<double> tree; // tree[i-1] is the sum of the values (i-lowbit(i), i] (1-based)
+};
+
+}
+#endif // GUI_PREFIX_SUM_TREE_H
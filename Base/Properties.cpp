@@ -13,6 +13,9 @@
 
 namespace GUI{
 
+// ---
+// ColorProperty
+
 //! ---|> DisplayProperty
 void ColorProperty::doEnable(StyleManager & s){
 	s.pushColor(getPropertyId(),getColor());
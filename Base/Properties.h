@@ -30,7 +30,7 @@ class ColorProperty : public DisplayProperty {
 		virtual ~ColorProperty() {}
 
 		const Util::Color4ub & getColor()const		{	return color;	}
-		void setColor(const Util::Color4ub& c)		{	color=c;	}
+		void setColor(const Util::Color4ub& c)		{	color=c;	markModified();	}
 
 		//! ---|> DisplayProperty
 		GUIAPI virtual void doEnable(StyleManager & s) override;
@@ -47,7 +47,7 @@ class FontProperty : public DisplayProperty {
 		virtual ~FontProperty() {}
 
 		AbstractFont * getFont()const				{	return font.get();	}
-		void setFont(AbstractFont * f)				{	font=f;	}
+		void setFont(AbstractFont * f)				{	font=f;	markModified();	}
 
 		//! ---|> DisplayProperty
 		GUIAPI virtual void doEnable(StyleManager & s) override;
@@ -109,7 +109,7 @@ class ShapeProperty : public DisplayProperty {
 		virtual ~ShapeProperty() {}
 
 		AbstractShape * getShape()const				{	return shape.get();	}
-		void setShape(AbstractShape * s)			{	shape=s;	}
+		void setShape(AbstractShape * s)			{	shape=s;	markModified();	}
 
 		//! ---|> DisplayProperty
 		GUIAPI virtual void doEnable(StyleManager & s) override;
@@ -0,0 +1,94 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "RenderThread.h"
+#include "Draw.h"
+#include "DrawList.h"
+
+namespace GUI{
+
+//! (ctor)
+RenderThread::RenderThread(submitter_t _submitter, callback_t _onStart, callback_t _onStop) :
+		submitter(std::move(_submitter)),onStart(std::move(_onStart)),onStop(std::move(_onStop)),
+		submitting(false),shutdown(false),thread(&RenderThread::threadMain,this) {
+}
+
+//! (dtor)
+RenderThread::~RenderThread(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		shutdown = true;
+	}
+	frameAvailable.notify_all();
+	thread.join();
+}
+
+//! (internal)
+void RenderThread::threadMain(){
+	if(onStart)
+		onStart();
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true){
+		frameAvailable.wait(lock,[this](){	return shutdown || waitingFrame;	});
+		if(!waitingFrame) // shutdown
+			break;
+		std::shared_ptr<const DrawList> frame;
+		std::swap(frame,waitingFrame);
+		std::vector<std::shared_ptr<const DrawList>> dropped;
+		std::swap(dropped,droppedUploads);
+		submitting = true;
+		frameTaken.notify_all();
+		lock.unlock();
+		// the changed texture data of dropped frames is not contained in the following frames
+		for(const auto & droppedFrame : dropped)
+			Draw::uploadTextures(*droppedFrame);
+		dropped.clear();
+		submitter(*frame);
+		frame.reset();
+		lock.lock();
+		submitting = false;
+		++statistics.submittedCount;
+		frameTaken.notify_all();
+	}
+	lock.unlock();
+	if(onStop)
+		onStop();
+}
+
+void RenderThread::publish(std::shared_ptr<const DrawList> frame, bool dropIfBusy){
+	if(!frame)
+		return;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if(waitingFrame){
+			if(dropIfBusy){
+				++statistics.droppedCount;
+				if(!waitingFrame->getTextureUploads().empty())
+					droppedUploads.emplace_back(std::move(waitingFrame));
+			}else{
+				frameTaken.wait(lock,[this](){	return !waitingFrame;	});
+			}
+		}
+		waitingFrame = std::move(frame);
+	}
+	frameAvailable.notify_one();
+}
+
+void RenderThread::waitIdle(){
+	std::unique_lock<std::mutex> lock(mutex);
+	frameTaken.wait(lock,[this](){	return !waitingFrame && !submitting;	});
+}
+
+RenderThread::Statistics RenderThread::getStatistics()const{
+	std::lock_guard<std::mutex> lock(mutex);
+	return statistics;
+}
+
+}
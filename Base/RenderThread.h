@@ -0,0 +1,80 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_RENDER_THREAD_H
+#define GUI_RENDER_THREAD_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GUI{
+
+class DrawList;
+
+/*! Thread submitting recorded frames (see Draw::beginRecording() and GUI_Manager::recordFrame()).
+	Frames are double buffered: while the thread submits one frame, the next one can be recorded and
+	published; a third frame has to wait until the thread takes the waiting one (or replaces it).
+	All callbacks are called on the render thread, which should own the graphics context.	*/
+class RenderThread{
+	public:
+		//! Draw a frame, e.g. by calling Draw::submit() and swapping the buffers.
+		typedef std::function<void (const DrawList &)> submitter_t;
+		//! Called once on the render thread before the first and after the last frame (e.g. to bind the graphics context).
+		typedef std::function<void ()> callback_t;
+
+		struct Statistics{
+			uint64_t submittedCount;	//!< number of submitted frames
+			uint64_t droppedCount;		//!< number of published frames that were replaced before their submission
+			Statistics() : submittedCount(0),droppedCount(0) {}
+		};
+
+		GUIAPI explicit RenderThread(submitter_t submitter, callback_t onStart=nullptr, callback_t onStop=nullptr);
+		//! A waiting frame is submitted before the thread is stopped.
+		GUIAPI ~RenderThread();
+
+		/*! Pass a recorded frame to the render thread. If a frame is still waiting for its submission, the call
+			blocks until it is taken by the thread; with @p dropIfBusy the waiting frame is replaced instead.
+			\note Dropping frames is not compatible with lazy rendering, which only records the changed regions.	*/
+		GUIAPI void publish(std::shared_ptr<const DrawList> frame, bool dropIfBusy=false);
+
+		//! Block until all published frames have been submitted.
+		GUIAPI void waitIdle();
+
+		GUIAPI Statistics getStatistics()const;
+
+	private:
+		RenderThread(const RenderThread &) = delete;
+		RenderThread & operator=(const RenderThread &) = delete;
+
+		void threadMain();
+
+		submitter_t submitter;
+		callback_t onStart, onStop;
+
+		mutable std::mutex mutex;
+		std::condition_variable frameAvailable;
+		std::condition_variable frameTaken;
+		std::shared_ptr<const DrawList> waitingFrame;	//!< published, but not yet taken by the thread
+		//! Dropped frames containing texture uploads; their uploads are done before the next submission.
+		std::vector<std::shared_ptr<const DrawList>> droppedUploads;
+		bool submitting;
+		bool shutdown;
+		Statistics statistics;
+
+		std::thread thread; // started last
+};
+
+}
+#endif // GUI_RENDER_THREAD_H
@@ -12,106 +12,98 @@
 #include "BasicColors.h"
 
 #include <Util/UI/Cursor.h>
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 
 namespace GUI{
 
+//! (ctor)
+StyleManager::StyleManager() : threadStackCount(0), defaultsVersion(0), derivedStylesVersion(0) {
+}
+
 StyleManager::~StyleManager() = default;
 
 //------------------------------------------------------
 // colors
 
 Util::Color4ub StyleManager::getColor(propertyId_t type)const{
-	if(type>=colorRegistry.size())
-		return Colors::NO_COLOR;
-	const colorStack_t & stack(colorRegistry[type]);
-	return stack.empty() ? Colors::NO_COLOR : stack.back();
+	const auto & activeStyle = getStack().activeStyle;
+	if(activeStyle.isNotNull()){
+		const Util::Color4ub * c = activeStyle->findColor(type);
+		if(c!=nullptr)
+			return *c;
+	}
+	return type<defaultColors.size() ? defaultColors[type] : Colors::NO_COLOR;
 }
 
 //! (internal)
 void StyleManager::initColors(size_t newSize){
-	const size_t oldSize = colorRegistry.size();
-	colorRegistry.resize(newSize);
-	for(size_t i=oldSize;i<newSize;++i)
-		colorRegistry[i].push_back(Colors::NO_COLOR);
+	defaultColors.resize(newSize,Colors::NO_COLOR);
 }
 
 void StyleManager::pushColor(propertyId_t type,const Util::Color4ub & c){
-	if(type>=colorRegistry.size())
-		initColors(type+1);
-	colorRegistry[type].push_back(c);
+	ResolvedStyle * const recordingStyle = getStack().recordingStyle;
+	if(recordingStyle!=nullptr)
+		recordingStyle->setColor(type,c);
+	else if(ResolvedStyle * style = pushDerivedStyle(0,type,c.getAsUInt()))
+		style->setColor(type,c);
 }
 
-void StyleManager::popColor(propertyId_t type){
-	if(type>=colorRegistry.size() || colorRegistry[type].size()<=1){
-		WARN("Empty property stack.");
-	}else{
-		colorRegistry[type].pop_back();
-	}
+void StyleManager::popColor(propertyId_t /*type*/){
+	popStyle();
 }
 
 void StyleManager::setDefaultColor(propertyId_t type,const Util::Color4ub & c){
-	if(type>=colorRegistry.size())
+	if(type>=defaultColors.size())
 		initColors(type+1);
-	colorRegistry[type][0]=c;
+	defaultColors[type]=c;
+	invalidateResolvedStyles();
 }
 
 //------------------------------------------------------
 // fonts
 
 AbstractFont * StyleManager::getDefaultFont(propertyId_t type)const{
-	if(type>=fontRegistry.size()){
-		WARN("No Font!");
-		return nullptr;
-	}
-	const fontStack_t & stack(fontRegistry[type]);
-	if(stack.empty()||stack.front().isNull()){
+	if(type>=defaultFonts.size() || defaultFonts[type].isNull()){
 		WARN("No Font!");
 		return nullptr;
 	}
-	return stack.front().get();
+	return defaultFonts[type].get();
 }
 
 AbstractFont * StyleManager::getFont(propertyId_t type)const{
-	if(type>=fontRegistry.size()){
+	AbstractFont * font = nullptr;
+	const auto & activeStyle = getStack().activeStyle;
+	if(activeStyle.isNull() || !activeStyle->findFont(type,font))
+		font = type<defaultFonts.size() ? defaultFonts[type].get() : nullptr;
+	if(font==nullptr)
 		WARN("No Font!");
-		return nullptr;
-	}
-	const fontStack_t & stack(fontRegistry[type]);
-	if(stack.empty()||stack.back().isNull()){
-		WARN("No Font!");
-		return nullptr;
-	}
-	return stack.back().get();
+	return font;
 }
 
 //! (internal)
 void StyleManager::initFonts(size_t newSize){
-	const size_t oldSize = fontRegistry.size();
-	fontRegistry.resize(newSize);
-	for(size_t i=oldSize;i<newSize;++i)
-		fontRegistry[i].push_back(nullptr);
+	defaultFonts.resize(newSize);
 }
 
 void StyleManager::pushFont(propertyId_t type,AbstractFont * f){
-	if(type>=fontRegistry.size())
-		initFonts(type+1);
-	fontRegistry[type].push_back(f);
+	ResolvedStyle * const recordingStyle = getStack().recordingStyle;
+	if(recordingStyle!=nullptr)
+		recordingStyle->setFont(type,f);
+	else if(ResolvedStyle * style = pushDerivedStyle(1,type,reinterpret_cast<uintptr_t>(f)))
+		style->setFont(type,f);
 }
 
-void StyleManager::popFont(propertyId_t type){
-	if(type>=fontRegistry.size() || fontRegistry[type].size()<=1){
-		WARN("Empty font stack.");
-	}else{
-		fontRegistry[type].pop_back();
-	}
+void StyleManager::popFont(propertyId_t /*type*/){
+	popStyle();
 }
 
 void StyleManager::setDefaultFont(propertyId_t type,AbstractFont * f){
-	if(type>=fontRegistry.size())
+	if(type>=defaultFonts.size())
 		initFonts(type+1);
-	fontRegistry[type][0]=f;
+	defaultFonts[type]=f;
+	invalidateResolvedStyles();
 }
 //------------------------------------------------------
 // mouse cursor
@@ -143,39 +135,195 @@ void StyleManager::removeMouseCursor(propertyName_t name) {
 
 //! (internal)
 void StyleManager::initShapes(size_t newSize){
-	const size_t oldSize = shapeRegistry.size();
-	shapeRegistry.resize(newSize);
-	for(size_t i=oldSize;i<newSize;++i)
-		shapeRegistry[i].push_back(NullShape::instance());
+	defaultShapes.resize(newSize,NullShape::instance());
 }
 
 AbstractShape * StyleManager::getShape(propertyId_t type)const{
-	if(type>=shapeRegistry.size())
-		return NullShape::instance();
-	const shapeStack_t & stack(shapeRegistry[type]);
-	return stack.empty() ? NullShape::instance() : stack.back().get();
+	AbstractShape * shape = nullptr;
+	const auto & activeStyle = getStack().activeStyle;
+	if(activeStyle.isNotNull() && activeStyle->findShape(type,shape))
+		return shape;
+	return type<defaultShapes.size() ? defaultShapes[type].get() : NullShape::instance();
 }
 
 void StyleManager::pushShape(propertyId_t type,AbstractShape * s){
-	if(type>=shapeRegistry.size())
+	ResolvedStyle * const recordingStyle = getStack().recordingStyle;
+	if(recordingStyle!=nullptr)
+		recordingStyle->setShape(type,s);
+	else if(ResolvedStyle * style = pushDerivedStyle(2,type,reinterpret_cast<uintptr_t>(s)))
+		style->setShape(type,s);
+}
+
+void StyleManager::popShape(propertyId_t /*type*/){
+	popStyle();
+}
+
+void StyleManager::setDefaultShape(propertyId_t type,AbstractShape * f){
+	if(type>=defaultShapes.size())
 		initShapes(type+1);
-	shapeRegistry[type].push_back(s);
+	defaultShapes[type]=f;
+	invalidateResolvedStyles();
+}
+//------------------------------------------------------
+// resolved styles
 
+void StyleManager::pushStyle(ResolvedStyle * style){
+	StyleStack & stack = getStack();
+	stack.previousStyles.emplace_back(std::move(stack.activeStyle));
+	stack.activeStyle = style;
 }
 
-void StyleManager::popShape(propertyId_t type){
-	if(type>=shapeRegistry.size() || shapeRegistry[type].size()<=1){
-		WARN("Empty shape stack.");
+void StyleManager::popStyle(){
+	StyleStack & stack = getStack();
+	if(stack.previousStyles.empty()){
+		WARN("Empty style stack.");
 	}else{
-		shapeRegistry[type].pop_back();
+		stack.activeStyle = std::move(stack.previousStyles.back());
+		stack.previousStyles.pop_back();
 	}
 }
 
-void StyleManager::setDefaultShape(propertyId_t type,AbstractShape * f){
-	if(type>=shapeRegistry.size())
-		initShapes(type+1);
-	shapeRegistry[type][0]=f;
+//! Upper bound for the number of cached derived styles; the least recently used one is removed when it is exceeded.
+static const size_t MAX_DERIVED_STYLES = 1024;
+
+//! (internal)
+ResolvedStyle * StyleManager::pushDerivedStyle(uint8_t valueKind,propertyId_t type,uint64_t value){
+	ResolvedStyle * const base = getActiveStyle();
+	// the cache is only used by the main thread
+	if(threadStackCount.load(std::memory_order_relaxed)!=0){
+		Util::Reference<ResolvedStyle> style = new ResolvedStyle(base,defaultsVersion);
+		pushStyle(style.get());
+		return style.get();
+	}
+	// a derived style only depends on its base style (which is never changed) and the defaults
+	if(derivedStylesVersion!=defaultsVersion){
+		derivedStyles.clear();
+		derivedStylesLru.clear();
+		derivedStylesVersion = defaultsVersion;
+	}
+	const DerivedStyleKey key{base,value,type,valueKind};
+	const auto it = derivedStyles.find(key);
+	if(it!=derivedStyles.end()){
+		derivedStylesLru.splice(derivedStylesLru.end(),derivedStylesLru,it->second.lruPosition);
+		pushStyle(it->second.style.get());
+		return nullptr;
+	}
+	if(derivedStyles.size()>=MAX_DERIVED_STYLES){
+		derivedStyles.erase(derivedStylesLru.front());
+		derivedStylesLru.pop_front();
+	}
+	Util::Reference<ResolvedStyle> style = new ResolvedStyle(base,defaultsVersion);
+	derivedStyles[key] = DerivedStyleEntry{style,derivedStylesLru.insert(derivedStylesLru.end(),key)};
+	pushStyle(style.get());
+	return style.get();
 }
+
+//! (internal)
+Util::Reference<ResolvedStyle> StyleManager::resolveStyle(ResolvedStyle * base,const displayPropertyList_t & properties){
+	Util::Reference<ResolvedStyle> style = new ResolvedStyle(base,getStyleVersion(properties));
+	// the properties push their values into the new style; Use*Properties read the values set so far.
+	StyleStack & stack = getStack();
+	ResolvedStyle * const oldRecordingStyle = stack.recordingStyle;
+	stack.recordingStyle = style.get();
+	pushStyle(style.get());
+	for(const auto & p : properties)
+		p->enable(*this);
+	popStyle();
+	stack.recordingStyle = oldRecordingStyle;
+	return style;
+}
+
+void StyleManager::updateResolvedStyle(Util::Reference<ResolvedStyle> & cachedStyle,ResolvedStyle * base,
+										const displayPropertyList_t & properties){
+	if(properties.empty()){
+		cachedStyle = base;
+	}else if(cachedStyle.isNull() || cachedStyle == base || cachedStyle->getBase()!=base || cachedStyle->getVersion()!=getStyleVersion(properties)){
+		cachedStyle = resolveStyle(base,properties);
+	}
+}
+
+//------------------------------------------------------
+// thread style stacks
+
+//! The ThreadStyleStacks bound to the current thread (linked via 'previous').
+static thread_local StyleManager::ThreadStyleStack * boundThreadStyleStack = nullptr;
+
+//! (internal)
+StyleManager::StyleStack & StyleManager::getThreadStack(){
+	for(ThreadStyleStack * t = boundThreadStyleStack; t!=nullptr; t = t->previous){
+		if(&t->manager==this)
+			return t->stack;
+	}
+	return mainStack;
+}
+
+//! (ctor)
+StyleManager::ThreadStyleStack::ThreadStyleStack(StyleManager & _manager,ResolvedStyle * initialStyle) :
+		manager(_manager),previous(boundThreadStyleStack) {
+	stack.activeStyle = initialStyle;
+	boundThreadStyleStack = this;
+	manager.threadStackCount.fetch_add(1,std::memory_order_relaxed);
+}
+
+//! (dtor)
+StyleManager::ThreadStyleStack::~ThreadStyleStack(){
+	manager.threadStackCount.fetch_sub(1,std::memory_order_relaxed);
+	boundThreadStyleStack = previous;
+}
+
+//------------------------------------------------------
+// ResolvedStyle
+
+//! (ctor)
+ResolvedStyle::ResolvedStyle(ResolvedStyle * _base,uint32_t _version) : base(_base), version(_version) {
+	if(base.isNotNull()){
+		colors = base->colors;
+		fonts = base->fonts;
+		shapes = base->shapes;
+	}
+}
+
+template<typename entries_t>
+static typename entries_t::const_iterator findEntry(const entries_t & entries,propertyId_t type){
+	return std::lower_bound(entries.begin(),entries.end(),type,
+							[](const typename entries_t::value_type & entry,propertyId_t t){ return entry.first<t; });
+}
+
+template<typename entries_t,typename value_t>
+static void setEntry(entries_t & entries,propertyId_t type,value_t && value){
+	auto it = std::lower_bound(entries.begin(),entries.end(),type,
+							[](const typename entries_t::value_type & entry,propertyId_t t){ return entry.first<t; });
+	if(it!=entries.end() && it->first==type)
+		it->second = std::forward<value_t>(value);
+	else
+		entries.emplace(it,type,std::forward<value_t>(value));
+}
+
+const Util::Color4ub * ResolvedStyle::findColor(propertyId_t type)const{
+	const auto it = findEntry(colors,type);
+	return (it!=colors.end() && it->first==type) ? &it->second : nullptr;
+}
+
+bool ResolvedStyle::findFont(propertyId_t type,AbstractFont * & font)const{
+	const auto it = findEntry(fonts,type);
+	if(it==fonts.end() || it->first!=type)
+		return false;
+	font = it->second.get();
+	return true;
+}
+
+bool ResolvedStyle::findShape(propertyId_t type,AbstractShape * & shape)const{
+	const auto it = findEntry(shapes,type);
+	if(it==shapes.end() || it->first!=type)
+		return false;
+	shape = it->second.get();
+	return true;
+}
+
+void ResolvedStyle::setColor(propertyId_t type,const Util::Color4ub & c)	{	setEntry(colors,type,c);	}
+void ResolvedStyle::setFont(propertyId_t type,AbstractFont * f)				{	setEntry(fonts,type,Util::Reference<AbstractFont>(f));	}
+void ResolvedStyle::setShape(propertyId_t type,AbstractShape * s)			{	setEntry(shapes,type,Util::Reference<AbstractShape>(s));	}
+
 //------------------------------------------------------
 
 float StyleManager::getGlobalValue(propertyId_t type)const{
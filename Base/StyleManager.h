@@ -13,12 +13,16 @@
 
 #include "Fonts/AbstractFont.h"
 #include "AbstractShape.h"
+#include "AbstractProperty.h"
+#include <Util/ReferenceCounter.h>
 #include <Util/References.h>
 #include <Util/Macros.h>
 
 #include <Util/Serialization/Serialization.h>
 
+#include <atomic>
 #include <cstdint>
+#include <list>
 #include <stack>
 #include <vector>
 #include <string>
@@ -33,19 +37,54 @@ class Cursor;
 namespace GUI{
 typedef uint8_t propertyId_t;
 typedef std::string propertyName_t;
+class StyleManager;
+
+/*! A ResolvedStyle contains the values of all colors, fonts and shapes that are
+	overridden by DisplayProperties on the way from the root to a component (based
+	on the ResolvedStyle of the enclosing component). Values that are not overridden
+	are taken from the StyleManager's defaults.
+	ResolvedStyles are immutable after creation; components cache them until their properties,
+	the style of their parent or any style default changes (see StyleManager::updateResolvedStyle(...)). */
+class ResolvedStyle : public Util::ReferenceCounter<ResolvedStyle>{
+	public:
+		//! (ctor) Create a style containing all values of the base style.
+		GUIAPI ResolvedStyle(ResolvedStyle * _base,uint32_t _version);
+
+		ResolvedStyle * getBase()const										{	return base.get();	}
+		uint32_t getVersion()const											{	return version;	}
+
+		//! Returns nullptr if the color is not set by this style.
+		GUIAPI const Util::Color4ub * findColor(propertyId_t type)const;
+		//! Returns false if the font is not set by this style.
+		GUIAPI bool findFont(propertyId_t type,AbstractFont * & font)const;
+		//! Returns false if the shape is not set by this style.
+		GUIAPI bool findShape(propertyId_t type,AbstractShape * & shape)const;
+
+	private:
+		friend class StyleManager;
+		GUIAPI void setColor(propertyId_t type,const Util::Color4ub & c);
+		GUIAPI void setFont(propertyId_t type,AbstractFont * f);
+		GUIAPI void setShape(propertyId_t type,AbstractShape * s);
+
+		const Util::Reference<ResolvedStyle> base;
+		const uint32_t version;
+		// entries are sorted by their property id
+		std::vector<std::pair<propertyId_t,Util::Color4ub>> colors;
+		std::vector<std::pair<propertyId_t,Util::Reference<AbstractFont>>> fonts;
+		std::vector<std::pair<propertyId_t,Util::Reference<AbstractShape>>> shapes;
+};
 
 class StyleManager{
 	public:
-		~StyleManager();
+		GUIAPI StyleManager();
+		GUIAPI ~StyleManager();
 
 	// ----------------------------------------------------------------
 
 	//!	@name Color
 	// @{
 	private:
-		typedef std::vector<Util::Color4ub> colorStack_t; // actvive property colors; index 0 always contains the default property color
-		typedef std::vector<colorStack_t> colorRegistry_t; // propertyTypeId -> colorStack_t
-		colorRegistry_t colorRegistry;
+		std::vector<Util::Color4ub> defaultColors; // propertyTypeId -> default color
 
 		//! (internal) Increase the size of the registry and set the default entries.
 		GUIAPI void initColors(size_t newSize);
@@ -60,9 +99,7 @@ class StyleManager{
 	//!	@name Font
 	// @{
 	private:
-		typedef std::vector<Util::Reference<AbstractFont> > fontStack_t;
-		typedef std::vector<fontStack_t> fontRegistry_t;
-		fontRegistry_t fontRegistry;
+		std::vector<Util::Reference<AbstractFont> > defaultFonts;
 
 		//! (internal) Increase the size of the registry and set the default entries.
 		GUIAPI void initFonts(size_t newSize);
@@ -96,9 +133,7 @@ class StyleManager{
 	//!	@name Shape
 	// @{
 	private:
-		typedef std::vector<Util::Reference<AbstractShape> > shapeStack_t;
-		typedef std::vector<shapeStack_t> shapeRegistry_t;
-		shapeRegistry_t shapeRegistry;
+		std::vector<Util::Reference<AbstractShape> > defaultShapes;
 
 		//! (internal) Increase the size of the registry and set the default entries.
 		GUIAPI void initShapes(size_t newSize);
@@ -112,6 +147,98 @@ class StyleManager{
 
 	// ----------------------------------------------------------------
 
+	//!	@name Resolved styles
+	// @{
+	private:
+		struct StyleStack{
+			Util::Reference<ResolvedStyle> activeStyle;
+			std::vector<Util::Reference<ResolvedStyle>> previousStyles;
+			ResolvedStyle * recordingStyle; // while resolving a style, pushed values are stored here
+			StyleStack() : recordingStyle(nullptr) {}
+		};
+		StyleStack mainStack;
+		std::atomic<int> threadStackCount; // number of bound ThreadStyleStacks
+		uint32_t defaultsVersion;
+
+		//! Identifies a style derived from a base style by setting a single value (see pushDerivedStyle(...)).
+		struct DerivedStyleKey{
+			const ResolvedStyle * base;
+			uint64_t value; // color as uint or font/shape pointer
+			propertyId_t type;
+			uint8_t valueKind;
+			bool operator==(const DerivedStyleKey & other)const{
+				return base==other.base && value==other.value && type==other.type && valueKind==other.valueKind;
+			}
+		};
+		struct DerivedStyleKeyHash{
+			size_t operator()(const DerivedStyleKey & key)const{
+				return std::hash<const void*>()(key.base) ^ (std::hash<uint64_t>()(key.value)*31u) ^ (static_cast<size_t>(key.type)<<8|key.valueKind);
+			}
+		};
+		struct DerivedStyleEntry{
+			Util::Reference<ResolvedStyle> style;
+			std::list<DerivedStyleKey>::iterator lruPosition;
+		};
+		/*! Styles created by pushColor/pushFont/pushShape outside of style resolution (e.g. by GUI_Manager::enableProperty(...)
+			during display). Reusing them keeps the base of the children's resolved styles stable between frames.
+			The entries keep their base styles alive, so the base pointers in the keys stay valid.
+			If the cache is full, the least recently used entry is removed. */
+		std::unordered_map<DerivedStyleKey,DerivedStyleEntry,DerivedStyleKeyHash> derivedStyles;
+		std::list<DerivedStyleKey> derivedStylesLru; // least recently used first
+		uint32_t derivedStylesVersion;
+		//! (internal) The style stack of the calling thread.
+		StyleStack & getStack()												{	return threadStackCount.load(std::memory_order_relaxed)==0 ? mainStack : getThreadStack();	}
+		const StyleStack & getStack()const									{	return const_cast<StyleManager*>(this)->getStack();	}
+		GUIAPI StyleStack & getThreadStack();
+
+		//! (internal) Create a new style based on the given base style by applying all given properties.
+		GUIAPI Util::Reference<ResolvedStyle> resolveStyle(ResolvedStyle * base,const displayPropertyList_t & properties);
+		/*! (internal) Push a copy of the active style for setting a single value by pushColor/pushFont/pushShape.
+			If an up to date style for the same value exists, it is pushed instead and nullptr is returned;
+			otherwise the new style is returned and the caller has to set the value. */
+		GUIAPI ResolvedStyle * pushDerivedStyle(uint8_t valueKind,propertyId_t type,uint64_t value);
+	public:
+		//! The style of the currently displayed component; nullptr if only the defaults are used.
+		ResolvedStyle * getActiveStyle()const								{	return getStack().activeStyle.get();	}
+		GUIAPI void pushStyle(ResolvedStyle * style);
+		GUIAPI void popStyle();
+
+		/*! While an object of this class exists, the creating thread uses a style stack of its own that starts with
+			the given style. This allows layouting independent subtrees in parallel (see Component::INDEPENDENT_LAYOUT).
+			The defaults and the display properties must not be changed in the meantime.	*/
+		class ThreadStyleStack{
+			public:
+				GUIAPI ThreadStyleStack(StyleManager & manager,ResolvedStyle * initialStyle);
+				GUIAPI ~ThreadStyleStack();
+			private:
+				ThreadStyleStack(const ThreadStyleStack &) = delete;
+				ThreadStyleStack & operator=(const ThreadStyleStack &) = delete;
+				StyleManager & manager;
+				StyleStack stack;
+				ThreadStyleStack * previous;
+				friend class StyleManager;
+		};
+
+		/*! Changes whenever a default value or a value of one of the given properties is changed.
+			A resolved style with a different version than its properties is outdated. */
+		uint32_t getStyleVersion(const displayPropertyList_t & properties)const {
+			uint32_t version = defaultsVersion;
+			for(const auto & p : properties)
+				version += p->getModificationCount();
+			return version;
+		}
+		//! Outdate all resolved styles (e.g. after a value of a custom DisplayProperty has been changed).
+		void invalidateResolvedStyles()										{	++defaultsVersion;	}
+
+		/*! Make sure that the given cached style is based on the given base style, contains all given
+			properties and is up to date. If not, the style is re-resolved. If there are no properties,
+			the base style is used directly. */
+		GUIAPI void updateResolvedStyle(Util::Reference<ResolvedStyle> & cachedStyle,ResolvedStyle * base,
+										const displayPropertyList_t & properties);
+	//	@}
+
+	// ----------------------------------------------------------------
+
 	//!	@name (global) Value
 	// @{
 	private:
@@ -0,0 +1,309 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "TimerWheel.h"
+#include <Util/Timer.h>
+#include <algorithm>
+#include <limits>
+
+namespace GUI{
+
+//! Index of the lowest set bit; @p mask must not be 0.
+static inline size_t findFirstBit(uint64_t mask){
+#if defined(__GNUC__)
+	return static_cast<size_t>(__builtin_ctzll(mask));
+#else
+	size_t i = 0;
+	while((mask&1)==0){
+		mask >>= 1;
+		++i;
+	}
+	return i;
+#endif
+}
+
+//! Mask containing all bits above bit @p i.
+static inline uint64_t getMaskAbove(size_t i){
+	return i>=63 ? 0 : (~static_cast<uint64_t>(0))<<(i+1);
+}
+
+//! (ctor)
+TimerWheel::TimerWheel() : TimerWheel(&Util::Timer::now) {
+}
+
+//! (ctor)
+TimerWheel::TimerWheel(clockFun_t _clock) :
+		clock(std::move(_clock)),currentTick(toTick(clock())),nextSequence(0),timerCount(0),
+		firstFree(NONE),nextDeadline(std::numeric_limits<double>::infinity()),nextDeadlineValid(true) {
+	std::fill(std::begin(slotHeads),std::end(slotHeads),NONE);
+	std::fill(std::begin(occupied),std::end(occupied),0);
+}
+
+void TimerWheel::setClock(clockFun_t _clock){
+	clock = std::move(_clock);
+	// the new clock may lag behind the old one; re-insert the timers relative to the new time.
+	std::vector<int32_t> scheduled;
+	for(int32_t slot=0;slot<=OVERFLOW_SLOT;++slot){
+		for(int32_t i=slotHeads[slot];i!=NONE;i=timers[i].next)
+			scheduled.push_back(i);
+	}
+	for(int32_t i : scheduled){
+		unlink(i);
+		timers[i].tick = toTick(timers[i].deadline);
+	}
+	currentTick = toTick(clock());
+	for(int32_t i : scheduled)
+		insert(i);
+	nextDeadlineValid = false;
+}
+
+//! (static,internal)
+uint64_t TimerWheel::toTick(double time){
+	const double t = time / TICK_DURATION;
+	if(!(t>0))
+		return 0;
+	if(t >= static_cast<double>(std::numeric_limits<uint64_t>::max()/2))
+		return std::numeric_limits<uint64_t>::max()/2;
+	return static_cast<uint64_t>(t);
+}
+
+//! (internal)
+const TimerWheel::Timer * TimerWheel::getTimer(handle_t handle)const{
+	const uint32_t index = static_cast<uint32_t>(handle);
+	if(index>=timers.size() || timers[index].generation!=static_cast<uint32_t>(handle>>32) || (timers[index].generation&1)==0)
+		return nullptr;
+	return &timers[index];
+}
+
+TimerWheel::handle_t TimerWheel::schedule(double time,callback_t callback){
+	int32_t index = firstFree;
+	if(index==NONE){
+		index = static_cast<int32_t>(timers.size());
+		timers.emplace_back();
+	}else{
+		firstFree = timers[index].next;
+	}
+	Timer & timer = timers[index];
+	++timer.generation;
+	timer.deadline = time;
+	timer.tick = toTick(time);
+	timer.callback = std::move(callback);
+	timer.sequence = nextSequence++;
+	insert(index);
+	++timerCount;
+
+	if(nextDeadlineValid && time<nextDeadline)
+		nextDeadline = time;
+	return toHandle(index,timer.generation);
+}
+
+bool TimerWheel::cancel(handle_t handle){
+	if(getTimer(handle)==nullptr)
+		return false;
+	const int32_t index = static_cast<int32_t>(static_cast<uint32_t>(handle));
+	if(timers[index].deadline<=nextDeadline)
+		nextDeadlineValid = false;
+	unlink(index);
+	release(index);
+	return true;
+}
+
+bool TimerWheel::isScheduled(handle_t handle)const{
+	return getTimer(handle)!=nullptr;
+}
+
+void TimerWheel::clear(){
+	for(int32_t slot=0;slot<=OVERFLOW_SLOT;++slot){
+		while(slotHeads[slot]!=NONE){
+			const int32_t index = slotHeads[slot];
+			unlink(index);
+			release(index);
+		}
+	}
+	nextDeadline = std::numeric_limits<double>::infinity();
+	nextDeadlineValid = true;
+}
+
+double TimerWheel::getNextDeadline()const{
+	if(nextDeadlineValid)
+		return nextDeadline;
+	nextDeadlineValid = true;
+	nextDeadline = std::numeric_limits<double>::infinity();
+	if(timerCount==0)
+		return nextDeadline;
+
+	// the first non-empty slot contains the earliest timer: level 0 starting at the current slot,
+	// then the higher levels behind their current slot, then the overflow list.
+	int32_t slot = NONE;
+	const size_t currentIndex = static_cast<size_t>(currentTick & (SLOT_COUNT-1));
+	const uint64_t level0 = occupied[0] & ((~static_cast<uint64_t>(0))<<currentIndex);
+	if(level0!=0){
+		slot = static_cast<int32_t>(findFirstBit(level0));
+	}else{
+		for(size_t level=1;level<LEVEL_COUNT && slot==NONE;++level){
+			const size_t index = static_cast<size_t>((currentTick>>(SLOT_BITS*level)) & (SLOT_COUNT-1));
+			const uint64_t mask = occupied[level] & getMaskAbove(index);
+			if(mask!=0)
+				slot = static_cast<int32_t>(level*SLOT_COUNT+findFirstBit(mask));
+		}
+		if(slot==NONE)
+			slot = OVERFLOW_SLOT;
+	}
+	for(int32_t i=slotHeads[slot];i!=NONE;i=timers[i].next)
+		nextDeadline = std::min(nextDeadline,timers[i].deadline);
+	return nextDeadline;
+}
+
+//! (internal)
+void TimerWheel::insert(int32_t index){
+	Timer & timer = timers[index];
+	if(timer.tick<currentTick)
+		timer.tick = currentTick;
+
+	int32_t slot = OVERFLOW_SLOT;
+	for(size_t level=0;level<LEVEL_COUNT;++level){
+		const size_t blockShift = SLOT_BITS*(level+1);
+		if( (timer.tick>>blockShift) == (currentTick>>blockShift) ){
+			const size_t slotIndex = static_cast<size_t>((timer.tick>>(SLOT_BITS*level)) & (SLOT_COUNT-1));
+			slot = static_cast<int32_t>(level*SLOT_COUNT+slotIndex);
+			occupied[level] |= static_cast<uint64_t>(1)<<slotIndex;
+			break;
+		}
+	}
+	timer.slot = slot;
+	timer.prev = NONE;
+	timer.next = slotHeads[slot];
+	if(timer.next!=NONE)
+		timers[timer.next].prev = index;
+	slotHeads[slot] = index;
+}
+
+//! (internal)
+void TimerWheel::unlink(int32_t index){
+	Timer & timer = timers[index];
+	if(timer.prev!=NONE)
+		timers[timer.prev].next = timer.next;
+	else
+		slotHeads[timer.slot] = timer.next;
+	if(timer.next!=NONE)
+		timers[timer.next].prev = timer.prev;
+	if(slotHeads[timer.slot]==NONE && timer.slot!=OVERFLOW_SLOT)
+		occupied[timer.slot/SLOT_COUNT] &= ~(static_cast<uint64_t>(1)<<(timer.slot%SLOT_COUNT));
+	timer.slot = timer.prev = timer.next = NONE;
+}
+
+//! (internal)
+void TimerWheel::release(int32_t index){
+	Timer & timer = timers[index];
+	++timer.generation;
+	timer.callback = nullptr;
+	timer.next = firstFree;
+	firstFree = index;
+	--timerCount;
+}
+
+//! (internal)
+void TimerWheel::cascade(int32_t slot){
+	int32_t i = slotHeads[slot];
+	slotHeads[slot] = NONE;
+	if(slot!=OVERFLOW_SLOT)
+		occupied[slot/SLOT_COUNT] &= ~(static_cast<uint64_t>(1)<<(slot%SLOT_COUNT));
+	while(i!=NONE){
+		const int32_t next = timers[i].next;
+		insert(i);
+		i = next;
+	}
+}
+
+//! (internal)
+uint64_t TimerWheel::findNextEventTick()const{
+	uint64_t nextTick = std::numeric_limits<uint64_t>::max();
+	for(size_t level=0;level<LEVEL_COUNT;++level){
+		const size_t slotShift = SLOT_BITS*level;
+		const size_t index = static_cast<size_t>((currentTick>>slotShift) & (SLOT_COUNT-1));
+		const uint64_t mask = occupied[level] & getMaskAbove(index);
+		if(mask!=0){
+			const uint64_t blockStart = (currentTick>>(slotShift+SLOT_BITS))<<(slotShift+SLOT_BITS);
+			nextTick = std::min(nextTick,blockStart + (static_cast<uint64_t>(findFirstBit(mask))<<slotShift));
+		}
+	}
+	if(slotHeads[OVERFLOW_SLOT]!=NONE){
+		const size_t wheelShift = SLOT_BITS*LEVEL_COUNT;
+		nextTick = std::min(nextTick,((currentTick>>wheelShift)+1)<<wheelShift);
+	}
+	return nextTick;
+}
+
+//! (internal)
+void TimerWheel::advanceTo(uint64_t tick){
+	currentTick = tick;
+	const size_t wheelShift = SLOT_BITS*LEVEL_COUNT;
+	if( (tick & ((static_cast<uint64_t>(1)<<wheelShift)-1)) == 0 )
+		cascade(OVERFLOW_SLOT);
+	for(size_t level=LEVEL_COUNT-1;level>0;--level){
+		const size_t slotShift = SLOT_BITS*level;
+		if( (tick & ((static_cast<uint64_t>(1)<<slotShift)-1)) == 0 )
+			cascade(static_cast<int32_t>(level*SLOT_COUNT + ((tick>>slotShift) & (SLOT_COUNT-1))));
+	}
+}
+
+//! (internal)
+void TimerWheel::collectDueTimers(double now,bool all){
+	const int32_t slot = static_cast<int32_t>(currentTick & (SLOT_COUNT-1));
+	int32_t i = slotHeads[slot];
+	while(i!=NONE){
+		const int32_t next = timers[i].next;
+		if(all || timers[i].deadline<=now){
+			dueTimers.emplace_back(timers[i].deadline,timers[i].sequence,std::move(timers[i].callback));
+			unlink(i);
+			release(i);
+		}
+		i = next;
+	}
+}
+
+size_t TimerWheel::execute(){
+	const double now = getTime();
+	const uint64_t targetTick = toTick(now);
+	if(timerCount==0){
+		currentTick = std::max(currentTick,targetTick);
+		return 0;
+	}
+	if(now<getNextDeadline())
+		return 0;
+
+	dueTimers.clear();
+	while(true){
+		collectDueTimers(now,currentTick<targetTick);
+		if(currentTick>=targetTick)
+			break;
+		const uint64_t nextTick = findNextEventTick();
+		if(nextTick>targetTick)
+			currentTick = targetTick; // no slot starts in between
+		else
+			advanceTo(nextTick);
+	}
+	nextDeadlineValid = false;
+
+	// the callbacks may schedule new timers or call execute() again.
+	std::vector<DueTimer> due;
+	due.swap(dueTimers);
+	std::sort(due.begin(),due.end());
+	for(auto & dueTimer : due)
+		dueTimer.callback(now);
+	const size_t count = due.size();
+	if(dueTimers.empty()){ // keep the memory for the next call
+		due.clear();
+		dueTimers.swap(due);
+	}
+	return count;
+}
+
+}
@@ -0,0 +1,133 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_TIMER_WHEEL_H
+#define GUI_TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace GUI{
+
+/*! Hierarchical timer wheel executing callbacks at given points in time.
+	The deadlines are sorted into LEVEL_COUNT levels of SLOT_COUNT slots each, the lowest level having
+	a resolution of one tick (TICK_DURATION seconds); timers beyond the range of the wheel are kept in an
+	overflow list. Scheduling and canceling a timer is O(1); when time advances, empty slots are skipped
+	using per level occupancy masks and the timers of higher levels are moved down (cascaded) when their
+	slot is reached. The earliest deadline is cached, so execute() costs nothing while no timer is due.
+	The time is queried from an exchangeable clock (Util::Timer::now() by default), which allows
+	deterministic testing.
+	\note Timers are one-shot; a callback may schedule a new timer (e.g. for repeating actions).	*/
+class TimerWheel{
+	public:
+		typedef std::function<double ()> clockFun_t;
+		//! Called with the time the timer is executed at (which may be later than its deadline).
+		typedef std::function<void (double)> callback_t;
+		//! Identifies a scheduled timer; 0 is never used as a valid handle.
+		typedef uint64_t handle_t;
+
+		static const size_t LEVEL_COUNT = 4;
+		static const size_t SLOT_BITS = 6;
+		static const size_t SLOT_COUNT = 1<<SLOT_BITS;
+		static constexpr double TICK_DURATION = 0.001; // sec
+
+		GUIAPI TimerWheel();
+		GUIAPI explicit TimerWheel(clockFun_t clock);
+
+		//! Replace the clock. The timers keep their absolute deadlines.
+		GUIAPI void setClock(clockFun_t clock);
+		double getTime()const								{	return clock();	}
+
+		//! Execute @p callback as soon as execute() is called at or after @p time (in seconds).
+		GUIAPI handle_t schedule(double time,callback_t callback);
+		//! Execute @p callback @p delay seconds from now.
+		handle_t scheduleIn(double delay,callback_t callback)	{	return schedule(getTime()+delay,std::move(callback));	}
+		//! Remove the timer; returns false if the timer has already been executed or canceled.
+		GUIAPI bool cancel(handle_t handle);
+		GUIAPI bool isScheduled(handle_t handle)const;
+
+		//! Returns the earliest deadline of all scheduled timers or infinity if there are none.
+		GUIAPI double getNextDeadline()const;
+		size_t getTimerCount()const							{	return timerCount;	}
+		bool empty()const									{	return timerCount==0;	}
+
+		/*! Execute the callbacks of all timers that are due at the current time of the clock (in the order
+			of their deadlines) and return their number. Timers scheduled by the callbacks are executed by
+			the next call at the earliest.	*/
+		GUIAPI size_t execute();
+		//! Remove all timers without executing them.
+		GUIAPI void clear();
+
+	private:
+		TimerWheel(const TimerWheel &) = delete;
+		TimerWheel & operator=(const TimerWheel &) = delete;
+
+		static const int32_t NONE = -1;
+		static const int32_t OVERFLOW_SLOT = static_cast<int32_t>(LEVEL_COUNT*SLOT_COUNT);
+
+		struct Timer{
+			double deadline;
+			uint64_t tick;
+			callback_t callback;
+			uint64_t sequence;		//!< order of scheduling (for timers with equal deadlines)
+			uint32_t generation;	//!< increased when the entry is allocated or released; odd values mark scheduled timers
+			int32_t slot;			//!< level*SLOT_COUNT+index, OVERFLOW_SLOT or NONE
+			int32_t prev,next;		//!< neighbors in the slot's list or the next free entry
+			Timer() : deadline(0),tick(0),sequence(0),generation(0),slot(NONE),prev(NONE),next(NONE) {}
+		};
+
+		static uint64_t toTick(double time);
+		static handle_t toHandle(int32_t index,uint32_t generation)	{	return (static_cast<uint64_t>(generation)<<32) | static_cast<uint32_t>(index);	}
+		const Timer * getTimer(handle_t handle)const;
+
+		//! (internal) Put the timer into the slot matching its tick relative to currentTick.
+		void insert(int32_t index);
+		//! (internal) Remove the timer from its slot.
+		void unlink(int32_t index);
+		void release(int32_t index);
+		//! (internal) Re-insert the timers of the given slot (they move to lower levels).
+		void cascade(int32_t slot);
+		//! (internal) Set currentTick to @p tick and cascade the slots starting there.
+		void advanceTo(uint64_t tick);
+		//! (internal) Move the due timers (or all timers) of the current level 0 slot into dueTimers.
+		void collectDueTimers(double now,bool all);
+		//! (internal) Returns the first tick after currentTick at which a non-empty slot starts (or ~0).
+		uint64_t findNextEventTick()const;
+
+		clockFun_t clock;
+		uint64_t currentTick;
+		uint64_t nextSequence;
+		size_t timerCount;
+
+		std::vector<Timer> timers;
+		int32_t firstFree;
+		int32_t slotHeads[LEVEL_COUNT*SLOT_COUNT+1]; //!< including the overflow list
+		uint64_t occupied[LEVEL_COUNT];				//!< bit i set iff the slot i of the level is not empty
+
+		mutable double nextDeadline;
+		mutable bool nextDeadlineValid;
+
+		struct DueTimer{
+			double deadline;
+			uint64_t sequence;
+			callback_t callback;
+			DueTimer(double d,uint64_t s,callback_t c) : deadline(d),sequence(s),callback(std::move(c)) {}
+			bool operator<(const DueTimer & other)const	{
+				return deadline<other.deadline || (deadline==other.deadline && sequence<other.sequence);
+			}
+		};
+		std::vector<DueTimer> dueTimers;
+};
+
+}
+#endif // GUI_TIMER_WHEEL_H
@@ -0,0 +1,143 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_TWEEN_ANIMATION_H
+#define GUI_TWEEN_ANIMATION_H
+
+#include "AnimationHandler.h"
+#include "../Components/Component.h"
+#include <Geometry/Rect.h>
+#include <Geometry/Vec2.h>
+#include <Util/Graphics/Color.h>
+#include <functional>
+#include <utility>
+
+namespace GUI{
+
+//! Easing curves mapping the relative time [0,1] of an animation to its progress [0,1].
+enum easing_t{
+	EASE_LINEAR,
+	EASE_IN_QUAD,
+	EASE_OUT_QUAD,
+	EASE_IN_OUT_QUAD,
+	EASE_OUT_CUBIC,
+	EASE_IN_OUT_CUBIC,
+	EASE_SMOOTH_STEP
+};
+
+//! Evaluate the easing curve (closed form) at the relative time t (clamped to [0,1]).
+inline float applyEasing(easing_t easing,float t){
+	t = t<0.0f ? 0.0f : (t>1.0f ? 1.0f : t);
+	switch(easing){
+		case EASE_IN_QUAD:
+			return t*t;
+		case EASE_OUT_QUAD:
+			return t*(2.0f-t);
+		case EASE_IN_OUT_QUAD:
+			return t<0.5f ? 2.0f*t*t : -1.0f+(4.0f-2.0f*t)*t;
+		case EASE_OUT_CUBIC:{
+			const float u = 1.0f-t;
+			return 1.0f-u*u*u;
+		}
+		case EASE_IN_OUT_CUBIC:{
+			if(t<0.5f)
+				return 4.0f*t*t*t;
+			const float u = 2.0f*t-2.0f;
+			return 0.5f*u*u*u+1.0f;
+		}
+		case EASE_SMOOTH_STEP:
+			return t*t*(3.0f-2.0f*t);
+		case EASE_LINEAR:
+		default:
+			return t;
+	}
+}
+
+//! @name Linear interpolation of the animatable value types
+//	@{
+inline float interpolate(float a,float b,float t)	{	return a+(b-a)*t;	}
+inline Geometry::Vec2 interpolate(const Geometry::Vec2 & a,const Geometry::Vec2 & b,float t){
+	return Geometry::Vec2(interpolate(a.getX(),b.getX(),t),interpolate(a.getY(),b.getY(),t));
+}
+inline Geometry::Rect interpolate(const Geometry::Rect & a,const Geometry::Rect & b,float t){
+	return Geometry::Rect(interpolate(a.getX(),b.getX(),t),interpolate(a.getY(),b.getY(),t),
+							interpolate(a.getWidth(),b.getWidth(),t),interpolate(a.getHeight(),b.getHeight(),t));
+}
+inline Util::Color4f interpolate(const Util::Color4f & a,const Util::Color4f & b,float t){
+	return Util::Color4f(interpolate(a.getR(),b.getR(),t),interpolate(a.getG(),b.getG(),t),
+							interpolate(a.getB(),b.getB(),t),interpolate(a.getA(),b.getA(),t));
+}
+//	@}
+
+/*! Animation of a single value from a source to a target value. The value is computed in closed form
+	from the elapsed time (no incremental updates), so the costs per frame are constant and the result
+	does not depend on the frame rate. The new value is passed to the setter function.	*/
+template<typename value_t>
+class TweenAnimation : public AnimationHandler{
+	public:
+		typedef std::function<void (const value_t &)> setter_t;
+
+		TweenAnimation(Component * c,value_t _source,value_t _target,float _duration,setter_t _setter,easing_t _easing=EASE_OUT_CUBIC) :
+				AnimationHandler(c,_duration),source(std::move(_source)),target(std::move(_target)),
+				setter(std::move(_setter)),easing(_easing){
+		}
+		virtual ~TweenAnimation()	{}
+
+		const value_t & getSource()const	{	return source;	}
+		const value_t & getTarget()const	{	return target;	}
+
+		// ---|> AnimationHandler
+		bool animate(float currentTime) override {
+			if(currentTime >= getEndTime()) {
+				finish();
+				return false;
+			}
+			setter(interpolate(source,target,applyEasing(easing,(currentTime-getStartTime())/getDuration())));
+			return true;
+		}
+
+		// ---|> AnimationHandler
+		void finish() override {
+			setter(target);
+		}
+
+	private:
+		value_t source;
+		value_t target;
+		setter_t setter;
+		easing_t easing;
+};
+
+//! Animation of a component's rect (position and size).
+inline AnimationHandler * createRectTween(Component * c,const Geometry::Rect & target,float duration,easing_t easing=EASE_OUT_CUBIC){
+	return new TweenAnimation<Geometry::Rect>(c,c->getRect(),target,duration,
+												[c](const Geometry::Rect & r){	c->setRect(r);	},easing);
+}
+
+//! Animation of a component's position.
+inline AnimationHandler * createPositionTween(Component * c,const Geometry::Vec2 & target,float duration,easing_t easing=EASE_OUT_CUBIC){
+	return new TweenAnimation<Geometry::Vec2>(c,c->getPosition(),target,duration,
+												[c](const Geometry::Vec2 & p){	c->setPosition(p);	},easing);
+}
+
+//! Animation of a scroll position; @p setter is called with the new position (e.g. ScrollableContainer::scrollTo).
+inline AnimationHandler * createScrollTween(Component * c,const Geometry::Vec2 & source,const Geometry::Vec2 & target,float duration,
+											TweenAnimation<Geometry::Vec2>::setter_t setter,easing_t easing=EASE_OUT_CUBIC){
+	return new TweenAnimation<Geometry::Vec2>(c,source,target,duration,std::move(setter),easing);
+}
+
+//! Animation of a color; @p setter is called with the new color (e.g. to update a color property).
+inline AnimationHandler * createColorTween(Component * c,const Util::Color4f & source,const Util::Color4f & target,float duration,
+											TweenAnimation<Util::Color4f>::setter_t setter,easing_t easing=EASE_LINEAR){
+	return new TweenAnimation<Util::Color4f>(c,source,target,duration,std::move(setter),easing);
+}
+
+}
+#endif // GUI_TWEEN_ANIMATION_H
@@ -0,0 +1,191 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "TypeAheadIndex.h"
+#include "../Components/Container.h"
+#include "../Components/Label.h"
+#include <Util/UI/Event.h>
+#include <limits>
+
+namespace GUI{
+
+//! (ctor)
+TypeAheadIndex::TypeAheadIndex() : lastInputTime(-std::numeric_limits<double>::infinity()),timeout(1.0) {
+}
+
+// -------------------------------------------------------------------
+// Index
+
+bool TypeAheadIndex::set(id_t id,const std::string & label){
+	std::string key(normalize(label));
+	if(key.empty())
+		return remove(id);
+	const auto it = keys.find(id);
+	if(it!=keys.end()){
+		if(it->second==key)
+			return false;
+		sortedKeys.erase(std::make_pair(it->second,id));
+		it->second = key;
+	}else{
+		keys.emplace(id,key);
+	}
+	sortedKeys.emplace(std::move(key),id);
+	return true;
+}
+
+bool TypeAheadIndex::remove(id_t id){
+	const auto it = keys.find(id);
+	if(it==keys.end())
+		return false;
+	sortedKeys.erase(std::make_pair(it->second,id));
+	keys.erase(it);
+	return true;
+}
+
+void TypeAheadIndex::clear(){
+	sortedKeys.clear();
+	keys.clear();
+}
+
+//! (internal)
+bool TypeAheadIndex::isMatch(const keySet_t::const_iterator & it,const std::string & p)const{
+	return it!=sortedKeys.end() && it->first.compare(0,p.length(),p)==0;
+}
+
+//! (internal)
+TypeAheadIndex::keySet_t::const_iterator TypeAheadIndex::getLabelEnd(const keySet_t::const_iterator & it)const{
+	return sortedKeys.upper_bound(std::make_pair(it->first,std::numeric_limits<id_t>::max()));
+}
+
+bool TypeAheadIndex::find(const std::string & p,id_t & result)const{
+	// the keys beginning with p directly follow p in the sorted set
+	auto it = sortedKeys.lower_bound(std::make_pair(p,static_cast<id_t>(0)));
+	if(!isMatch(it,p))
+		return false;
+	// the entries with equal labels are sorted by their ids -> take the first one in the entry order
+	result = it->second;
+	for(const auto end = getLabelEnd(it); ++it!=end; ){
+		if(isBefore(it->second,result))
+			result = it->second;
+	}
+	return true;
+}
+
+bool TypeAheadIndex::findNext(const std::string & p,id_t current,id_t & result)const{
+	const auto currentKey = keys.find(current);
+	if(currentKey==keys.end() || currentKey->second.compare(0,p.length(),p)!=0)
+		return find(p,result);
+	// the next entry with the same label in the entry order
+	const auto begin = sortedKeys.lower_bound(std::make_pair(currentKey->second,static_cast<id_t>(0)));
+	const auto end = getLabelEnd(begin);
+	bool found = false;
+	for(auto it = begin; it!=end; ++it){
+		if(isBefore(current,it->second) && (!found || isBefore(it->second,result))){
+			result = it->second;
+			found = true;
+		}
+	}
+	if(found)
+		return true;
+	// the first entry of the next label
+	if(!isMatch(end,p)) // wrap around
+		return find(p,result);
+	result = end->second;
+	for(auto it = end, labelEnd = getLabelEnd(end); ++it!=labelEnd; ){
+		if(isBefore(it->second,result))
+			result = it->second;
+	}
+	return true;
+}
+
+bool TypeAheadIndex::matches(id_t id,const std::string & p)const{
+	const auto it = keys.find(id);
+	return it!=keys.end() && it->second.compare(0,p.length(),p)==0;
+}
+
+// -------------------------------------------------------------------
+// Input
+
+bool TypeAheadIndex::appendInput(const Util::UI::KeyboardEvent & keyEvent,double time){
+	if(!keyEvent.pressed || !(keyEvent.str[0] >= 32 || keyEvent.str[0]<0)) // no ascii or utf8 character
+		return false;
+	if(time-lastInputTime>timeout)
+		prefix.clear();
+	lastInputTime = time;
+	std::string codePoint;
+	for(uint8_t p = 0;p<4&&keyEvent.str[p]!=0;++p)
+		codePoint += keyEvent.str[p];
+	prefix += normalize(codePoint);
+	return true;
+}
+
+bool TypeAheadIndex::search(bool hasCurrent,id_t current,id_t & result)const{
+	if(prefix.empty())
+		return false;
+	if(prefix.find_first_not_of(prefix[0])==std::string::npos){ // repeated character -> cycle
+		const std::string first(1,prefix[0]);
+		return hasCurrent ? findNext(first,current,result) : find(first,result);
+	}
+	return find(prefix,result);
+}
+
+// -------------------------------------------------------------------
+// Labels
+
+std::string TypeAheadIndex::normalize(const std::string & label){
+	std::string key(label);
+	for(auto & c : key){
+		if(c>='A' && c<='Z')
+			c += 'a'-'A';
+	}
+	return key;
+}
+
+std::string TypeAheadIndex::findLabel(Component * c){
+	if(c==nullptr)
+		return "";
+	const Label * label = castTo<Label>(c);
+	if(label!=nullptr)
+		return label->getText();
+	const Container * container = castTo<Container>(c);
+	if(container!=nullptr){
+		for(Component * child = container->getFirstChild(); child!=nullptr; child = child->getNext()){
+			const std::string text(findLabel(child));
+			if(!text.empty())
+				return text;
+		}
+	}
+	return "";
+}
+
+bool TypeAheadIndex::isBeforeInTree(const Component * a,const Component * b){
+	size_t depthA = 0;
+	for(const Component * c = a; c->getParent()!=nullptr; c = c->getParent())
+		++depthA;
+	size_t depthB = 0;
+	for(const Component * c = b; c->getParent()!=nullptr; c = c->getParent())
+		++depthB;
+	// move both to the same depth; an ancestor is in front of its descendants
+	const Component * ancestorA = a;
+	for(size_t i = depthA; i>depthB; --i)
+		ancestorA = ancestorA->getParent();
+	const Component * ancestorB = b;
+	for(size_t i = depthB; i>depthA; --i)
+		ancestorB = ancestorB->getParent();
+	if(ancestorA==ancestorB)
+		return depthA<depthB;
+	while(ancestorA->getParent()!=ancestorB->getParent()){
+		ancestorA = ancestorA->getParent();
+		ancestorB = ancestorB->getParent();
+	}
+	return ancestorA->getIndexInParent()<ancestorB->getIndexInParent();
+}
+
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_TYPE_AHEAD_INDEX_H
+#define GUI_TYPE_AHEAD_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace Util {
+namespace UI {
+struct KeyboardEvent;
+}
+}
+
+namespace GUI{
+
+class Component;
+
+/*! Type-ahead search over the labels of the entries of a view (ListView, TreeView, Menu).
+	The typed characters are collected into a prefix, which is reset if no character is typed for
+	getTimeout() seconds. The labels are kept (case insensitively) in a sorted set, so a label can be
+	added or removed in O(log n) and the first entry beginning with a prefix is found in O(log n).
+	The entries are identified by an id chosen by the view (e.g. the address of the entry's component,
+	a row index or a model's node). Entries with equal labels are found in the order given by
+	setEntryOrder() (e.g. their position in the list), not in the order of their ids.	*/
+class TypeAheadIndex{
+	public:
+		typedef uintptr_t id_t;
+		//! Returns whether the first entry is in front of the second one in the view.
+		typedef std::function<bool (id_t,id_t)> entryOrder_t;
+		GUIAPI TypeAheadIndex();
+
+		//! @name Index
+		//	@{
+		//! Add the entry or change its label; an entry with an empty label is removed. Returns whether the index has changed.
+		GUIAPI bool set(id_t id,const std::string & label);
+		GUIAPI bool remove(id_t id);
+		GUIAPI void clear();
+		bool contains(id_t id)const							{	return keys.count(id)>0;	}
+		size_t size()const									{	return keys.size();	}
+		bool empty()const									{	return keys.empty();	}
+		/*! Set the order of entries with equal labels (by default, the order of the ids, which is the
+			position if the ids are row indices). It is only evaluated for entries with equal labels.	*/
+		void setEntryOrder(entryOrder_t isBefore)			{	entryOrder = std::move(isBefore);	}
+		/*! Find the first entry (in the order of the labels) whose label begins with @p prefix.
+			\note @p prefix has to be normalized (see normalize()).	*/
+		GUIAPI bool find(const std::string & prefix,id_t & result)const;
+		/*! Find the entry following @p current (in the order of the labels and, for equal labels,
+			in the entry order) whose label begins with @p prefix; behind the last matching entry,
+			the search continues with the first one.	*/
+		GUIAPI bool findNext(const std::string & prefix,id_t current,id_t & result)const;
+		//! Return whether the indexed label of @p id begins with @p prefix.
+		GUIAPI bool matches(id_t id,const std::string & prefix)const;
+		//	@}
+
+		// ------------------
+
+		//! @name Input
+		//	@{
+		/*! Append the character of a key event to the prefix (the prefix is reset before, if the last
+			input is older than the timeout). Returns false if the event does not contain a printable character.	*/
+		GUIAPI bool appendInput(const Util::UI::KeyboardEvent & keyEvent,double time);
+		const std::string & getPrefix()const				{	return prefix;	}
+		void resetPrefix()									{	prefix.clear();	}
+		double getTimeout()const							{	return timeout;	}
+		void setTimeout(double seconds)						{	timeout = seconds;	}
+
+		/*! Search the entry for the current prefix. If the prefix consists of a single repeated character
+			(e.g. "a" or "aaa"), the entries beginning with this character are cycled starting behind @p current
+			(pass hasCurrent=false if there is no current entry); otherwise, the first matching entry is returned.	*/
+		GUIAPI bool search(bool hasCurrent,id_t current,id_t & result)const;
+		//	@}
+
+		// ------------------
+
+		//! @name Labels
+		//	@{
+		//! The lower case (ASCII) version of @p label used as key.
+		GUIAPI static std::string normalize(const std::string & label);
+		//! The text of the first Label (in depth first order) in the subtree of @p c (or "" if there is none).
+		GUIAPI static std::string findLabel(Component * c);
+		//! Returns whether @p a is in front of @p b in the depth first order of the components (an entry order).
+		GUIAPI static bool isBeforeInTree(const Component * a,const Component * b);
+		//	@}
+
+	private:
+		typedef std::set<std::pair<std::string,id_t>> keySet_t;
+		//! (internal) Returns whether @p it is a valid position whose key begins with @p p.
+		bool isMatch(const keySet_t::const_iterator & it,const std::string & p)const;
+		//! (internal) Returns whether the entry @p a is in front of the entry @p b.
+		bool isBefore(id_t a,id_t b)const					{	return entryOrder ? entryOrder(a,b) : a<b;	}
+		//! (internal) Return the end of the range of entries having the label of @p it.
+		keySet_t::const_iterator getLabelEnd(const keySet_t::const_iterator & it)const;
+		keySet_t sortedKeys;
+		entryOrder_t entryOrder;
+		std::unordered_map<id_t,std::string> keys;
+		std::string prefix;
+		double lastInputTime;
+		double timeout;
+};
+
+}
+#endif // GUI_TYPE_AHEAD_INDEX_H
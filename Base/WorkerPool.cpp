@@ -0,0 +1,88 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "WorkerPool.h"
+
+namespace GUI{
+
+//! (ctor)
+WorkerPool::WorkerPool(size_t threadCount) :
+		batch(nullptr),nextTask(0),unfinishedTasks(0),batchNumber(0),shutdown(false) {
+	for(size_t i=1;i<threadCount;++i)
+		workers.emplace_back(&WorkerPool::workerMain,this);
+}
+
+//! (dtor)
+WorkerPool::~WorkerPool(){
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		shutdown = true;
+	}
+	batchAvailable.notify_all();
+	for(auto & worker : workers)
+		worker.join();
+}
+
+//! (internal)
+void WorkerPool::work(std::unique_lock<std::mutex> & lock){
+	while(batch!=nullptr && nextTask<batch->size()){
+		task_t & task = (*batch)[nextTask++];
+		lock.unlock();
+		std::exception_ptr exception;
+		try{
+			task();
+		}catch(...){
+			exception = std::current_exception();
+		}
+		lock.lock();
+		if(exception && !firstException)
+			firstException = exception;
+		if(--unfinishedTasks==0)
+			batchFinished.notify_all();
+	}
+}
+
+//! (internal)
+void WorkerPool::workerMain(){
+	std::unique_lock<std::mutex> lock(mutex);
+	uint64_t lastBatch = 0;
+	while(true){
+		batchAvailable.wait(lock,[&](){	return shutdown || (batch!=nullptr && batchNumber!=lastBatch);	});
+		if(shutdown)
+			return;
+		lastBatch = batchNumber;
+		work(lock);
+	}
+}
+
+void WorkerPool::run(std::vector<task_t> & tasks){
+	if(tasks.empty())
+		return;
+	std::unique_lock<std::mutex> lock(mutex);
+	batch = &tasks;
+	nextTask = 0;
+	unfinishedTasks = tasks.size();
+	++batchNumber;
+	firstException = nullptr;
+	if(!workers.empty() && tasks.size()>1)
+		batchAvailable.notify_all();
+
+	work(lock);
+	batchFinished.wait(lock,[&](){	return unfinishedTasks==0;	});
+	batch = nullptr;
+
+	std::exception_ptr exception;
+	std::swap(exception,firstException);
+	lock.unlock();
+	if(exception)
+		std::rethrow_exception(exception);
+}
+
+}
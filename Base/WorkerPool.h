@@ -0,0 +1,66 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2012 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_WORKER_POOL_H
+#define GUI_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GUI{
+
+/*! Fixed set of threads executing batches of independent tasks (used for the parallel layout).
+	The calling thread takes part in the execution, so a pool for n threads starts n-1 additional threads.	*/
+class WorkerPool{
+	public:
+		typedef std::function<void ()> task_t;
+
+		//! @p threadCount includes the calling thread; a value <= 1 creates no threads (all tasks are executed by the caller).
+		GUIAPI explicit WorkerPool(size_t threadCount);
+		GUIAPI ~WorkerPool();
+
+		size_t getThreadCount()const						{	return workers.size()+1;	}
+
+		/*! Execute all tasks and return when all of them are finished. The tasks are taken in their order,
+			but may be executed concurrently. If a task throws, the remaining tasks are still executed and
+			the first exception is rethrown afterwards.
+			\note Must not be called concurrently or from within a task.	*/
+		GUIAPI void run(std::vector<task_t> & tasks);
+
+	private:
+		WorkerPool(const WorkerPool &) = delete;
+		WorkerPool & operator=(const WorkerPool &) = delete;
+
+		//! (internal) Execute tasks of the current batch until none is left.
+		void work(std::unique_lock<std::mutex> & lock);
+		void workerMain();
+
+		std::vector<std::thread> workers;
+		std::mutex mutex;
+		std::condition_variable batchAvailable;
+		std::condition_variable batchFinished;
+
+		// state of the current batch (protected by mutex)
+		std::vector<task_t> * batch;
+		size_t nextTask;
+		size_t unfinishedTasks;
+		uint64_t batchNumber;
+		std::exception_ptr firstException;
+		bool shutdown;
+};
+
+}
+#endif // GUI_WORKER_POOL_H
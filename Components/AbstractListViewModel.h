@@ -0,0 +1,44 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_ABSTRACT_LIST_VIEW_MODEL_H
+#define GUI_ABSTRACT_LIST_VIEW_MODEL_H
+
+#include "Component.h"
+#include <Util/ReferenceCounter.h>
+#include <Util/TypeNameMacro.h>
+#include <cstddef>
+#include <string>
+namespace GUI{
+
+class GUI_Manager;
+
+/*! Source of the rows of a ListView in model mode (see ListView::setModel()).
+	The ListView only keeps components for the visible rows. When a row scrolls out of view, its component
+	is reused for another row; so a row component must not store state that is not set by updateRow().
+	If the model's data changes, inform the ListView via ListView::modelChanged() or ListView::rowsChanged().	*/
+class AbstractListViewModel : public Util::ReferenceCounter<AbstractListViewModel> {
+		PROVIDES_TYPE_NAME(AbstractListViewModel)
+
+	public:
+		virtual ~AbstractListViewModel() {}
+
+		virtual size_t getRowCount()const = 0;
+		//! Create a new (empty) row component; called only if there is no row component to reuse.
+		virtual Component::Ref createRow(GUI_Manager & gui) = 0;
+		//! Show the contents of row @p index in the (new or reused) row component @p row.
+		virtual void updateRow(Component & row,size_t index) = 0;
+		//! ---o Text of row @p index used by the type-ahead search of the ListView; rows without text are not found.
+		virtual std::string getRowText(size_t /*index*/)const	{	return "";	}
+};
+
+}
+
+#endif // GUI_ABSTRACT_LIST_VIEW_MODEL_H
@@ -0,0 +1,40 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_ABSTRACT_TABLE_CELL_RENDERER_H
+#define GUI_ABSTRACT_TABLE_CELL_RENDERER_H
+
+#include "AbstractTableModel.h"
+#include <Geometry/Rect.h>
+#include <Util/ReferenceCounter.h>
+#include <Util/TypeNameMacro.h>
+#include <cstddef>
+
+namespace GUI{
+
+class GUI_Manager;
+
+/*! Draws the cells of a Table's column directly with the functions of Draw (there are no components for the cells).
+	If no renderer is set for a column, the cell's text is drawn.	*/
+class AbstractTableCellRenderer : public Util::ReferenceCounter<AbstractTableCellRenderer> {
+		PROVIDES_TYPE_NAME(AbstractTableCellRenderer)
+
+	public:
+		virtual ~AbstractTableCellRenderer() {}
+
+		/*! Draw the cell (@p row is the model's row index) into @p rect (in the table's local coordinates).
+			The table's style (e.g. PROPERTY_DEFAULT_FONT) is active while the cells are drawn.	*/
+		virtual void displayCell(GUI_Manager & gui,const AbstractTableModel & model,size_t row,size_t column,
+									const Geometry::Rect & rect,bool marked) = 0;
+};
+
+}
+
+#endif // GUI_ABSTRACT_TABLE_CELL_RENDERER_H
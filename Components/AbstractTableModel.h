@@ -0,0 +1,50 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_ABSTRACT_TABLE_MODEL_H
+#define GUI_ABSTRACT_TABLE_MODEL_H
+
+#include <Util/ReferenceCounter.h>
+#include <Util/TypeNameMacro.h>
+#include <cstddef>
+#include <string>
+
+namespace GUI{
+
+/*! Source of the cells of a Table. The table only requests the cells in view; so the model may compute
+	its cells on demand. Rows and columns are addressed by the model's indices (independent of the sorting of the table).
+	If the model's data changes, inform the Table via Table::modelChanged().	*/
+class AbstractTableModel : public Util::ReferenceCounter<AbstractTableModel> {
+		PROVIDES_TYPE_NAME(AbstractTableModel)
+
+	public:
+		virtual ~AbstractTableModel() {}
+
+		virtual size_t getRowCount()const = 0;
+		virtual size_t getColumnCount()const = 0;
+		virtual std::string getColumnTitle(size_t column)const = 0;
+		virtual std::string getCellText(size_t row,size_t column)const = 0;
+
+		/*! ---o
+			Used for sorting the table by a column; the default implementation compares the cells' texts.
+			Should be overridden for large tables or numerical data.	*/
+		virtual bool isLess(size_t row1,size_t row2,size_t column)const	{	return getCellText(row1,column)<getCellText(row2,column);	}
+
+		// ---o
+		virtual bool isCellEditable(size_t /*row*/,size_t /*column*/)const	{	return false;	}
+		/*! ---o
+			Called when the in-place editor of an editable cell is closed with a changed text.
+			Returns false if the text is not accepted.	*/
+		virtual bool setCellText(size_t /*row*/,size_t /*column*/,const std::string & /*text*/)	{	return false;	}
+};
+
+}
+
+#endif // GUI_ABSTRACT_TABLE_MODEL_H
@@ -0,0 +1,54 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_ABSTRACT_TREE_VIEW_MODEL_H
+#define GUI_ABSTRACT_TREE_VIEW_MODEL_H
+
+#include "Component.h"
+#include <Util/ReferenceCounter.h>
+#include <Util/TypeNameMacro.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+namespace GUI{
+
+class GUI_Manager;
+
+/*! Source of the nodes of a TreeView in model mode (see TreeView::setModel()).
+	The children of a node are only requested when the node is opened. As in the AbstractListViewModel,
+	the TreeView only keeps components for the visible rows and reuses them for other nodes while scrolling.
+	If the model's structure changes, inform the TreeView via TreeView::modelChanged().	*/
+class AbstractTreeViewModel : public Util::ReferenceCounter<AbstractTreeViewModel> {
+		PROVIDES_TYPE_NAME(AbstractTreeViewModel)
+
+	public:
+		//! Identifies a node; the meaning is up to the model (e.g. an index or a pointer value).
+		typedef uintptr_t node_t;
+
+		virtual ~AbstractTreeViewModel() {}
+
+		//! The (invisible) root node; its children are the top-level rows.
+		virtual node_t getRoot()const = 0;
+		//! Returns true if the node can be opened; should be answered without loading the node's children.
+		virtual bool hasChildren(node_t node) = 0;
+		virtual size_t getChildCount(node_t node) = 0;
+		virtual node_t getChild(node_t node,size_t index) = 0;
+
+		//! Create a new (empty) row component; called only if there is no row component to reuse.
+		virtual Component::Ref createRow(GUI_Manager & gui) = 0;
+		//! Show @p node in the (new or reused) row component @p row; top-level nodes have the depth 0.
+		virtual void updateRow(Component & row,node_t node,size_t depth) = 0;
+		//! ---o Text of the node used by the type-ahead search of the TreeView; nodes without text are not found.
+		virtual std::string getNodeText(node_t /*node*/)const	{	return "";	}
+};
+
+}
+
+#endif // GUI_ABSTRACT_TREE_VIEW_MODEL_H
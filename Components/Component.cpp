@@ -14,6 +14,8 @@
 #include "../Base/ListenerHelper.h"
 #include "../Base/Draw.h"
 #include "../Base/Layouters/ExtLayouter.h"
+#include "../Base/StyleManager.h"
+#include "../Base/WorkerPool.h"
 #include "ComponentTooltipFeature.h"
 #include "../GUI_Manager.h"
 #include "Container.h"
@@ -25,12 +27,12 @@ namespace GUI{
 
 //! (ctor)
 Component::Component(GUI_Manager & _gui,flag_t _flags/*=0*/)
-		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),prev(nullptr),next(nullptr),flags(_flags) { 
+		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),kinds(KIND),indexInParent(0),flags(_flags) { 
 }
 
 //! (ctor)
 Component::Component(GUI_Manager & _gui,const Geometry::Rect & _relRect,flag_t _flags/*=0*/)
-		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),prev(nullptr),next(nullptr),flags(_flags) {
+		: Util::AttributeProvider(), Util::ReferenceCounter<Component>(), gui(_gui),kinds(KIND),indexInParent(0),flags(_flags) {
 	setRect(_relRect);
 	//ctor
 }
@@ -65,25 +67,12 @@ void Component::destroy(Component * component){
 	}
 }
 
-//! (internal)
-void Component::_updateNeighbors(const Ref & newPrev,const Ref & newNext){
-	const Ref oldPrev=getPrev();
-	const Ref oldNext=getNext();
-
-	setPrev(newPrev);
-	setNext(newNext);
-
-	if(newPrev.isNotNull())
-		newPrev->setNext(this);
-
-	if(newNext.isNotNull())
-		newNext->setPrev(this);
-
-	if(oldPrev.isNotNull())
-		oldPrev->setNext(oldNext);
+Component * Component::getNext()const{
+	return hasParent() ? getParent()->getChild(indexInParent+1) : nullptr;
+}
 
-	if(oldNext.isNotNull())
-		oldNext->setPrev(oldPrev);
+Component * Component::getPrev()const{
+	return (hasParent() && indexInParent>0) ? getParent()->getChild(indexInParent-1) : nullptr;
 }
 
 Geometry::Vec2 Component::getAbsPosition() {
@@ -162,8 +151,7 @@ void Component::setRect(const Geometry::Rect & newRect) {
 		//	traverseChildren(visitor); // this is not enough for certain nested layouts
 		invalidateSubtreeLayout();
 
-		if(hasParent())
-			parent->childRectChanged(this);
+		informParentOfRectChange();
 		invalidateLayout();
 		invalidateRegion(); // invalidate new rect
 	}else if(Geometry::Vec2i( oldRect.getPosition()) != Geometry::Vec2i(newRect.getPosition())){
@@ -171,20 +159,39 @@ void Component::setRect(const Geometry::Rect & newRect) {
 		relRect = newRect;
 
 		invalidateAbsPosition();
-		if(hasParent())
-			parent->childRectChanged(this);
+		informParentOfRectChange();
 		invalidateRegion(); // invalidate new rect
 	}
 }
 
+void Component::_setHeightKeepingSubtreeLayout(float f) {
+	if(static_cast<int>(f) == static_cast<int>(relRect.getHeight()))
+		return;
+	invalidateRegion(); // invalidate old rect
+	relRect.setHeight(f);
+	informParentOfRectChange();
+	invalidateRegion(); // invalidate new rect
+}
+//! (internal)
+void Component::enableDisplayProperties() {
+	StyleManager & styleManager = getGUI().getStyleManager();
+	styleManager.updateResolvedStyle(resolvedStyle,styleManager.getActiveStyle(),recursiveDisplayProperties);
+	styleManager.pushStyle(resolvedStyle.get());
+}
+
+//! (internal)
+void Component::disableDisplayProperties() {
+	getGUI().getStyleManager().popStyle();
+}
+
 void Component::enableLocalDisplayProperties() {
-	for(auto& p: localDisplayProperties)
-		getGUI().enableProperty( p );
+	StyleManager & styleManager = getGUI().getStyleManager();
+	styleManager.updateResolvedStyle(resolvedLocalStyle,styleManager.getActiveStyle(),localDisplayProperties);
+	styleManager.pushStyle(resolvedLocalStyle.get());
 }
 
 void Component::disableLocalDisplayProperties() {
-	for(auto it=localDisplayProperties.rbegin(); it!=localDisplayProperties.rend(); ++it)
-		getGUI().disableProperty(*it);
+	getGUI().getStyleManager().popStyle();
 }
 
 void Component::displayDefaultShapes() {
@@ -203,9 +210,7 @@ void Component::displayDefaultShapes() {
 }
 	
 void Component::display(const Geometry::Rect & region) {
-	// enable display properties
-	for(auto& p: recursiveDisplayProperties)
-		getGUI().enableProperty( p );
+	enableDisplayProperties();
 
 	// displayBegin();
 	Draw::moveCursor(getPosition());
@@ -221,9 +226,7 @@ void Component::display(const Geometry::Rect & region) {
 	if( flags&USE_SCISSOR){
 		getGUI().popScissor();
 	}
-	// disable display properties
-	for(auto it=recursiveDisplayProperties.rbegin();it!=recursiveDisplayProperties.rend();++it)
-		getGUI().disableProperty(*it);
+	disableDisplayProperties();
 }
 
 //! ---o
@@ -250,6 +253,33 @@ bool Component::onUnselect() {
 	return true;
 }
 
+Component::ListenerRegistries & Component::_accessListeners(listenerKind_t kind)const{
+	if(!listeners.registries)
+		listeners.registries.reset(new ListenerRegistries);
+	listeners.kinds |= kind;
+	return *listeners.registries;
+}
+
+void Component::_updateListenerKinds()const{
+	const ListenerRegistries * registries = listeners.registries.get();
+	if(registries==nullptr)
+		return;
+	listenerKind_t k = 0;
+	if(!registries->componentDestruction.empty())
+		k |= LISTENER_COMPONENT_DESTRUCTION;
+	if(!registries->dataChange.empty())
+		k |= LISTENER_DATA_CHANGE;
+	if(!registries->key.empty())
+		k |= LISTENER_KEY;
+	if(!registries->mouseButton.empty())
+		k |= LISTENER_MOUSE_BUTTON;
+	if(!registries->mouseClick.empty())
+		k |= LISTENER_MOUSE_CLICK;
+	listeners.kinds = k;
+	if(k==0)
+		listeners.registries.reset();
+}
+
 void Component::select() {
 	if (isSelected()) {
 		if (hasParent())
@@ -289,11 +319,13 @@ void Component::unselectSubtree() {
 }
 
 void Component::invalidateRegion(){
+	for(Component * c = this;c!=nullptr;c=c->getParent())
+		if(!c->isEnabled())
+			return;
 	if(getGUI().isLazyRenderingEnabled()){
-		for(Component * c = this;c!=nullptr;c=c->getParent())
-			if(!c->isEnabled())
-				return;
 		getGUI().invalidateRegion(getAbsRect());
+	}else{
+		getGUI().requestRedraw();
 	}
 }
 
@@ -390,9 +422,7 @@ void Component::removeTooltip()						{	removeComponentTooltip(*this);	}
 // ---- Layout
 
 uint32_t Component::layout(){
-		// enable display properties
-	for(auto & prop : recursiveDisplayProperties)
-		getGUI().enableProperty(prop);
+	enableDisplayProperties();
 		
 	const bool wasValid = getFlag(LAYOUT_VALID);
 	setFlag(LAYOUT_VALID,true);
@@ -426,20 +456,47 @@ uint32_t Component::layout(){
 //		}
 		++count;
 	}
-	// disable display properties
-	for(auto & prop : recursiveDisplayProperties)
-		getGUI().disableProperty(prop);	
+	disableDisplayProperties();
 	return count;
 }
 
 
+/*! (internal) Set while a thread layouts a subtree in parallel to its siblings. The invalidations of the
+	common parent are recorded here and applied after all subtrees are finished.	*/
+struct LayoutBoundary{
+	const Container * parent;
+	bool subtreeLayoutInvalidated;
+	bool childRectChanged;
+	explicit LayoutBoundary(const Container * p) : parent(p),subtreeLayoutInvalidated(false),childRectChanged(false) {}
+};
+static thread_local LayoutBoundary * layoutBoundary = nullptr;
+
 void Component::invalidateLayout(){
 	setFlag(LAYOUT_VALID,false);
-	for(Container * c=getParent();c!=nullptr && c->getFlag(SUBTREE_LAYOUT_VALID) ;c=c->getParent()){
+	LayoutBoundary * const boundary = layoutBoundary;
+	for(Container * c=getParent();c!=nullptr;c=c->getParent()){
+		if(boundary!=nullptr && c==boundary->parent){
+			boundary->subtreeLayoutInvalidated = true;
+			break;
+		}
+		if(!c->getFlag(SUBTREE_LAYOUT_VALID))
+			break;
 		c->setFlag(SUBTREE_LAYOUT_VALID,false);
 	}
 }
 
+//! (internal)
+void Component::informParentOfRectChange(){
+	if(!hasParent())
+		return;
+	LayoutBoundary * const boundary = layoutBoundary;
+	if(boundary!=nullptr && getParent()==boundary->parent){
+		boundary->childRectChanged = true;
+	}else{
+		parent->childRectChanged(this);
+	}
+}
+
 void Component::invalidateSubtreeLayout(){
 	struct MyVisitor:public Component::Visitor {
 		// ---|> Component::Visitor
@@ -454,20 +511,103 @@ void Component::invalidateSubtreeLayout(){
 }
 
 uint32_t Component::layoutChildren(){
+	uint32_t count = 0;
+	bool independentChildrenDone = false;
+	if(getGUI().getLayoutThreadCount()>1 && !getGUI().isParallelLayoutRunning()){
+		struct CollectVisitor:public Component::Visitor {
+			std::vector<Component*> children;
+			// ---|> Component::Visitor
+			visitorResult_t visit(Component & c) override {
+				if( c.isEnabled() && c.getFlag(INDEPENDENT_LAYOUT) &&
+						(!c.getFlag(LAYOUT_VALID) || !c.getFlag(SUBTREE_LAYOUT_VALID)) ){
+					children.push_back(&c);
+				}
+				return Component::CONTINUE_TRAVERSAL;
+			}
+		}collector;
+		traverseChildren(collector);
+		if(collector.children.size()>1){
+			WorkerPool * pool = getGUI()._beginParallelLayout();
+			if(pool!=nullptr){
+				try{
+					count += layoutChildrenInParallel(*pool,collector.children);
+				}catch(...){
+					getGUI()._endParallelLayout();
+					throw;
+				}
+				getGUI()._endParallelLayout();
+				independentChildrenDone = true;
+			}
+		}
+	}
+
 	struct MyVisitor:public Component::Visitor {
 		uint32_t count;
-		MyVisitor():Visitor(),count(0){}
+		bool skipIndependentChildren;
+		MyVisitor(bool skip):Visitor(),count(0),skipIndependentChildren(skip){}
 		
 		// ---|> Component::Visitor
 		visitorResult_t visit(Component & c) override {
-			if( c.isEnabled() ){
+			if( c.isEnabled() && !(skipIndependentChildren && c.getFlag(INDEPENDENT_LAYOUT)) ){
 				count += c.layout();
 			}
 			return Component::CONTINUE_TRAVERSAL;
 		}
-	}visitor;
+	}visitor(independentChildrenDone);
 	traverseChildren(visitor);
-	return visitor.count;
+	return count + visitor.count;
+}
+
+//! (internal)
+uint32_t Component::layoutChildrenInParallel(WorkerPool & pool,const std::vector<Component*> & independentChildren){
+	struct Result{
+		uint32_t count;
+		bool subtreeLayoutInvalidated;
+		bool childRectChanged;
+		Result() : count(0),subtreeLayoutInvalidated(false),childRectChanged(false) {}
+	};
+	std::vector<Result> results(independentChildren.size());
+
+	// the absolute positions outside of the subtrees must not be updated by the threads.
+	getAbsPosition();
+
+	StyleManager & styleManager = getGUI().getStyleManager();
+	ResolvedStyle * const parentStyle = styleManager.getActiveStyle();
+	std::vector<WorkerPool::task_t> tasks;
+	tasks.reserve(independentChildren.size());
+	for(size_t i = 0; i<independentChildren.size(); ++i){
+		tasks.emplace_back([&,i](){
+			Component * child = independentChildren[i];
+			StyleManager::ThreadStyleStack styleStack(styleManager,parentStyle);
+			LayoutBoundary boundary(child->getParent());
+			LayoutBoundary * const outerBoundary = layoutBoundary;
+			layoutBoundary = &boundary;
+			try{
+				results[i].count = child->layout();
+			}catch(...){
+				layoutBoundary = outerBoundary;
+				throw;
+			}
+			layoutBoundary = outerBoundary;
+			results[i].subtreeLayoutInvalidated = boundary.subtreeLayoutInvalidated;
+			results[i].childRectChanged = boundary.childRectChanged;
+		});
+	}
+	pool.run(tasks);
+
+	// apply the recorded changes of the parent in the children's order.
+	uint32_t count = 0;
+	for(size_t i = 0; i<independentChildren.size(); ++i){
+		Component * child = independentChildren[i];
+		count += results[i].count;
+		if(results[i].childRectChanged)
+			child->informParentOfRectChange();
+		if(results[i].subtreeLayoutInvalidated){
+			for(Container * c=child->getParent();c!=nullptr && c->getFlag(SUBTREE_LAYOUT_VALID);c=c->getParent())
+				c->setFlag(SUBTREE_LAYOUT_VALID,false);
+		}
+	}
+	return count;
 }
 
 void Component::removeLayouter(Util::WeakPointer<AbstractLayouter> layouter){
@@ -480,13 +620,17 @@ void Component::removeLayouter(Util::WeakPointer<AbstractLayouter> layouter){
 // ---- Properties
 void Component::removeProperty(DisplayProperty * p){
 	auto pos = std::find(recursiveDisplayProperties.begin(),recursiveDisplayProperties.end(),p);
-	if(pos!=recursiveDisplayProperties.end())
+	if(pos!=recursiveDisplayProperties.end()){
 		recursiveDisplayProperties.erase(pos);
+		resolvedStyle = nullptr;
+	}
 }
 void Component::removeLocalProperty(DisplayProperty * p){
 	auto pos = std::find(localDisplayProperties.begin(),localDisplayProperties.end(),p);
-	if(pos!=localDisplayProperties.end())
+	if(pos!=localDisplayProperties.end()){
 		localDisplayProperties.erase(pos);
+		resolvedLocalStyle = nullptr;
+	}
 }
 
 // ---------------------------------------
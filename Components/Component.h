@@ -13,6 +13,9 @@
 
 #include "../Base/Layouters/AbstractLayouter.h"
 #include "../Base/AbstractProperty.h"
+#include "../Base/Listener.h"
+#include "../Base/StyleManager.h"
+#include "../Base/PoolAllocator.h"
 
 #include <Geometry/Rect.h>
 #include <Geometry/Vec2.h>
@@ -24,7 +27,9 @@
 #include <Util/GenericAttribute.h>
 #include <Util/AttributeProvider.h>
 
+#include <memory>
 #include <string>
+#include <type_traits>
 
 // Geometry
 
@@ -32,6 +37,7 @@ namespace GUI {
 
 class Container;
 class GUI_Manager;
+class WorkerPool;
 
 /***
  **  Component
@@ -51,6 +57,10 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		GUIAPI Component(GUI_Manager & gui,const Geometry::Rect & relRect,flag_t flags=0);
 		GUIAPI virtual ~Component();
 
+		//! Components are allocated from the PoolAllocator.
+		static void * operator new(size_t size)				{	return PoolAllocator::getDefault().allocate(size);	}
+		static void operator delete(void * p,size_t size)	{	PoolAllocator::getDefault().deallocate(p,size);	}
+
 		GUI_Manager & getGUI() const {
 			return gui;
 		}
@@ -63,25 +73,54 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 
 	// -----------------------------------
 
+	/*!	@name Type identification
+		Lightweight alternative to dynamic_cast for frequently executed code (e.g. traversals of the whole tree).
+		Each identifiable class defines its own KIND (containing the kinds of its base classes) together with
+		a typedef 'kindClass_t' naming the class itself, and adds the KIND in its constructors.
+		Use GUI::isA<T>(component) and GUI::castTo<T>(component) for testing and casting; they only accept
+		classes declaring their own KIND.	*/
+	// @{
+	public:
+		typedef uint32_t kind_t;
+		static const kind_t KIND=0;
+		typedef Component kindClass_t;
+		static const kind_t KIND_CONTAINER=1<<0;
+		static const kind_t KIND_MENU=1<<1;
+		static const kind_t KIND_CONNECTOR=1<<2;
+		static const kind_t KIND_NEXT_ROW=1<<3;
+		static const kind_t KIND_NEXT_COLUMN=1<<4;
+		static const kind_t KIND_TREE_VIEW_ENTRY=1<<5;
+		static const kind_t KIND_TABBED_PANEL=1<<6;
+		static const kind_t KIND_TAB=1<<7;
+		static const kind_t KIND_TAB_TITLE_PANEL=1<<8;
+		static const kind_t KIND_LABEL=1<<9;
+		kind_t getKinds()const				{	return kinds;	}
+		bool hasKind(kind_t k)const			{	return (kinds&k)==k;	}
+	protected:
+		void addKind(kind_t k)				{	kinds|=k;	}
+	private:
+		kind_t kinds;
+	// @}
+
+	// -----------------------------------
+
 	/*!	@name Tree management	*/
 	// @{
 	private:
 		Util::WeakPointer<Container> parent;
-		Ref prev;
-		Ref next;
-	protected:
-		void setNext(const Ref & newNext)	{	next=newNext;	}
-		void setPrev(const Ref & newPrev)	{	prev=newPrev;	}
+		size_t indexInParent; //!< position in the parent's children array (maintained by the parent)
 
 	public:
 		void _setParent(const Util::WeakPointer<Container> & c) 	{	parent = c;	invalidateLayout(); };
-		GUIAPI void _updateNeighbors(const Ref & newPrev,const Ref & newNext);
+		void _setIndexInParent(size_t i)							{	indexInParent = i;	}
 
 		GUIAPI void bringToFront();
 
 		Container * getParent()const		{	return parent.get();	}
-		Component * getNext()const			{	return next.get();	}
-		Component * getPrev()const			{	return prev.get();	}
+		//! Position of the component in its parent's children (only valid if the component has a parent).
+		size_t getIndexInParent()const		{	return indexInParent;	}
+		GUIAPI Component * getNext()const;
+		GUIAPI Component * getPrev()const;
 		bool hasParent()const				{	return !parent.isNull();	}
 	// @}
 
@@ -108,6 +147,10 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		static const flag_t ALWAYS_ON_TOP=1<<12; //!< Used to mark (top-level) components which should never be behind non ALWAYS_ON_TOP components
 		static const flag_t LOCKED=1<<13; //!< Input components are read only.
 		static const flag_t HAS_MOUSECURSOR_PROPERTY=1<<14;
+		/*! The layout of the component's subtree depends only on the parent's size and changes nothing outside of
+			the subtree (except for the component's own rect); such siblings may be layouted in parallel
+			(see GUI_Manager::setLayoutThreadCount). Suitable e.g. for top-level windows and pages.	*/
+		static const flag_t INDEPENDENT_LAYOUT=1<<15;
 		// status
 		static const flag_t DESTROYED=1<<19;
 		static const flag_t ABS_POSITION_VALID=1<<20;
@@ -142,13 +185,13 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 	/*!	@name Layout	*/
 	// @{
 	private:
-		std::vector<Util::Reference<AbstractLayouter>> layouters;
+		std::vector<Util::Reference<AbstractLayouter>,PoolAllocatorAdapter<Util::Reference<AbstractLayouter>>> layouters;
 	public:
 		void addLayouter(Util::Reference<AbstractLayouter> layouter)	{	layouters.push_back(layouter);	}
 		void clearLayouters()											{	layouters.clear();	}
 
 		virtual void doLayout()											{	}
-		std::vector<Util::Reference<AbstractLayouter>> getLayouters()const	{	return layouters;	}
+		std::vector<Util::Reference<AbstractLayouter>> getLayouters()const	{	return std::vector<Util::Reference<AbstractLayouter>>(layouters.begin(),layouters.end());	}
 		
 		template<class Layouter_t> 
 		Layouter_t * getLayouter()const{
@@ -168,7 +211,15 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 
 		/*! The size of the component is set correctly (if necessary) and all children are layouted recursivly. */
 		GUIAPI uint32_t layout();
+		/*! If the parallel layout is enabled, the children marked with INDEPENDENT_LAYOUT are layouted in parallel
+			first; then the other children are layouted in their order. */
 		GUIAPI uint32_t layoutChildren();
+	private:
+		//! (internal) Layout the given children in parallel; returns the number of layouted components.
+		uint32_t layoutChildrenInParallel(WorkerPool & pool,const std::vector<Component*> & independentChildren);
+		//! (internal) Call childRectChanged() of the parent (deferred if the parent is outside of a subtree layouted in parallel).
+		void informParentOfRectChange();
+	public:
 		
 		GUIAPI void removeLayouter(Util::WeakPointer<AbstractLayouter> layouter);
 		
@@ -189,19 +240,27 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 	/*!	@name Display properties	*/
 	// @{
 	public:
-		typedef std::vector<Util::Reference<DisplayProperty> > properties_t;
-		void addProperty(DisplayProperty * p)									{	recursiveDisplayProperties.push_back(p);	}
+		typedef displayPropertyList_t properties_t;
+		void addProperty(DisplayProperty * p)									{	recursiveDisplayProperties.push_back(p);	resolvedStyle = nullptr;	}
 		GUIAPI void removeProperty(DisplayProperty * p);
-		void clearProperties()													{	recursiveDisplayProperties.clear(); }
+		void clearProperties()													{	recursiveDisplayProperties.clear();	resolvedStyle = nullptr;	}
 		const properties_t & getProperties()const								{	return recursiveDisplayProperties;	}
-		void addLocalProperty(DisplayProperty * p)								{	localDisplayProperties.push_back(p);	}
+		void addLocalProperty(DisplayProperty * p)								{	localDisplayProperties.push_back(p);	resolvedLocalStyle = nullptr;	}
 		GUIAPI void removeLocalProperty(DisplayProperty * p);
-		void clearLocalProperties()												{	localDisplayProperties.clear(); }
+		void clearLocalProperties()												{	localDisplayProperties.clear();	resolvedLocalStyle = nullptr;	}
 		const properties_t & getLocalProperties()const							{	return localDisplayProperties;	}
 
 	private:
 		properties_t recursiveDisplayProperties;
 		properties_t localDisplayProperties;
+
+		//! Cached styles resulting from the properties; see StyleManager::updateResolvedStyle(...)
+		Util::Reference<ResolvedStyle> resolvedStyle;
+		Util::Reference<ResolvedStyle> resolvedLocalStyle;
+
+		//! (internal) Activate the resolved style of this component (containing all recursive properties).
+		GUIAPI void enableDisplayProperties();
+		GUIAPI void disableDisplayProperties();
 	// @}
 
 	// -----------------------------------
@@ -267,6 +326,10 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 		void setHeight(float f)								{	setRect(relRect.getPosition(),Geometry::Vec2(getWidth(),f));	}
 		void setWidth(float f)								{	setRect(relRect.getPosition(),Geometry::Vec2(f,getHeight()));	}
 
+		/*! (internal) Like setHeight(), but the layout of the subtree is not invalidated (only the parent is informed).
+			May only be used by components whose children's layout does not depend on the component's height.	*/
+		GUIAPI void _setHeightKeepingSubtreeLayout(float f);
+
 	// @}
 
 	// -----------------------------------
@@ -299,6 +362,49 @@ class Component: public Util::AttributeProvider, public Util::ReferenceCounter<C
 
 	// -----------------------------------
 
+	/*!	@name Listener storage
+		The component specific listeners are stored at the component itself; the registries are
+		allocated on the first registration. A bit per listener kind allows to skip components without
+		listeners when dispatching events. The listeners are registered via the GUI_Manager.	*/
+	// @{
+	public:
+		typedef uint8_t listenerKind_t;
+		static const listenerKind_t LISTENER_COMPONENT_DESTRUCTION=1<<0;
+		static const listenerKind_t LISTENER_DATA_CHANGE=1<<1;
+		static const listenerKind_t LISTENER_KEY=1<<2;
+		static const listenerKind_t LISTENER_MOUSE_BUTTON=1<<3;
+		static const listenerKind_t LISTENER_MOUSE_CLICK=1<<4;
+
+		struct ListenerRegistries{
+			ComponentDestructionListenerRegistry componentDestruction;
+			DataChangeListenerRegistry dataChange;
+			KeyListenerRegistry key;
+			MouseButtonListenerRegistry mouseButton;
+			MouseClickListenerRegistry mouseClick;
+		};
+
+		bool hasListeners(listenerKind_t kind)const		{	return (listeners.kinds&kind)!=0;	}
+
+		//! (internal) Returns the registries (allocated on demand) and marks the given kind as used.
+		GUIAPI ListenerRegistries & _accessListeners(listenerKind_t kind)const;
+		//! (internal) Returns the registries or nullptr if no listener has been registered.
+		ListenerRegistries * _getListeners()const		{	return listeners.registries.get();	}
+		//! (internal) Has to be called after listeners have been removed; frees the registries if all are empty.
+		GUIAPI void _updateListenerKinds()const;
+	private:
+		//! The listeners belong to the component instance; they are not copied together with the component.
+		struct ListenerStorage{
+			std::unique_ptr<ListenerRegistries> registries;
+			listenerKind_t kinds;
+			ListenerStorage() : kinds(0) {}
+			ListenerStorage(const ListenerStorage &) : kinds(0) {}
+			ListenerStorage & operator=(const ListenerStorage &)	{	return *this;	}
+		};
+		mutable ListenerStorage listeners;
+	// @}
+
+	// -----------------------------------
+
 	/*!	@name Traversal	*/
 	// @{
 	public:
@@ -340,7 +446,20 @@ public:
 
 };
 
+//! Returns true iff the given component is not nullptr and is of type T (or a subtype of T).
+template<class T>
+bool isA(const Component * c){
+	// a class without a KIND of its own would be identified by the KIND of its base class
+	static_assert(std::is_same<typename T::kindClass_t,T>::value,"isA/castTo: T has to declare its own KIND and kindClass_t.");
+	return c!=nullptr && c->hasKind(T::KIND);
+}
+
+//! Returns the given component as T or nullptr if it is not of type T. (Replacement for dynamic_cast<T*>(c))
+template<class T>
+T * castTo(Component * c)						{	return isA<T>(c) ? static_cast<T*>(c) : nullptr;	}
 
+template<class T>
+const T * castTo(const Component * c)			{	return isA<T>(c) ? static_cast<const T*>(c) : nullptr;	}
 
 }
 
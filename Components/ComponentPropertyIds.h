@@ -32,6 +32,8 @@ static const propertyId_t PROPERTY_TAB_HEADER_PASSIVE_TEXT_COLOR 	= 8;
 static const propertyId_t PROPERTY_TEXTFIELD_TEXT_COLOR 			= 9;
 static const propertyId_t PROPERTY_TEXTFIELD_OPTIONS_TEXT_COLOR 	= 10;
 static const propertyId_t PROPERTY_WINDOW_TITLE_COLOR 				= 11;
+static const propertyId_t PROPERTY_TABLE_GRID_COLOR 				= 12;
+static const propertyId_t PROPERTY_PLOT_GRID_COLOR 					= 13;
 // ---
 // fonts
 static const propertyId_t PROPERTY_DEFAULT_FONT			 			= 1;
@@ -72,6 +74,10 @@ static const propertyId_t PROPERTY_SPLITTER_SHAPE 					= 37;
 static const propertyId_t PROPERTY_TAB_HEADER_ACTIVE_SHAPE 			= 38;
 static const propertyId_t PROPERTY_TAB_HEADER_PASSIVE_SHAPE 		= 39;
 static const propertyId_t PROPERTY_TAB_BODY_SHAPE 					= 40;
+static const propertyId_t PROPERTY_TABLE_HEADER_SHAPE 				= 41;
+static const propertyId_t PROPERTY_TABLE_MARKED_ROW_SHAPE 			= 42;
+static const propertyId_t PROPERTY_TABLE_CURSOR_SHAPE 				= 43;
+static const propertyId_t PROPERTY_PLOT_SHAPE 						= 44;
 static const propertyId_t PROPERTY_TEXTFIELD_SHAPE 					= 50;
 static const propertyId_t PROPERTY_TEXTFIELD_CLEAR_TEXT_SHAPE 		= 51;
 static const propertyId_t PROPERTY_TEXTFIELD_TEXT_SELECTION_SHAPE 	= 52;
@@ -109,6 +115,9 @@ static const propertyId_t PROPERTY_KEY_REPEAT_DELAY_1 				= 8;
 static const propertyId_t PROPERTY_KEY_REPEAT_DELAY_2 				= 9;
 static const propertyId_t PROPERTY_WINDOW_BORDER_SIZE				= 10;
 static const propertyId_t PROPERTY_WINDOW_TITLEBAR_HEIGHT			= 11;
+static const propertyId_t PROPERTY_TREEVIEW_DEFAULT_ENTRY_HEIGHT	= 12;
+static const propertyId_t PROPERTY_TABLE_DEFAULT_ROW_HEIGHT			= 13;
+static const propertyId_t PROPERTY_TABLE_DEFAULT_COLUMN_WIDTH		= 14;
 }
 
 #endif // PROPERTYIDS_H_INCLUDED
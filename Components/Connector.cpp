@@ -30,7 +30,7 @@ void Connector::findConnectors(Container * container,const Component * endpoint,
 
 		// ---|> Component::Visitor
 		visitorResult_t visit(Component & c) override {
-			Connector * connector=dynamic_cast<Connector*>(&c);
+			Connector * connector=castTo<Connector>(&c);
 			if(connector && ( connector->getFirstComponent()==endpoint || connector->getSecondComponent()==endpoint ))
 				connectors.push_back( connector );
 			return Component::CONTINUE_TRAVERSAL;
@@ -46,6 +46,7 @@ void Connector::findConnectors(Container * container,const Component * endpoint,
 //! (ctor)
 Connector::Connector(GUI_Manager & _gui,flag_t _flags/*=0*/)
 		:Container(_gui,_flags){
+	addKind(KIND);
 	if(getContentsCount()==0){
 		addConnectorPoint();
 		addConnectorPoint();
@@ -22,6 +22,9 @@ namespace GUI {
 class Connector: public Container{
 		PROVIDES_TYPE_NAME(Connector)
 	public:
+		static const kind_t KIND=Container::KIND|KIND_CONNECTOR;
+		typedef Connector kindClass_t;
+
 		/*! Find all Connectors in container which are connected the Component enpoint on one side. */
 		GUIAPI static void findConnectors(Container * container,const Component * endpoint,
 									std::list<Connector*> & connectors);
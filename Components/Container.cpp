@@ -10,131 +10,158 @@
 */
 #include "Container.h"
 #include "../GUI_Manager.h"
+#include <algorithm>
 #include <iostream>
 
 namespace GUI {
 
 //! (ctor)
 Container::Container(GUI_Manager & _gui,flag_t _flags/*=0*/) :
-		Component(_gui,_flags),contentsCount(0) {
-	//ctor
+		Component(_gui,_flags) {
+	addKind(KIND);
 }
 
 //! (ctor)
 Container::Container(GUI_Manager & _gui,const Geometry::Rect & _r,flag_t _flags/*=0*/) :
-		Component(_gui,_r,_flags),contentsCount(0) {
-	//ctor
+		Component(_gui,_r,_flags) {
+	addKind(KIND);
 }
 
 //! (dtor)
 Container::~Container() {
-	std::vector<Ref> refHolders;
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext())
-		refHolders.push_back(c);
-
-	for(const auto & refHolder : refHolders) {
+	children_t refHolders;
+	refHolders.swap(children);
+	for(const auto & refHolder : refHolders)
 		refHolder->_setParent(nullptr);
-		refHolder->_updateNeighbors(nullptr, nullptr);
-	}
-
-	firstChild = lastChild = nullptr;
-	contentsCount = 0;
 	//dtor
 }
 
-void Container::_insertAfter(const Ref & child,const Ref & after){
+//! (internal)
+void Container::eraseChild(size_t index){
+	children.erase(children.begin()+index);
+	for(size_t i=index;i<children.size();++i)
+		children[i]->_setIndexInParent(i);
+}
+
+//! (internal)
+void Container::placeChild(const Ref & child,size_t index){
+	children.insert(children.begin()+index,child);
+	for(size_t i=index;i<children.size();++i)
+		children[i]->_setIndexInParent(i);
+}
+
+void Container::_insertAfter(const Ref & _child,const Ref & _after){
+	// copy the references as they may point into the children array
+	const Ref child(_child);
+	const Ref after(_after);
 	if (child.isNull() || child==after) return;
 
 	if(child->getParent()!=this){
-		++contentsCount;
 		if(child->hasParent())
 			child->getParent()->_removeChild(child);
 		child->_setParent(this);
 		child->invalidateAbsPosition();
+	}else{
+		eraseChild(child->getIndexInParent());
 	}
-	if(after==getLastChild())
-		lastChild=child;
-	if(firstChild==child)
-		firstChild=child->getNext();
-//    child->insertAfter(after);
-	child->_updateNeighbors(after,after.isNull() ? nullptr : after->getNext());
-	if(firstChild==nullptr)
-		firstChild=child;
-	if(lastChild==nullptr)
-		lastChild=child;
-
-	if(getFirstChild()->getPrev()!=nullptr){
-		firstChild=getFirstChild()->getPrev();
-	}
-	if(getLastChild()->getNext()!=nullptr){
-		lastChild=getLastChild()->getNext();
-	}
+	// no (valid) predecessor given? -> insert as first child
+	placeChild(child, (after.isNotNull() && after->getParent()==this) ? after->getIndexInParent()+1 : 0);
 
 	childRectChanged(child.get());
 	invalidateLayout();
 }
 
-void Container::_insertBefore(const Ref & child,const Ref & before){
+void Container::_insertBefore(const Ref & _child,const Ref & _before){
+	// copy the references as they may point into the children array
+	const Ref child(_child);
+	const Ref before(_before);
 	if (child.isNull() || child==before) return;
 
 	if(child->getParent()!=this){
-		++contentsCount;
 		if(child->hasParent()){
 			child->getParent()->_removeChild(child);
 		}
 		child->_setParent(this);
-		childRectChanged(child.get());
 		child->invalidateAbsPosition();
+	}else{
+		eraseChild(child->getIndexInParent());
 	}
-	if(before==getFirstChild())
-		firstChild=child;
-//    child->insertBefore(before);
-	child->_updateNeighbors(before.isNull() ? nullptr : before->getPrev(),before);
-
-	if(firstChild==nullptr)
-		firstChild=child;
-	if(lastChild==nullptr)
-		lastChild=child;
-
-	if(getFirstChild()->getPrev()!=nullptr){
-		firstChild=getFirstChild()->getPrev();
-	}
-	if(getLastChild()->getNext()!=nullptr){
-		lastChild=getLastChild()->getNext();
-	}
+	// no (valid) successor given? -> insert as last child
+	placeChild(child, (before.isNotNull() && before->getParent()==this) ? before->getIndexInParent() : children.size());
+
 	childRectChanged(child.get());
 	invalidateLayout();
 }
 
-void Container::_removeChild(const Ref & child) {
+void Container::_removeChild(const Ref & _child) {
+	const Ref child(_child); // the given reference may point into the children array
 	if (child.isNull() || (child->getParent()!=this) ) {
 		if(!child.isNull()){
 			std::cout << "Container::_removeChild: Component is not a child. this:" <<this->getTypeName()<<" component:"<<child->getTypeName()<<"\n";
 		}
 		return;
 	}
-	if(child==getFirstChild()){
-		firstChild = child->getNext();
+	eraseChild(child->getIndexInParent());
+	child->_setParent(nullptr);
+
+	childRectChanged(child.get());
+	invalidateLayout();
+}
+
+void Container::_insertChildren(size_t index,const std::vector<Ref> & _newChildren){
+	// copy the references as they may point into the children array
+	const std::vector<Ref> newChildren(_newChildren);
+	index = std::min(index,children.size());
+	for(const auto & child : newChildren){
+		if(child.isNull())
+			continue;
+		if(child->getParent()==this && child->getIndexInParent()<index)
+			--index;
+		if(child->hasParent())
+			child->getParent()->_removeChild(child);
 	}
-	if(child==getLastChild()){
-		lastChild = child->getPrev();
+	std::vector<Ref> batch;
+	batch.reserve(newChildren.size());
+	for(const auto & child : newChildren){
+		if(child.isNull() || child->getParent()==this) // null or given twice
+			continue;
+		child->_setParent(this);
+		child->invalidateAbsPosition();
+		batch.push_back(child);
 	}
+	if(batch.empty())
+		return;
+	children.insert(children.begin()+index,batch.begin(),batch.end());
+	for(size_t i=index;i<children.size();++i)
+		children[i]->_setIndexInParent(i);
 
-	child->_updateNeighbors(nullptr,nullptr);
-	child->_setParent(nullptr);
+	childRectChanged(children[index].get());
+	invalidateLayout();
+}
 
-	--contentsCount;
-	childRectChanged(child.get());
+void Container::_removeChildren(size_t index,size_t count){
+	if(index>=children.size() || count==0)
+		return;
+	count = std::min(count,children.size()-index);
+	// keep the children alive until they are informed
+	const std::vector<Ref> removedChildren(children.begin()+index,children.begin()+index+count);
+	children.erase(children.begin()+index,children.begin()+index+count);
+	for(size_t i=index;i<children.size();++i)
+		children[i]->_setIndexInParent(i);
+	for(const auto & child : removedChildren)
+		child->_setParent(nullptr);
+
+	childRectChanged(removedChildren.front().get());
 	invalidateLayout();
 }
 
 //! ---|> Component
 std::string Container::toString()const {
 	std::ostringstream s;
-	size_t i = getContentsCount();
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext()){
-		s<<c->toString();
-		if (--i>0)s<<",";
+	for(size_t i=0;i<children.size();++i){
+		if(i>0)
+			s<<",";
+		s<<children[i]->toString();
 	}
 	s<<"]";
 	return s.str();
@@ -151,7 +178,8 @@ void Container::displayChildren(const Geometry::Rect & region,bool useScissor/*=
 		getGUI().pushScissor(scissorRect);
 	}
 		
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext()){
+	for(size_t i=0;i<children.size();++i){
+		Component * c = children[i].get();
 		if (c->isEnabled() && myRegion.intersects(c->getAbsRect()))
 			c->display(region);
 	}
@@ -175,8 +203,8 @@ Component::visitorResult_t Container::traverseSubtree(Visitor & v) {
 		case EXIT_TRAVERSAL:
 			return EXIT_TRAVERSAL;
 		case CONTINUE_TRAVERSAL:
-			for(Component * c = getFirstChild();c!=nullptr;c = c->getNext()){
-				if(c->traverseSubtree(v) == EXIT_TRAVERSAL)
+			for(size_t i=0;i<children.size();++i){
+				if(children[i]->traverseSubtree(v) == EXIT_TRAVERSAL)
 					return EXIT_TRAVERSAL;
 			}
 		default:
@@ -187,8 +215,8 @@ Component::visitorResult_t Container::traverseSubtree(Visitor & v) {
 
 //! ---|> Component
 Component::visitorResult_t Container::traverseChildren(Visitor & v) {
-	for(Component * c = getFirstChild();c!=nullptr;c = c->getNext()){
-		if( v.visit(*c)==EXIT_TRAVERSAL )
+	for(size_t i=0;i<children.size();++i){
+		if( v.visit(*children[i].get())==EXIT_TRAVERSAL )
 			return EXIT_TRAVERSAL;
 	}
 	return CONTINUE_TRAVERSAL;
@@ -218,10 +246,11 @@ void Container::destroyContents(){
 
 //! ---o
 std::vector<Component*> Container::getContents() {
-	std::vector<Component*> children;
-	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext())
-		children.push_back(c);
-	return children;
+	std::vector<Component*> contents;
+	contents.reserve(children.size());
+	for(const auto & child : children)
+		contents.push_back(child.get());
+	return contents;
 }
 
 void Container::childRectChanged(Component * /*c*/){
@@ -13,6 +13,7 @@
 
 #include "Component.h"
 #include <list>
+#include <vector>
 
 namespace GUI {
 /***
@@ -22,6 +23,9 @@ namespace GUI {
 class Container : public Component {
 		PROVIDES_TYPE_NAME(Container)
 	public:
+		static const kind_t KIND=KIND_CONTAINER;
+		typedef Container kindClass_t;
+
 		GUIAPI Container(GUI_Manager & gui,flag_t flags=0);
 		GUIAPI Container(GUI_Manager & gui,const Geometry::Rect & r,flag_t flags=0);
 
@@ -35,13 +39,27 @@ class Container : public Component {
 		GUIAPI void _insertAfter(const Ref & child,const Ref & after);
 		GUIAPI void _insertBefore(const Ref & child,const Ref & before);
 		GUIAPI void _removeChild(const Ref & child);
+		/*! Insert the given children before the child at position @p index (or at the end if @p index is out of range).
+			The indices of the following children are only updated once for the whole batch.	*/
+		GUIAPI void _insertChildren(size_t index,const std::vector<Ref> & newChildren);
+		//! Remove the children at the positions [@p index, @p index+@p count).
+		GUIAPI void _removeChildren(size_t index,size_t count);
 
-		Component * getFirstChild()const	{	return firstChild.get();	}
-		Component * getLastChild()const 	{	return lastChild.get();	}
+		/*! The children are stored in a contiguous array; a child's index (see Component::getIndexInParent())
+			corresponds to its position. Iterating over getChildren() does not allocate memory.
+			\note The children must not be added or removed while iterating over getChildren();
+				use an index based loop (or getContents()) instead.	*/
+		typedef std::vector<Ref,PoolAllocatorAdapter<Ref>> children_t;
+		const children_t & getChildren()const	{	return children;	}
+		Component * getChild(size_t index)const	{	return index<children.size() ? children[index].get() : nullptr;	}
+		size_t getChildCount()const				{	return children.size();	}
+		Component * getFirstChild()const		{	return children.empty() ? nullptr : children.front().get();	}
+		Component * getLastChild()const 		{	return children.empty() ? nullptr : children.back().get();	}
 
-		/*! This is called by a child @p c whenever its rect is changed, it's added or it's removed.
+		/*! ---o
+			This is called by a child @p c whenever its rect is changed, it's added or it's removed.
 			The LAYOUT_VALID flag is cleared.	*/
-		GUIAPI void childRectChanged(Component * c);
+		GUIAPI virtual void childRectChanged(Component * c);
 
 		// ---o
 		virtual void addContent(const Ref & child) 		{	_addChild(child);	}
@@ -56,7 +74,7 @@ class Container : public Component {
 		GUIAPI void destroyContents();
 
 		// ---o
-		virtual size_t getContentsCount()const 			{	return contentsCount;	}
+		virtual size_t getContentsCount()const 			{	return children.size();	}
 		// ---o
 		GUIAPI virtual void bringChildToFront(Component * c);
 		// ---o
@@ -82,9 +100,13 @@ class Container : public Component {
 		GUIAPI void displayChildren(const Geometry::Rect & region,bool useScissor=false);
 		GUIAPI void copyChildrenTo(Container & target)const;
 
-		Ref firstChild;
-		Ref lastChild;
-		size_t contentsCount;
+	private:
+		children_t children;
+
+		//! (internal) Remove the child at the given position without informing it.
+		GUIAPI void eraseChild(size_t index);
+		//! (internal) Insert the child at the given position (without setting its parent).
+		GUIAPI void placeChild(const Ref & child,size_t index);
 };
 }
 #endif // CONTAINER_H
@@ -32,13 +32,14 @@ class FillLayouter : public AbstractLayouter{
 		
 		//! ---|> AbstractLayouter
 		void layout(Util::WeakPointer<Component> component) override{
-			Container * container = dynamic_cast<Container*>(component.get());
+			Container * container = castTo<Container>(component.get());
 			if(!container)
 				throw std::invalid_argument("FillLayouter can only be applied to Containers.");
 			float width = 0;
 			float height = 0;
 			
-			for(Component * child=container->getFirstChild();child!=nullptr;child=child->getNext()){
+			for(const auto & childRef : container->getChildren()){
+				Component * child = childRef.get();
 				width = std::max(width,child->getPosition().x()+child->getWidth() );
 				height = std::max(height,child->getPosition().y()+child->getHeight() );
 			}
@@ -21,8 +21,8 @@ namespace GUI {
 //! (ctor)
 Label::Label(GUI_Manager & _gui,const std::string & _text,flag_t _flags/*=0*/):
 	Component(_gui,_flags),textStyle(Draw::TEXT_ALIGN_LEFT){
+	addKind(KIND);
 	setText(_text);
-
 	// guess the initial size using the default font
 	setSize(Draw::getTextSize(_text,getGUI().getActiveFont(PROPERTY_DEFAULT_FONT)));
 
@@ -32,6 +32,7 @@ Label::Label(GUI_Manager & _gui,const std::string & _text,flag_t _flags/*=0*/):
 //! (ctor)
 Label::Label(GUI_Manager & _gui,const Geometry::Rect & _r,const std::string & _text,flag_t _flags/*=0*/):
 	Component(_gui,_r,_flags),textStyle(Draw::TEXT_ALIGN_LEFT){
+	addKind(KIND);
 	setText(_text);
 	//ctor
 }
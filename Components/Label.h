@@ -25,6 +25,9 @@ class Label: public Component	{
 		static const flag_t RECALCULATE_SIZE=1<<24;
 	
 	public:
+		static const kind_t KIND=KIND_LABEL;
+		typedef Label kindClass_t;
+
 		GUIAPI Label(GUI_Manager & gui,const std::string &text="",flag_t flags=0);
 		GUIAPI Label(GUI_Manager & gui,const Geometry::Rect & r,const std::string &text="",flag_t flags=0);
 		GUIAPI virtual ~Label();
@@ -18,7 +18,10 @@ namespace GUI {
 class NextRow: public Component	{
 		PROVIDES_TYPE_NAME(NextRow)
 	public:
-		NextRow(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {}
+		static const kind_t KIND=KIND_NEXT_ROW;
+		typedef NextRow kindClass_t;
+
+		NextRow(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {	addKind(KIND);	}
 		NextRow(const NextRow & c) : Component(c),additionalSpacing(c.additionalSpacing) {}
 		virtual ~NextRow(){}
 
@@ -30,7 +33,10 @@ class NextRow: public Component	{
 class NextColumn: public Component	{
 		PROVIDES_TYPE_NAME(NextColumn)
 	public:
-		NextColumn(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {}
+		static const kind_t KIND=KIND_NEXT_COLUMN;
+		typedef NextColumn kindClass_t;
+
+		NextColumn(GUI_Manager & _gui,float _additionalSpacing) : Component(_gui),additionalSpacing(_additionalSpacing) {	addKind(KIND);	}
 
 		NextColumn(const NextColumn & c) : Component(c),additionalSpacing(c.additionalSpacing) {}
 		virtual ~NextColumn() {}
@@ -11,7 +11,7 @@
 #include "ListView.h"
 #include "../GUI_Manager.h"
 #include "../Base/StyleManager.h"
-#include "../Base/AnimationHandler.h"
+#include "../Base/TweenAnimation.h"
 #include "../Base/ListenerHelper.h"
 #include "../Base/Layouters/ExtLayouter.h"
 #include "Scrollbar.h"
@@ -20,27 +20,91 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace GUI {
 
 const ListView::flag_t ListView::AT_LEAST_ONE_MARKING = 1 << 24;
 const ListView::flag_t ListView::AT_MOST_ONE_MARKING = 1 << 25;
 
+typedef IndexRangeSet::range_t range_t;
+
+//! Append [first, end) to the ranges in marking order.
+static void appendRange(std::vector<range_t> & order, size_t first, size_t end) {
+	if(!order.empty() && order.back().second == first)
+		order.back().second = end;
+	else
+		order.emplace_back(first, end);
+}
+
+//! Remove [first, end) from the ranges in marking order; if @p shift is set, the following indices are moved down.
+static void eraseRange(std::vector<range_t> & order, size_t first, size_t end, bool shift) {
+	const size_t delta = shift ? end - first : 0;
+	std::vector<range_t> result;
+	result.reserve(order.size() + 1);
+	for(const auto & range : order) {
+		if(range.second <= first) {
+			result.push_back(range);
+		} else if(range.first >= end) {
+			result.emplace_back(range.first - delta, range.second - delta);
+		} else if(shift && range.first < first && range.second > end) {
+			result.emplace_back(range.first, range.second - delta);
+		} else {
+			if(range.first < first)
+				result.emplace_back(range.first, first);
+			if(range.second > end)
+				result.emplace_back(end - delta, range.second - delta);
+		}
+	}
+	order.swap(result);
+}
+
+//! Make room for @p count indices at @p index in the ranges in marking order.
+static void insertIndices(std::vector<range_t> & order, size_t index, size_t count) {
+	std::vector<range_t> result;
+	result.reserve(order.size() + 1);
+	for(const auto & range : order) {
+		if(range.second <= index) {
+			result.push_back(range);
+		} else if(range.first >= index) {
+			result.emplace_back(range.first + count, range.second + count);
+		} else {
+			result.emplace_back(range.first, index);
+			result.emplace_back(index + count, range.second + count);
+		}
+	}
+	order.swap(result);
+}
 // ------------------------------------------------------------------------------
 // ClientArea
 
 // ---|> Component
 void ListView::ListViewClientArea::doLayout() {
+	if(myListView.getModel() != nullptr)
+		myListView.updateVisibleRows();
 
-	const size_t numEntries(myListView.getNumVisibleEntries());
-
-	Component * c = myListView.getEntry(myListView.getEntryIndexByPosition(myListView.getScrollPos()));
-	for( size_t i = 0 ; i < numEntries && c != nullptr ; ++i, c = c->getNext() ) {
+	size_t firstIndex, endIndex;
+	myListView.getEntryRangeInView(firstIndex, endIndex);
+	if(myListView.getModel() == nullptr)
+		myListView.updateOutdatedPositions(firstIndex, endIndex);
+	for( size_t index = firstIndex ; index < endIndex ; ++index ) {
+		Component * c = myListView.getEntry(index);
+		if(c == nullptr)
+			break;
 		c->layout();
 		c->setWidth(getWidth());
 	}
 }
 
+// ---|> Container
+void ListView::ListViewClientArea::childRectChanged(Component * c) {
+	// a parked entry that grows must not reach into the client area
+	if(c->getParent() == this && c->getPosition().y() < 0 && c->getPosition().y() + c->getHeight() >= 0)
+		parkEntry(c);
+	Container::childRectChanged(c);
+}
+
 // ---|> Component
 void ListView::ListViewClientArea::doDisplay(const Geometry::Rect & region) {
 	enableLocalDisplayProperties();
@@ -51,17 +115,21 @@ void ListView::ListViewClientArea::doDisplay(const Geometry::Rect & region) {
 	
 	const Geometry::Rect myRegion( region.isValid() ? getAbsRect().clipBy(region) : getAbsRect() );
 
-	const size_t numEntries(myListView.getNumVisibleEntries());
 	Geometry::Rect markerRect(0, 0, getWidth(), myListView.getEntryHeight());
-	Component * c = myListView.getEntry(myListView.getEntryIndexByPosition(myListView.getScrollPos()));
-	const Component * comp_cursor = myListView.getCursorEntry();
+	size_t firstIndex, endIndex;
+	myListView.getEntryRangeInView(firstIndex, endIndex);
+	const size_t cursorIndex = myListView.getCursorIndex();
 	
-	for( size_t i = 0 ; i < numEntries && c != nullptr ; ++i, c = c->getNext() ) {
-		if(myListView.isMarked(c)) {
+	for( size_t index = firstIndex ; index < endIndex ; ++index ) {
+		Component * c = myListView.getEntry(index);
+		if(c == nullptr)
+			break;
+		markerRect.setHeight(myListView.getRowHeight(index));
+		if(myListView.isMarkedIndex(index)) {
 			markerRect.setPosition(c->getPosition());
 			markedEntryShape->display(markerRect);
 		}
-		if(c == comp_cursor && myListView.isSelected()) {
+		if(index == cursorIndex && myListView.isSelected()) {
 			markerRect.setPosition(c->getPosition());
 			selectionRectShape->display(markerRect);
 		}
@@ -80,12 +148,16 @@ ListView::ListView(GUI_Manager & _gui, flag_t _flags/*=0*/) :
 	keyListener(createKeyListener(_gui, this, &ListView::onKeyEvent)),
 	mouseButtonListener(createMouseButtonListener(_gui, this, &ListView::onMouseButton)),
 	optionalMouseMotionListener(createOptionalMouseMotionListener(_gui, this, &ListView::onMouseMove)),
-	initialMarkingIndex(0) {
-
+	lastMarkedIndex(0), markingListCacheValid(false), initialMarkingIndex(0), firstVisibleRow(0), overscan(2), rowsOutdated(false),
+	variableRowHeights(false), firstOutdatedPosition(npos), positionedBegin(0), positionedEnd(0), typeAheadIndexValid(false) {
 	clientArea->setFlag(IS_CLIENT_AREA, true);
 	_addChild(clientArea.get());
 	setFlag(USE_SCISSOR, true);
 	setFlag(SELECTABLE, true);
+	// the ids are the row indices or the entries, which are the client area's children
+	typeAheadIndex.setEntryOrder([this](TypeAheadIndex::id_t a, TypeAheadIndex::id_t b) {
+		return model.isNotNull() ? a < b : reinterpret_cast<Component *>(a)->getIndexInParent() < reinterpret_cast<Component *>(b)->getIndexInParent();
+	});
 }
 
 void ListView::assertIsChild(Component * c)const {
@@ -93,6 +165,11 @@ void ListView::assertIsChild(Component * c)const {
 		throw std::invalid_argument("Given component is no child of this ListView.");
 }
 
+void ListView::assertHasNoModel()const {
+	if(model.isNotNull())
+		throw std::logic_error("The contents of this ListView are provided by a model.");
+}
+
 //! (dtor)
 ListView::~ListView() {
 	if(optionalScrollBarListener) {
@@ -105,7 +182,7 @@ ListView::~ListView() {
 //! ---|> Component
 void ListView::doLayout() {
 
-	clientArea->setHeight(entryHeight * getContentsCount());
+	clientArea->setHeight(getRowOffset(getEntryCount()));
 
 	// \note the scrolling in x direction is currently unused (but is left for later extensions)
 	maxScrollPos = Geometry::Vec2( std::max(0.0f,clientArea->getWidth() - getWidth()) , std::max(0.0f, clientArea->getHeight() - getHeight() ));
@@ -181,55 +258,272 @@ void ListView::doDisplay(const Geometry::Rect & region) {
 
 //! ---|> Container
 void ListView::addContent(const Ref & child)		{
+	assertHasNoModel();
 	clientArea->addContent(child);
 	entryRegistry.push_back(child.get());
+	if(typeAheadIndexValid)
+		typeAheadIndex.set(reinterpret_cast<TypeAheadIndex::id_t>(child.get()), TypeAheadIndex::findLabel(child.get()));
+	if(variableRowHeights)
+		rowHeights.pushBack(entryHeight);
 	resetPositions(static_cast<int>(getContentsCount()) - 1);
-	if(markingList.empty() && getFlag(AT_LEAST_ONE_MARKING)) {
+	if(markedRanges.empty() && getFlag(AT_LEAST_ONE_MARKING)) {
 		addMarking(child.get());
 	}
 	invalidateLayout();
 }
 //! ---|> Container
 void ListView::clearContents() {
+	if(model.isNotNull()) {
+		releaseRows();
+		unusedRows.clear();
+		rowsOutdated = true;
+		clientArea->invalidateLayout();
+		return;
+	}
 	clearMarkings(true);
-	clientArea->clearContents();
-	rebuildRegistry();
+	clientArea->_removeChildren(0, clientArea->getChildCount());
+	entryRegistry.clear();
+	typeAheadIndex.clear();
+	rowHeights.clear();
+	firstOutdatedPosition = npos;
+	setCursorIndex(0);
 	invalidateLayout();
 }
 
+Component * ListView::getEntry(size_t i)const {
+	if(model.isNotNull())
+		return (i >= firstVisibleRow && i - firstVisibleRow < visibleRows.size()) ? visibleRows[i - firstVisibleRow] : nullptr;
+	return i < entryRegistry.size() ? entryRegistry[i] : nullptr;
+}
+
+size_t ListView::getEntryIndex(Component * c)const {
+	if(c == nullptr || c->getParent() != clientArea.get())
+		return npos;
+	if(model.isNotNull()) {
+		const auto it = std::find(visibleRows.begin(), visibleRows.end(), c);
+		return it == visibleRows.end() ? npos : firstVisibleRow + static_cast<size_t>(it - visibleRows.begin());
+	}
+	// the entries are the client area's children in the same order
+	return c->getIndexInParent();
+}
+
 size_t ListView::getEntryIndexByPosition(const Geometry::Vec2 & p)const {
-	if(p.getX() < 0 || p.getY() < 0 || entryRegistry.empty())
+	const size_t count = getEntryCount();
+	if(p.getX() < 0 || p.getY() < 0 || count == 0)
 		return npos;
-	return std::min( static_cast<size_t>(entryRegistry.size() - 1), static_cast<size_t>(p.getY() / getEntryHeight() ));
+	const size_t index = variableRowHeights ? rowHeights.findIndex(p.getY()) : static_cast<size_t>(p.getY() / getEntryHeight());
+	return std::min( static_cast<size_t>(count - 1), index);
+}
+
+size_t ListView::getNumVisibleEntries()const {
+	size_t first, end;
+	getEntryRangeInView(first, end);
+	if(end > first)
+		return end - first;
+	return static_cast<size_t>(getHeight() / entryHeight + 1);
+}
+
+//! (internal)
+void ListView::getEntryRangeInView(size_t & first, size_t & end)const {
+	first = getEntryIndexByPosition(Geometry::Vec2(0.0f, std::max(0.0f, scrollPos.y())));
+	if(first == npos) {
+		first = end = 0;
+		return;
+	}
+	end = getEntryIndexByPosition(Geometry::Vec2(0.0f, std::max(0.0f, scrollPos.y()) + getHeight())) + 1;
 }
 
 //! ---|> Container
 void ListView::removeContent(const Ref & child)	{
+	assertHasNoModel();
 	assertIsChild(child.get());
-	clientArea->removeContent(child);
-	rebuildRegistry();
-	resetPositions(0);
-	removeMarking(child.get(), true);
-	if(getFlag(AT_LEAST_ONE_MARKING) && markingList.empty() && !entryRegistry.empty()) {
-		addMarking(entryRegistry.front());
-	}
-	invalidateLayout();
+	removeContents(getEntryIndex(child.get()), 1);
 }
 //! ---|> Container
 void ListView::insertAfter(const Ref & child, const Ref & after)	{
-	clientArea->insertAfter(child, after);
-	rebuildRegistry();
-	resetPositions(0);
+	assertHasNoModel();
+	if(child.isNotNull() && child->getParent() == clientArea.get()) { // moved entry
+		moveEntries([&]() {	clientArea->insertAfter(child, after);	});
+		return;
+	}
+	// no (valid) predecessor given? -> insert as first entry
+	const size_t index = getEntryIndex(after.get());
+	insertContents(index == npos ? 0 : index + 1, {child});
 }
 //! ---|> Container
 void ListView::insertBefore(const Ref & child, const Ref & after) {
-	clientArea->insertBefore(child, after);
+	assertHasNoModel();
+	if(child.isNotNull() && child->getParent() == clientArea.get()) { // moved entry
+		moveEntries([&]() {	clientArea->insertBefore(child, after);	});
+		return;
+	}
+	// no (valid) successor given? -> insert as last entry
+	insertContents(getEntryIndex(after.get()), {child});
+}
+
+void ListView::insertContents(size_t index, const std::vector<Ref> & children) {
+	assertHasNoModel();
+	index = std::min(index, entryRegistry.size());
+	const size_t oldCount = entryRegistry.size();
+	const bool movesEntries = std::any_of(children.begin(), children.end(),
+			[this](const Ref & c) {	return c.isNotNull() && c->getParent() == clientArea.get();	});
+	if(movesEntries) { // rare case: the indices of the existing entries change arbitrarily
+		moveEntries([&]() {	clientArea->_insertChildren(index, children);	});
+		return;
+	}
+	clientArea->_insertChildren(index, children);
+	const size_t insertedCount = clientArea->getChildCount() - oldCount;
+	if(insertedCount == 0)
+		return;
+	std::vector<Component *> newEntries;
+	newEntries.reserve(insertedCount);
+	for(size_t i = index; i < index + insertedCount; ++i)
+		newEntries.push_back(clientArea->getChild(i));
+	entryRegistry.insert(entryRegistry.begin() + index, newEntries.begin(), newEntries.end());
+	if(typeAheadIndexValid) {
+		for(Component * c : newEntries)
+			typeAheadIndex.set(reinterpret_cast<TypeAheadIndex::id_t>(c), TypeAheadIndex::findLabel(c));
+	}
+	if(variableRowHeights)
+		rowHeights.insert(index, insertedCount, entryHeight);
+	resetPositions(index);
+
+	// the cursor and the initial marking stay at their entries
+	if(oldCount > 0 && getCursorIndex() >= index)
+		setCursorIndex(getCursorIndex() + insertedCount);
+	if(oldCount > 0 && initialMarkingIndex >= index)
+		initialMarkingIndex += insertedCount;
+	markedRanges.insertIndices(index, insertedCount);
+	insertIndices(markingOrder, index, insertedCount);
+	if(lastMarkedIndex >= index)
+		lastMarkedIndex += insertedCount;
+	if(markedRanges.empty() && getFlag(AT_LEAST_ONE_MARKING))
+		addMarking(entryRegistry[index]);
+	invalidateLayout();
+}
+
+void ListView::removeContents(size_t first, size_t count) {
+	assertHasNoModel();
+	if(first >= entryRegistry.size() || count == 0)
+		return;
+	count = std::min(count, entryRegistry.size() - first);
+
+	const size_t oldMarkingCount = markedRanges.size();
+	markedRanges.eraseIndices(first, first + count);
+	eraseRange(markingOrder, first, first + count, true);
+	bool markingsChanged = markedRanges.size() != oldMarkingCount;
+	if(markingsChanged)
+		markingListCacheValid = false;
+
+	if(typeAheadIndexValid) {
+		for(size_t i = first; i < first + count; ++i)
+			typeAheadIndex.remove(reinterpret_cast<TypeAheadIndex::id_t>(entryRegistry[i]));
+	}
+	clientArea->_removeChildren(first, count);
+	entryRegistry.erase(entryRegistry.begin() + first, entryRegistry.begin() + first + count);
+	if(variableRowHeights)
+		rowHeights.erase(first, first + count);
+	resetPositions(first);
+
+	// the cursor stays at its entry; if it is removed, it moves to the following entry
+	const auto adjustIndex = [&](size_t i) -> size_t {
+		if(i >= first + count)
+			i -= count;
+		else if(i >= first)
+			i = first;
+		return std::min(i, entryRegistry.empty() ? 0 : entryRegistry.size() - 1);
+	};
+	setCursorIndex(adjustIndex(getCursorIndex()));
+	initialMarkingIndex = adjustIndex(initialMarkingIndex);
+	lastMarkedIndex = adjustIndex(lastMarkedIndex);
+
+	if(getFlag(AT_LEAST_ONE_MARKING) && markedRanges.empty() && !entryRegistry.empty()) {
+		doAddMarking(entryRegistry.front());
+		markingsChanged = true;
+	}
+	if(markingsChanged)
+		markingChanged();
+	invalidateLayout();
+}
+
+//! (internal)
+void ListView::moveEntries(const std::function<void ()> & change) {
+	// the markings and heights stay with their entries
+	const markingList_t markings(getMarkings());
+	std::unordered_map<Component *, float> heights;
+	if(variableRowHeights) {
+		for(size_t i = 0; i < entryRegistry.size(); ++i)
+			heights[entryRegistry[i]] = getRowHeight(i);
+	}
+	change();
 	rebuildRegistry();
+
+	markedRanges.clear();
+	markingOrder.clear();
+	for(Component * c : markings) {
+		const size_t index = getEntryIndex(c);
+		if(index != npos) {
+			markedRanges.add(index, index + 1);
+			appendRange(markingOrder, index, index + 1);
+		}
+	}
+	lastMarkedIndex = std::min(lastMarkedIndex, entryRegistry.empty() ? 0 : entryRegistry.size() - 1);
+	markingListCacheValid = false;
+	if(variableRowHeights) {
+		rowHeights.clear();
+		for(Component * c : entryRegistry) {
+			const auto it = heights.find(c);
+			rowHeights.pushBack(it == heights.end() ? entryHeight : it->second);
+		}
+	}
 	resetPositions(0);
+	invalidateLayout();
+}
+
+void ListView::replaceContents(const std::vector<Ref> & children) {
+	assertHasNoModel();
+	clearContents();
+	insertContents(0, children);
 }
+
 void ListView::resetPositions(size_t beginningIndex) {
-	for(size_t i = beginningIndex; i < entryRegistry.size(); ++i)
-		entryRegistry[i]->setPosition(Geometry::Vec2(0, i * entryHeight));
+	if(model.isNotNull()) { // the rows in view are positioned by updateVisibleRows()
+		firstOutdatedPosition = std::min(firstOutdatedPosition, beginningIndex);
+		clientArea->invalidateLayout();
+		return;
+	}
+	if(beginningIndex > firstOutdatedPosition) { // the entries in view are moved by updateOutdatedPositions()
+		positionedEnd = std::min(positionedEnd, beginningIndex);
+		for(size_t i = beginningIndex; i < entryRegistry.size(); ++i)
+			parkEntry(entryRegistry[i]);
+		clientArea->invalidateLayout();
+		return;
+	}
+	firstOutdatedPosition = npos;
+	float offset = getRowOffset(beginningIndex);
+	for(size_t i = beginningIndex; i < entryRegistry.size(); ++i) {
+		entryRegistry[i]->setPosition(Geometry::Vec2(0, offset));
+		offset += getRowHeight(i);
+	}
+}
+
+//! (internal)
+void ListView::updateOutdatedPositions(size_t firstIndex, size_t endIndex) {
+	if(firstOutdatedPosition == npos)
+		return;
+	endIndex = std::min(endIndex, entryRegistry.size());
+	for(size_t i = std::max(positionedBegin, firstOutdatedPosition); i < positionedEnd; ++i) {
+		if(i < firstIndex || i >= endIndex)
+			parkEntry(entryRegistry[i]);
+	}
+	const size_t begin = std::max(firstIndex, firstOutdatedPosition);
+	float offset = begin < endIndex ? getRowOffset(begin) : 0.0f;
+	for(size_t i = begin; i < endIndex; ++i) {
+		entryRegistry[i]->setPosition(Geometry::Vec2(0, offset));
+		offset += getRowHeight(i);
+	}
+	positionedBegin = firstIndex;
+	positionedEnd = endIndex;
 }
 void ListView::rebuildRegistry() {
 	entryRegistry.clear();
@@ -240,24 +534,28 @@ void ListView::rebuildRegistry() {
 // ------------------------------------------------------------------
 // Cursor
 void ListView::scrollToCursor() {
-	Component * c = getCursorEntry();
-	if(c == nullptr) {
+	if(getCursorIndex() >= getEntryCount())
 		return;
-	} else if( c->getPosition().getY() - getEntryHeight() < getScrollPos().getY() ) {
-		scrollTo(c->getPosition() + Geometry::Vec2(0.0f, -getEntryHeight()), 0.1f);
+	// the entries' positions are determined by their index (also for rows of a model that are not in view)
+	const Geometry::Vec2 cursorPos(0.0f, getRowOffset(getCursorIndex()));
+	const float cursorHeight = getRowHeight(getCursorIndex());
+	if( cursorPos.getY() - getEntryHeight() < getScrollPos().getY() ) {
+		scrollTo(cursorPos + Geometry::Vec2(0.0f, -getEntryHeight()), 0.1f);
 
-	} else if( c->getPosition().getY() + getEntryHeight() * 1.5 > getScrollPos().getY() + getHeight() ) {
-		scrollTo(c->getPosition() + Geometry::Vec2(0.0f, 1.5f * getEntryHeight() - getHeight()), 0.1f);
+	} else if( cursorPos.getY() + cursorHeight + getEntryHeight() * 0.5 > getScrollPos().getY() + getHeight() ) {
+		scrollTo(cursorPos + Geometry::Vec2(0.0f, cursorHeight + 0.5f * getEntryHeight() - getHeight()), 0.1f);
 	}
 }
 
 void ListView::moveCursor(int delta) {
-	if(entryRegistry.empty()) {
+	const size_t count = getEntryCount();
+	if(count == 0) {
 		setCursorIndex(0);
 	} else if(delta < 0) {
-		setCursorIndex( static_cast<size_t>(std::max(static_cast<int>(getCursorIndex()) + delta, 0)) );
+		const size_t d = static_cast<size_t>(-static_cast<int64_t>(delta));
+		setCursorIndex( getCursorIndex() > d ? getCursorIndex() - d : 0 );
 	} else {
-		setCursorIndex( static_cast<size_t>(std::min(getCursorIndex() + delta, entryRegistry.size() - 1)) );
+		setCursorIndex( std::min(getCursorIndex() + static_cast<size_t>(delta), count - 1) );
 	}
 }
 
@@ -328,7 +626,7 @@ bool ListView::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 			scrollToCursor();
 			return true;
 		} else if(keyEvent.key == Util::UI::KEY_END) {
-			setCursorIndex(entryRegistry.size() - 1);
+			setCursorIndex(getEntryCount() > 0 ? getEntryCount() - 1 : 0);
 			scrollToCursor();
 			return true;
 		} else if(keyEvent.key == Util::UI::KEY_PAGEUP) {
@@ -342,46 +640,19 @@ bool ListView::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 		} else if(keyEvent.key == Util::UI::KEY_SPACE) {
 			performMarkingAction(getCursorIndex(), getGUI().isCtrlPressed(), getGUI().isShiftPressed());
 			return true;
+		} else {
+			return onTypeAheadInput(keyEvent);
 		}
 	}
 	return false;
 }
-
 // ------------------------------------------------------------------
 // Scrolling
 
-//! ListView_ScrollAnimation ---|> AnimationHandler
-class ListView_ScrollAnimation: public AnimationHandler {
-	public:
-		Geometry::Vec2 targetPos;
-
-		ListView_ScrollAnimation(ListView * p, Geometry::Vec2 _targetPos, float _duration) :
-			AnimationHandler(p, _duration), targetPos(std::move(_targetPos)) {
-		}
-		virtual ~ListView_ScrollAnimation()	{}
-
-		// ---|> AnimationHandler
-		bool animate(float t) override {
-			if(t > getEndTime()) {
-				finish();
-				return false;
-			}
-			ListView * p = dynamic_cast<ListView *>(getComponent());
-
-			for(float f = 0.0f; f < t - getStartTime(); f += 0.01f) // for every 10 ms
-				p->setScrollingPosition( (p->getScrollPos() * 99.0f + targetPos) * 0.01f);
-			return true;
-		}
-
-		// ---|> AnimationHandler
-		void finish() override {
-			dynamic_cast<ListView *>(getComponent())->setScrollingPosition(targetPos);
-		}
-};
-
 void ListView::scrollTo(const Geometry::Vec2 & pos, float duration) {
 	getGUI().stopAnimations(this);
-	getGUI().addAnimationHandler(new ListView_ScrollAnimation(this, pos, duration));
+	getGUI().addAnimationHandler(createScrollTween(this, scrollPos, pos, duration,
+												   [this](const Geometry::Vec2 & p) {	setScrollingPosition(p);	}));
 }
 
 void ListView::setScrollingPosition(const Geometry::Vec2 & pos) {
@@ -412,53 +683,174 @@ void ListView::clearMarkings(bool forced) {
 }
 
 //! (internal)
-void ListView::doAddMarking(Component * c) {
+size_t ListView::getMarkableIndex(Component * c)const {
 	assertIsChild(c);
-	std::pair<markingSet_t::iterator, bool> result = markingSet.insert(c);
+	const size_t index = getEntryIndex(c);
+	if(index == npos)
+		throw std::invalid_argument("Given component is no row of this ListView.");
+	return index;
+}
 
-	// component was already marked
-	if(!result.second) {
-		markingList.remove(c);
-	}
+//! (internal)
+void ListView::doAddMarking(Component * c) {
+	const size_t index = getMarkableIndex(c);
+	doAddMarkedRange(index, index + 1);
+}
 
-	markingList.push_back(c);
+//! (internal)
+void ListView::doAddMarkedRange(size_t first, size_t end) {
+	if(first >= end)
+		return;
 	if(getFlag(AT_MOST_ONE_MARKING)) {
-		while(markingList.size() > 1) {
-			doRemoveMarking(markingList.front(), true);
-		}
+		markedRanges.clear();
+		markingOrder.clear();
+		first = end - 1;
 	}
+	appendToMarkingOrder(first, end, false);
+	markedRanges.add(first, end);
+	lastMarkedIndex = end - 1;
+	markingListCacheValid = false;
+}
+
+//! (internal)
+void ListView::appendToMarkingOrder(size_t first, size_t end, bool marked) {
+	if(model.isNotNull())
+		return;
+	const auto & ranges = markedRanges.getRanges();
+	// the first marked range ending behind first
+	auto it = std::upper_bound(ranges.begin(), ranges.end(), first,
+								[](size_t index, const range_t & range) {	return index < range.second;	});
+	size_t pos = first;
+	for(; it != ranges.end() && it->first < end; ++it) {
+		if(marked)
+			appendRange(markingOrder, std::max(pos, it->first), std::min(it->second, end));
+		else if(it->first > pos)
+			appendRange(markingOrder, pos, it->first);
+		pos = it->second;
+	}
+	if(!marked && pos < end)
+		appendRange(markingOrder, pos, end);
 }
 
 //! (internal)
 bool ListView::doClearMarking(bool forced) {
-	if(markingSet.empty())
+	if(markedRanges.empty())
 		return false;
 	if(getFlag(AT_LEAST_ONE_MARKING) && !forced ) {
-		Component * c = markingList.back();
-		markingSet.clear();
-		markingList.clear();
-		doAddMarking(c);
+		const size_t keptIndex = markedRanges.contains(lastMarkedIndex) ? lastMarkedIndex : markedRanges.back();
+		if(markedRanges.size() == 1 && markedRanges.contains(keptIndex))
+			return false;
+		markedRanges.clear();
+		markingOrder.clear();
+		doAddMarkedRange(keptIndex, keptIndex + 1);
 	} else {
-		markingSet.clear();
-		markingList.clear();
-
+		markedRanges.clear();
+		markingOrder.clear();
 	}
+	markingListCacheValid = false;
 	return true;
 }
 
 //! (internal)
 bool ListView::doRemoveMarking(Component * c, bool forced) {
-	assertIsChild(c);
-	if(getFlag(AT_LEAST_ONE_MARKING) && markingList.size() == 1 && !forced) {
+	const size_t index = getMarkableIndex(c);
+	return doRemoveMarkedRange(index, index + 1, forced);
+}
+
+//! (internal)
+bool ListView::doRemoveMarkedRange(size_t first, size_t end, bool forced) {
+	if(first >= end || markedRanges.empty())
 		return false;
+	const size_t oldCount = markedRanges.size();
+	const size_t lastIndex = markedRanges.back();
+	markedRanges.remove(first, end);
+	eraseRange(markingOrder, first, end, false);
+	// as if the entries were unmarked one by one: the last one remains.
+	if(getFlag(AT_LEAST_ONE_MARKING) && markedRanges.empty() && !forced) {
+		appendToMarkingOrder(lastIndex, lastIndex + 1, false);
+		markedRanges.add(lastIndex, lastIndex + 1);
 	}
-	if(markingSet.erase(c)) {
-		markingList.remove(c);
-		return true;
+	if(markedRanges.size() == oldCount)
+		return false;
+	markingListCacheValid = false;
+	return true;
+}
+
+const ListView::markingList_t & ListView::getMarkings()const {
+	if(!markingListCacheValid) {
+		markingListCache.clear();
+		if(model.isNull()) {
+			for(const auto & range : markingOrder) {
+				for(size_t i = range.first; i < range.second && i < entryRegistry.size(); ++i)
+					markingListCache.push_back(entryRegistry[i]);
+			}
+		}
+		markingListCacheValid = true;
+	}
+	return markingListCache;
+}
+
+bool ListView::isMarked(Component * c)const {
+	const size_t index = getEntryIndex(c);
+	return index != npos && markedRanges.contains(index);
+}
+
+void ListView::setMarkedIndices(const std::vector<size_t> & indices) {
+	IndexRangeSet newMarkings;
+	const size_t count = getEntryCount();
+	for(const auto & index : indices) {
+		if(index < count)
+			newMarkings.add(index, index + 1);
+	}
+	if(newMarkings == markedRanges)
+		return;
+	doClearMarking(true);
+	for(const auto & range : newMarkings.getRanges())
+		doAddMarkedRange(range.first, range.second);
+	markingChanged();
+}
+
+void ListView::addMarkedRange(size_t first, size_t count) {
+	const size_t end = std::min(first + count, getEntryCount());
+	if(first >= end)
+		return;
+	const IndexRangeSet oldMarkings(markedRanges);
+	doAddMarkedRange(first, end);
+	if(markedRanges != oldMarkings)
+		markingChanged();
+}
+
+void ListView::removeMarkedRange(size_t first, size_t count, bool forced) {
+	if(doRemoveMarkedRange(first, std::min(first + count, getEntryCount()), forced))
+		markingChanged();
+}
+
+void ListView::toggleMarkedRange(size_t first, size_t count) {
+	const size_t end = std::min(first + count, getEntryCount());
+	if(first >= end)
+		return;
+	if(getFlag(AT_MOST_ONE_MARKING) && end - first > 1) {
+		WARN("ListView::toggleMarkedRange: Only one entry may be marked.");
+		return;
+	}
+	const IndexRangeSet oldMarkings(markedRanges);
+	markedRanges.toggle(first, end);
+	if(markedRanges.contains(end - 1))
+		lastMarkedIndex = end - 1;
+	if(getFlag(AT_LEAST_ONE_MARKING) && markedRanges.empty())
+		markedRanges = oldMarkings;
+	if(markedRanges != oldMarkings) {
+		// the newly marked entries follow the others
+		eraseRange(markingOrder, first, end, false);
+		appendToMarkingOrder(first, end, true);
+		markingListCacheValid = false;
+		markingChanged();
 	}
-	return false;
 }
 
+void ListView::markAll() {
+	addMarkedRange(0, getEntryCount());
+}
 
 //! ---o
 void ListView::markingChanged() {
@@ -467,17 +859,18 @@ void ListView::markingChanged() {
 
 //! (internal)
 void ListView::performMarkingAction(const size_t index, const bool accumulative, const bool grouping) {
-	if(index >= entryRegistry.size())
+	const size_t count = getEntryCount();
+	if(index >= count)
 		return;
 
 	// l-button + shift (+ ctrl) -> add or remove marking from initial index to current (based on marking of initial index)
 	if( grouping ) {
-		initialMarkingIndex = std::min(static_cast<size_t>(entryRegistry.size() - 1), initialMarkingIndex);
+		initialMarkingIndex = std::min(static_cast<size_t>(count - 1), initialMarkingIndex);
 		bool doMark = true;
 
 		// ctrl is pressed, do not erase the prior marking but take status of initial index as basis
 		if( accumulative ) {
-			doMark = isMarked(entryRegistry[initialMarkingIndex]);
+			doMark = isMarkedIndex(initialMarkingIndex);
 		} else {
 			doClearMarking(true);
 		}
@@ -485,25 +878,29 @@ void ListView::performMarkingAction(const size_t index, const bool accumulative,
 		const size_t start = std::min(index, initialMarkingIndex);
 		const size_t end = std::max(index, initialMarkingIndex);
 		if(doMark) {
-			for(size_t i = start; i <= end; ++i)
-				doAddMarking(entryRegistry[i]);
+			doAddMarkedRange(start, end + 1);
 		} else {
-			for(size_t i = start; i <= end; ++i)
-				doRemoveMarking(entryRegistry[i], false);
+			doRemoveMarkedRange(start, end + 1, false);
 		}
 		markingChanged();
 	} // l-button + ctrl -> toggle (and store initial index)
 	else if( accumulative ) {
 		initialMarkingIndex = index;
-		Component * c = entryRegistry[index];
-		if(isMarked(c))
-			removeMarking(c);
-		else
-			addMarking(c);
+		if(isMarkedIndex(index)) {
+			if(doRemoveMarkedRange(index, index + 1, false))
+				markingChanged();
+		} else {
+			doAddMarkedRange(index, index + 1);
+			markingChanged();
+		}
 	}// l-button -> set marking (and store initial index)
 	else {
 		initialMarkingIndex = index;
-		setMarking(entryRegistry[index]);
+		if(markedRanges.size() == 1 && isMarkedIndex(index))
+			return;
+		doClearMarking(true);
+		doAddMarkedRange(index, index + 1);
+		markingChanged();
 	}
 }
 
@@ -515,19 +912,279 @@ void ListView::removeMarking(Component * c, bool forced) {
 }
 
 void ListView::setMarking(Component * c) {
-	assertIsChild(c);
-	if(markingSet.size() == 1 && isMarked(c))
+	const size_t index = getMarkableIndex(c);
+	if(markedRanges.size() == 1 && isMarkedIndex(index))
 		return;
 	doClearMarking(true);
-	doAddMarking(c);
+	doAddMarkedRange(index, index + 1);
 	markingChanged();
 }
 void ListView::setMarkings(const markingList_t & newMarkings){
-	if(newMarkings == markingList)
+	IndexRangeSet newRanges;
+	for(Component * c : newMarkings) {
+		const size_t index = getMarkableIndex(c);
+		newRanges.add(index, index + 1);
+	}
+	if(newRanges == markedRanges)
 		return;
 	doClearMarking(true);
-	std::for_each(newMarkings.begin(), newMarkings.end(), 
-				  std::bind(&ListView::doAddMarking, this, std::placeholders::_1));
+	for(Component * c : newMarkings) // keep the order for the last marked entry
+		doAddMarking(c);
 	markingChanged();
 }
+
+// -------------------------------------------------------------------
+// Model
+
+void ListView::setModel(const Util::Reference<AbstractListViewModel> & m) {
+	if(m == model)
+		return;
+	clearMarkings(true);
+	if(model.isNotNull()) {
+		releaseRows();
+		unusedRows.clear(); // the rows of the old model can not be reused
+	} else {
+		clientArea->clearContents();
+		rebuildRegistry();
+	}
+	model = m;
+	firstVisibleRow = 0;
+	typeAheadIndexValid = false;
+	variableRowHeights = false;
+	rowHeights.clear();
+	setCursorIndex(0);
+	modelChanged();
+}
+
+void ListView::modelChanged() {
+	if(doModelChanged())
+		markingChanged();
+}
+
+void ListView::modelChanged(const std::vector<size_t> & markedIndices) {
+	const IndexRangeSet oldMarkings(markedRanges);
+	const size_t count = getEntryCount();
+	doClearMarking(true);
+	for(const auto & index : markedIndices) {
+		if(index < count)
+			doAddMarkedRange(index, index + 1);
+	}
+	doModelChanged();
+	if(markedRanges != oldMarkings)
+		markingChanged();
+}
+
+//! (internal)
+bool ListView::doModelChanged() {
+	rowsOutdated = true;
+	typeAheadIndexValid = false; // the rows may have been changed arbitrarily
+	const size_t count = getEntryCount();
+	if(variableRowHeights && rowHeights.size() != count) {
+		// new rows have the default height
+		if(rowHeights.size() > count)
+			rowHeights.erase(count, rowHeights.size());
+		else
+			rowHeights.insert(rowHeights.size(), count - rowHeights.size(), entryHeight);
+	}
+	if(getCursorIndex() >= count)
+		setCursorIndex(count > 0 ? count - 1 : 0);
+	bool markingsChanged = false;
+	if(model.isNotNull()) {
+		if(!markedRanges.empty() && markedRanges.back() >= count) {
+			markedRanges.remove(count, markedRanges.back() + 1);
+			markingsChanged = true;
+		}
+		if(getFlag(AT_LEAST_ONE_MARKING) && markedRanges.empty() && count > 0) {
+			const size_t index = std::min(lastMarkedIndex, count - 1);
+			doAddMarkedRange(index, index + 1);
+			markingsChanged = true;
+		}
+	}
+	clientArea->invalidateLayout();
+	invalidateLayout();
+	return markingsChanged;
+}
+
+void ListView::rowsChanged(size_t first, size_t count) {
+	if(model.isNull())
+		return;
+	if(typeAheadIndexValid) {
+		const size_t end = std::min(first + count, getEntryCount());
+		for(size_t index = first; index < end; ++index)
+			typeAheadIndex.set(index, model->getRowText(index));
+	}
+	if(rowsOutdated)
+		return;
+	const size_t begin = std::max(first, firstVisibleRow);
+	const size_t end = std::min(first + count, firstVisibleRow + visibleRows.size());
+	for(size_t index = begin; index < end; ++index)
+		model->updateRow(*visibleRows[index - firstVisibleRow], index);
+}
+
+void ListView::setOverscan(size_t rows) {
+	overscan = rows;
+	clientArea->invalidateLayout();
+}
+
+//! (internal)
+void ListView::updateVisibleRows() {
+	const size_t count = getEntryCount();
+	size_t firstInView, endInView;
+	getEntryRangeInView(firstInView, endInView);
+	const size_t begin = std::min(count, firstInView > overscan ? firstInView - overscan : 0);
+	const size_t end = std::min(count, endInView + overscan);
+	if(!rowsOutdated && firstOutdatedPosition == npos && begin == firstVisibleRow && end - begin == visibleRows.size())
+		return;
+
+	// keep the rows that stay in view; the others are reused for the new rows.
+	std::vector<Component*> rows(end - begin, nullptr);
+	std::vector<Component*> reusableRows;
+	for(size_t i = 0; i < visibleRows.size(); ++i) {
+		const size_t index = firstVisibleRow + i;
+		if(!rowsOutdated && index >= begin && index < end)
+			rows[index - begin] = visibleRows[i];
+		else
+			reusableRows.push_back(visibleRows[i]);
+	}
+	for(size_t i = 0; i < rows.size(); ++i) {
+		if(rows[i] != nullptr)
+			continue;
+		Component * row;
+		if(!reusableRows.empty()) {
+			row = reusableRows.back();
+			reusableRows.pop_back();
+		} else if(!unusedRows.empty()) {
+			row = unusedRows.back().get();
+			clientArea->_addChild(unusedRows.back());
+			unusedRows.pop_back();
+		} else {
+			const Ref newRow = model->createRow(getGUI());
+			if(newRow.isNull())
+				throw std::logic_error("ListView: The model did not create a row.");
+			clientArea->_addChild(newRow);
+			row = newRow.get();
+		}
+		model->updateRow(*row, begin + i);
+		row->setWidth(clientArea->getWidth());
+		rows[i] = row;
+	}
+	float offset = getRowOffset(begin);
+	for(size_t i = 0; i < rows.size(); ++i) {
+		rows[i]->setPosition(Geometry::Vec2(0, offset));
+		offset += getRowHeight(begin + i);
+	}
+	for(Component * row : reusableRows) {
+		unusedRows.emplace_back(row);
+		clientArea->_removeChild(row);
+	}
+	visibleRows.swap(rows);
+	firstVisibleRow = begin;
+	rowsOutdated = false;
+	firstOutdatedPosition = npos;
+}
+
+// -------------------------------------------------------------------
+// Row heights
+
+void ListView::setEntryHeight(float h) {
+	entryHeight = h;
+	variableRowHeights = false;
+	rowHeights.clear();
+	resetPositions(0);
+	invalidateLayout();
+}
+
+void ListView::setRowHeight(size_t index, float height) {
+	const size_t count = getEntryCount();
+	if(index >= count || height == getRowHeight(index))
+		return;
+	if(!variableRowHeights) {
+		variableRowHeights = true;
+		rowHeights.assign(count, entryHeight);
+	}
+	rowHeights.set(index, height);
+	if(model.isNull()) {
+		// Park the entries whose position becomes outdated; the ones in view are moved during the next layout.
+		// Each entry is parked at most once until the positions are reset.
+		for(size_t i = index + 1; i < std::min(firstOutdatedPosition, count); ++i)
+			parkEntry(entryRegistry[i]);
+		for(size_t i = std::max(positionedBegin, index + 1); i < std::min(positionedEnd, count); ++i)
+			parkEntry(entryRegistry[i]);
+		positionedBegin = positionedEnd = 0;
+	}
+	firstOutdatedPosition = std::min(firstOutdatedPosition, index + 1);
+	clientArea->invalidateLayout();
+	invalidateLayout();
+}
+
+void ListView::setRowHeights(const std::vector<float> & heights) {
+	const size_t count = getEntryCount();
+	variableRowHeights = true;
+	rowHeights.clear();
+	for(size_t i = 0; i < count; ++i)
+		rowHeights.pushBack(i < heights.size() ? heights[i] : entryHeight);
+	resetPositions(0);
+	invalidateLayout();
+}
+
+//! (internal)
+void ListView::releaseRows() {
+	for(Component * row : visibleRows) {
+		unusedRows.emplace_back(row);
+		clientArea->_removeChild(row);
+	}
+	visibleRows.clear();
+	firstVisibleRow = 0;
+}
+
+// ------------------------------------------------------------------
+// Type-ahead search
+
+void ListView::entryLabelsChanged() {
+	typeAheadIndexValid = false;
+}
+
+//! (internal)
+bool ListView::onTypeAheadInput(const Util::UI::KeyboardEvent & keyEvent) {
+	if(getGUI().isCtrlPressed() || !typeAheadIndex.appendInput(keyEvent, getGUI().getTimerWheel().getTime()))
+		return false;
+	const size_t index = findTypeAheadEntry();
+	if(index != npos) {
+		setCursorIndex(index);
+		performMarkingAction(index, false, false);
+		scrollToCursor();
+	}
+	return true;
+}
+
+//! (internal)
+size_t ListView::findTypeAheadEntry() {
+	const size_t count = getEntryCount();
+	if(!typeAheadIndexValid) {
+		typeAheadIndex.clear();
+		for(size_t index = 0; index < count; ++index) {
+			typeAheadIndex.set(model.isNotNull() ? static_cast<TypeAheadIndex::id_t>(index) :
+					reinterpret_cast<TypeAheadIndex::id_t>(entryRegistry[index]),
+					model.isNotNull() ? model->getRowText(index) : TypeAheadIndex::findLabel(entryRegistry[index]));
+		}
+		typeAheadIndexValid = true;
+	}
+	const bool hasCurrent = getCursorIndex() < count;
+	const TypeAheadIndex::id_t current = !hasCurrent ? 0 : (model.isNotNull() ? static_cast<TypeAheadIndex::id_t>(getCursorIndex()) :
+			reinterpret_cast<TypeAheadIndex::id_t>(entryRegistry[getCursorIndex()]));
+	TypeAheadIndex::id_t id;
+	// a found entry whose label has changed in the meantime is re-indexed and the search is repeated
+	for(size_t attempts = typeAheadIndex.size(); attempts > 0 && typeAheadIndex.search(hasCurrent, current, id); --attempts) {
+		if(model.isNotNull()) {
+			if(!typeAheadIndex.set(id, model->getRowText(static_cast<size_t>(id))))
+				return static_cast<size_t>(id);
+		} else {
+			Component * c = reinterpret_cast<Component *>(id);
+			if(!typeAheadIndex.set(id, TypeAheadIndex::findLabel(c)))
+				return getEntryIndex(c);
+		}
+	}
+	return npos;
+}
+
 }
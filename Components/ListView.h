@@ -11,8 +11,14 @@
 #ifndef GUI_ListView_H
 #define GUI_ListView_H
 
+#include "AbstractListViewModel.h"
 #include "Container.h"
+#include "../Base/IndexRangeSet.h"
 #include "../Base/ListenerHelper.h"
+#include "../Base/PrefixSumTree.h"
+#include "../Base/TypeAheadIndex.h"
+#include <functional>
+#include <list>
 #include <memory>
 #include <set>
 #include <vector>
@@ -45,12 +51,11 @@ public:
 		// ---|> Component
 		GUIAPI virtual void doLayout() override;
 
-		void setEntryHeight(float h) {
-			entryHeight=h;
-			resetPositions(0);
-		}
+		//! Set the height of all entries (individual row heights are discarded).
+		GUIAPI void setEntryHeight(float h);
 
-		size_t getNumVisibleEntries()const					{	return static_cast<size_t>(getHeight()/entryHeight+1);	}
+		//! Number of entries (at least partly) in view at the current scrolling position; respects individual row heights.
+		GUIAPI size_t getNumVisibleEntries()const;
 	private:
 		void assertIsChild(Component * c)const;
 		class ListViewClientArea : public Container{
@@ -65,6 +70,8 @@ public:
 
 				// ---|> Component
 				GUIAPI virtual void doLayout() override;
+				// ---|> Container
+				GUIAPI virtual void childRectChanged(Component * c) override;
 
 			private:
 				// ---|> Component
@@ -91,8 +98,13 @@ public:
 		// ---|> Container
 		virtual std::vector<Component*> getContents() override 				{	return clientArea->getContents();		}
 
-		//! Return entry with given index or nullptr if there is no such entry.
-		Component * getEntry(size_t i)const							{	return i<entryRegistry.size() ? entryRegistry[i] : nullptr;}
+		/*! Return entry with given index or nullptr if there is no such entry.
+			\note In model mode, only the rows in view (plus the overscan) have an entry.	*/
+		GUIAPI Component * getEntry(size_t i)const;
+		//! Number of entries; in model mode, this is the model's row count.
+		size_t getEntryCount()const									{	return model.isNotNull() ? model->getRowCount() : entryRegistry.size();	}
+		//! Return the index of the given entry or npos if it is no entry.
+		GUIAPI size_t getEntryIndex(Component * c)const;
 
 		// ---|> Container
 		GUIAPI virtual void insertAfter(const Ref & child,const Ref & after) override;
@@ -103,15 +115,32 @@ public:
 		// ---|> Container
 		GUIAPI virtual void removeContent(const Ref & child) override;
 
+		/*! Insert the given entries before the entry with index @p index (or at the end if @p index is out of range).
+			The registry, the entries' positions, the markings and the cursor are updated once for the whole batch.	*/
+		GUIAPI void insertContents(size_t index,const std::vector<Ref> & children);
+		//! Remove the entries with the indices [@p first, @p first+@p count).
+		GUIAPI void removeContents(size_t first,size_t count);
+		//! Replace all entries by the given ones.
+		GUIAPI void replaceContents(const std::vector<Ref> & children);
+
+		static const size_t npos = static_cast<size_t>(-1);
 
 	private:
 		GUIAPI void rebuildRegistry();
 		GUIAPI void resetPositions(size_t beginningIndex);
-
-		static const size_t npos = static_cast<size_t>(-1);
+		//! (internal) Move the outdated entries in [first, end) to their offsets and park the other ones moved before.
+		void updateOutdatedPositions(size_t firstIndex,size_t endIndex);
+		//! (internal) Move the entry above the client area, where getComponentAtPos() does not find it.
+		static void parkEntry(Component * c)				{	c->setPosition(Geometry::Vec2(0, -c->getHeight() - 1.0f));	}
+		//! Throws if the contents are provided by a model.
+		void assertHasNoModel()const;
+		//! (internal) Apply a @p change of the children that moves existing entries; markings and heights stay with their entries.
+		void moveEntries(const std::function<void ()> & change);
 
 		//! returns npos if no element is at the given position
 		GUIAPI size_t getEntryIndexByPosition(const Geometry::Vec2 & p)const;
+		//! (internal) The entries [first, end) are (at least partly) in view.
+		void getEntryRangeInView(size_t & first, size_t & end)const;
 		// a collection of all components, mapping the index(=the row) to the component
 		std::vector<Component *> entryRegistry; //
 	//	@}
@@ -155,22 +184,49 @@ public:
 		//! Add a marking to the given component and call marking changed.
 		GUIAPI void addMarking(Component * c);
 		GUIAPI void clearMarkings(bool forced=false);
-		const markingList_t & getMarkings()const			{	return markingList;	};
-		bool isMarked(Component * c)const					{	return markingSet.count(c)>0;	}
+		/*! Return the marked entries in the order in which they have been marked; entries marked together
+			(e.g. by addMarkedRange()) are in the order of their indices.
+			\note The list is created on demand; in model mode, it is empty (use getMarkedRanges() instead).	*/
+		GUIAPI const markingList_t & getMarkings()const;
+		GUIAPI bool isMarked(Component * c)const;
 		// ---o
 		GUIAPI virtual void markingChanged();
 		GUIAPI void removeMarking(Component * c,bool forced=false);
 		GUIAPI void setMarking(Component * c);
 		GUIAPI void setMarkings(const markingList_t & markings);
 
+		// index based access (also available in model mode)
+		bool isMarkedIndex(size_t index)const				{	return markedRanges.contains(index);	}
+		//! Return the indices of the marked entries in ascending order.
+		std::vector<size_t> getMarkedIndices()const			{	return markedRanges.toVector();	}
+		GUIAPI void setMarkedIndices(const std::vector<size_t> & indices);
+		const IndexRangeSet & getMarkedRanges()const		{	return markedRanges;	}
+		size_t getMarkingCount()const						{	return markedRanges.size();	}
+		//! Mark the entries [@p first, @p first+@p count) in addition to the existing markings.
+		GUIAPI void addMarkedRange(size_t first,size_t count);
+		//! Unmark the entries [@p first, @p first+@p count).
+		GUIAPI void removeMarkedRange(size_t first,size_t count,bool forced=false);
+		//! Invert the markings of the entries [@p first, @p first+@p count).
+		GUIAPI void toggleMarkedRange(size_t first,size_t count);
+		GUIAPI void markAll();
+
 	private:
 		GUIAPI void doAddMarking(Component * c);
+		//! (internal) Mark [@p first, @p end); the indices have to be valid.
+		GUIAPI void doAddMarkedRange(size_t first,size_t end);
 		GUIAPI bool doClearMarking(bool forced);
 		GUIAPI bool doRemoveMarking(Component * c,bool forced);
+		GUIAPI bool doRemoveMarkedRange(size_t first,size_t end,bool forced);
 		GUIAPI void performMarkingAction(const size_t index,const bool accumulative,const bool grouping);
-
-		markingSet_t markingSet;
-		markingList_t markingList;
+		//! (internal) Returns the index of the entry or throws if @p c is no entry.
+		size_t getMarkableIndex(Component * c)const;
+		//! (internal) Append the entries of [@p first, @p end) that are (or are not) @p marked to markingOrder.
+		void appendToMarkingOrder(size_t first,size_t end,bool marked);
+		IndexRangeSet markedRanges;
+		std::vector<IndexRangeSet::range_t> markingOrder; // the marked ranges in the order of marking (empty in model mode)
+		size_t lastMarkedIndex;
+		mutable markingList_t markingListCache;
+		mutable bool markingListCacheValid;
 		size_t initialMarkingIndex;
 	//	@}
 
@@ -189,6 +245,93 @@ public:
 		Geometry::Vec2 scrollPos;
 		Geometry::Vec2 maxScrollPos;
 	//	@}
+
+	// ------------------
+
+	//! @name Model
+	//	@{
+	public:
+		/*! Let the rows be provided by the given model (or by the contents if @p m is nullptr); the current
+			contents are removed. In model mode, only the rows in view (plus the overscan) are represented by
+			components, which are reused while scrolling. Markings and the cursor refer to row indices.
+			The contents can not be changed directly; clearContents() only discards the row components.	*/
+		GUIAPI void setModel(const Util::Reference<AbstractListViewModel> & m);
+		AbstractListViewModel * getModel()const				{	return model.get();	}
+		//! Has to be called when the model's row count has changed; all visible rows are updated.
+		GUIAPI void modelChanged();
+		/*! Like modelChanged(), but the markings are replaced by the rows @p markedIndices (e.g. the new rows of
+			the marked data after the rows have been sorted); markingChanged() is called at most once.	*/
+		GUIAPI void modelChanged(const std::vector<size_t> & markedIndices);
+		//! Has to be called when the contents of the rows [@p first, @p first+@p count) have changed.
+		GUIAPI void rowsChanged(size_t first,size_t count);
+
+		//! Number of additional rows kept above and below the visible rows (default: 2).
+		size_t getOverscan()const							{	return overscan;	}
+		GUIAPI void setOverscan(size_t rows);
+	private:
+		//! (internal) Called by the client area's layout: assign row components to the rows in view.
+		GUIAPI void updateVisibleRows();
+		//! (internal) Remove all row components from the client area and keep them for reuse.
+		GUIAPI void releaseRows();
+		//! (internal) Update the rows after a change of the model; returns whether the markings have changed.
+		bool doModelChanged();
+		Util::Reference<AbstractListViewModel> model;
+		std::vector<Component*> visibleRows; // visibleRows[i] shows row firstVisibleRow+i
+		size_t firstVisibleRow;
+		std::vector<Ref> unusedRows;
+		size_t overscan;
+		bool rowsOutdated;
+	//	@}
+
+	// ------------------
+
+	//! @name Row heights
+	//	@{
+	public:
+		/*! Set the height of a single entry; all other entries keep their height (by default getEntryHeight()).
+			The offsets of the entries are kept in a prefix sum tree, so changing a height costs O(log n).
+			Only the following entries that are in view are moved during the next layout. The others are parked above
+			the client area, so that they cannot be hit, and are moved when they come into view (use getRowOffset()
+			for the position of an entry outside of the view). Each entry is parked at most once until all positions
+			are reset (e.g. by inserting entries before the first outdated one).	*/
+		GUIAPI void setRowHeight(size_t index,float height);
+		//! Set the heights of all entries; missing values are set to getEntryHeight().
+		GUIAPI void setRowHeights(const std::vector<float> & heights);
+		float getRowHeight(size_t index)const {
+			return variableRowHeights && index < rowHeights.size() ? static_cast<float>(rowHeights.get(index)) : entryHeight;
+		}
+		//! Return the vertical offset of the entry with the given index (or the total height for getEntryCount()).
+		float getRowOffset(size_t index)const {
+			return variableRowHeights ? static_cast<float>(rowHeights.getPrefixSum(index)) : index * entryHeight;
+		}
+		bool hasVariableRowHeights()const					{	return variableRowHeights;	}
+	private:
+		PrefixSumTree rowHeights; // only used if variableRowHeights is set
+		bool variableRowHeights;
+		size_t firstOutdatedPosition; // entries beginning with this index are parked or moved when they are in view (npos if none)
+		size_t positionedBegin, positionedEnd; // outdated entries in this range were moved into view by the last layout
+	//	@}
+
+	// ------------------
+
+	//! @name Type-ahead search
+	//	@{
+	public:
+		/*! Typed characters move the cursor to (and mark) the first entry whose label begins with them (see TypeAheadIndex).
+			The label of an entry is the text of its first Label; in model mode, it is AbstractListViewModel::getRowText().
+			The index of the labels is built on the first input and is updated when entries are inserted or removed.
+			A changed label of an existing entry is noticed when the entry is found; call entryLabelsChanged()
+			to make the new labels findable as well.	*/
+		GUIAPI void entryLabelsChanged();
+		TypeAheadIndex & getTypeAheadIndex()				{	return typeAheadIndex;	}
+	private:
+		//! (internal) Returns false if the event contains no printable character.
+		GUIAPI bool onTypeAheadInput(const Util::UI::KeyboardEvent & keyEvent);
+		//! (internal) Index of the entry matching the typed prefix or npos.
+		size_t findTypeAheadEntry();
+		TypeAheadIndex typeAheadIndex; // the ids are the entries' components (or the row indices in model mode)
+		bool typeAheadIndexValid;
+	//	@}
 };
 }
 #endif // GUI_ListView_H
@@ -16,13 +16,22 @@
 
 namespace GUI {
 
+//! The label of an entry used by the type-ahead search; disabled entries are not found.
+static std::string getEntryLabel(Component * c) {
+	return c->isEnabled() ? TypeAheadIndex::findLabel(c) : "";
+}
 //! (ctor)
 Menu::Menu(GUI_Manager & _gui, flag_t _flags) :
 	Container(_gui, _flags),
 	keyListener(createKeyListener(_gui, this, &Menu::onKeyEvent)),
-	mouseButtonListener(createMouseButtonListener(_gui, this, &Menu::onMouseButton)) {
+	mouseButtonListener(createMouseButtonListener(_gui, this, &Menu::onMouseButton)),
+	typeAheadIndexValid(false), indexedEntryCount(0) {
+	addKind(KIND);
 	disable();
 	setFlag(ALWAYS_ON_TOP,true);
+	typeAheadIndex.setEntryOrder([](TypeAheadIndex::id_t a, TypeAheadIndex::id_t b) {
+		return reinterpret_cast<Component *>(a)->getIndexInParent() < reinterpret_cast<Component *>(b)->getIndexInParent();
+	});
 	addProperty(new UseColorProperty(PROPERTY_TEXT_COLOR,PROPERTY_MENU_TEXT_COLOR));
     setMouseCursorProperty(PROPERTY_MOUSECURSOR_COMPONENTS);
 }
@@ -71,7 +80,7 @@ static void onFrame(Menu & menu, double /*timeSecs*/) {
 				continue;
 			}
 			// something other than a menu in front of this menu? -> close this
-			if(dynamic_cast<Menu*>(c) == nullptr) {
+			if(!isA<Menu>(c)) {
 				menu.close();
 				return;
 			}
@@ -85,6 +94,13 @@ static void onFrame(Menu & menu, double /*timeSecs*/) {
 	}
 }
 
+//! ---|> Container
+void Menu::childRectChanged(Component * c) {
+	if(c!=nullptr && c->getParent()!=this) // removed; the index must not keep its id
+		typeAheadIndexValid = false;
+	Container::childRectChanged(c);
+}
+
 //! ---|> Component
 bool Menu::onSelect(){
 	getGUI().setActiveComponent(this);
@@ -97,6 +113,9 @@ bool Menu::onUnselect(){
 }
 
 void Menu::open(const Geometry::Vec2 &pos){
+	// the labels or the enabled state of the entries may have been changed while the menu was closed
+	typeAheadIndexValid = false;
+	typeAheadIndex.resetPrefix();
 	setPosition(pos);
 	enable();
 	getGUI().setActiveComponent(this);
@@ -129,7 +148,43 @@ bool Menu::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 		unselect();
 		return true;
 	}
-	return false;
+	return onTypeAheadInput(keyEvent);
+}
+
+//! (internal)
+void Menu::assertTypeAheadIndexValid() {
+	if(typeAheadIndexValid && indexedEntryCount==getContentsCount())
+		return;
+	typeAheadIndex.clear();
+	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext())
+		typeAheadIndex.set(reinterpret_cast<TypeAheadIndex::id_t>(c), getEntryLabel(c));
+	typeAheadIndexValid = true;
+	indexedEntryCount = getContentsCount();
+}
+
+//! (internal)
+bool Menu::onTypeAheadInput(const Util::UI::KeyboardEvent & keyEvent) {
+	if(getGUI().isCtrlPressed() || !typeAheadIndex.appendInput(keyEvent, getGUI().getTimerWheel().getTime()))
+		return false;
+	assertTypeAheadIndexValid();
+	Component * current = nullptr;
+	for(Component * c=getFirstChild();c!=nullptr;c=c->getNext()){
+		if(c->isSelected()){
+			current = c;
+			break;
+		}
+	}
+	TypeAheadIndex::id_t id;
+	// a found entry whose label has changed in the meantime is re-indexed and the search is repeated
+	for(size_t attempts = typeAheadIndex.size(); attempts>0 &&
+			typeAheadIndex.search(current!=nullptr, reinterpret_cast<TypeAheadIndex::id_t>(current), id); --attempts) {
+		Component * entry = reinterpret_cast<Component *>(id);
+		if(!typeAheadIndex.set(id, getEntryLabel(entry))) {
+			entry->select();
+			break;
+		}
+	}
+	return true;
 }
 
 }
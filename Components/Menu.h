@@ -13,6 +13,7 @@
 
 #include "Container.h"
 #include "../Base/ListenerHelper.h"
+#include "../Base/TypeAheadIndex.h"
 #include <memory>
 
 namespace GUI {
@@ -24,6 +25,8 @@ namespace GUI {
 class Menu: public Container {
 		PROVIDES_TYPE_NAME(Menu)
 	public:
+		static const kind_t KIND=Container::KIND|KIND_MENU;
+		typedef Menu kindClass_t;
 		static const flag_t ONE_TIME_MENU=1<<24;
 
 		GUIAPI Menu(GUI_Manager & gui,flag_t flags=0);
@@ -34,6 +37,14 @@ class Menu: public Container {
 
 		GUIAPI virtual bool onSelect() override;
 		GUIAPI virtual bool onUnselect() override;
+
+		/*! ---|> Container
+			A removed (or destroyed) entry invalidates the type-ahead index.	*/
+		GUIAPI virtual void childRectChanged(Component * c) override;
+
+		/*! Typed characters select the first (enabled) entry whose label begins with them (see TypeAheadIndex).
+			The index of the labels is built on the first input after the menu has been opened or its entries have changed.	*/
+		TypeAheadIndex & getTypeAheadIndex()				{	return typeAheadIndex;	}
 	private:
 		// ---|> Component
 		GUIAPI virtual void doDisplay(const Geometry::Rect & region) override;
@@ -45,6 +56,13 @@ class Menu: public Container {
 		MouseButtonListener mouseButtonListener;
 		std::unique_ptr<FrameListenerHandle> optionalFrameListener;
 
+		//! (internal) Returns false if the event contains no printable character.
+		GUIAPI bool onTypeAheadInput(const Util::UI::KeyboardEvent & keyEvent);
+		//! (internal) Build the index if necessary.
+		void assertTypeAheadIndexValid();
+		TypeAheadIndex typeAheadIndex; // the ids are the entries
+		bool typeAheadIndexValid;
+		size_t indexedEntryCount; // number of entries when the index was built (added entries are detected by the count)
 	public:
 		// ---o
 		GUIAPI virtual void open(const Geometry::Vec2 &pos);
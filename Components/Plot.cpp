@@ -0,0 +1,207 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Plot.h"
+#include "../GUI_Manager.h"
+#include "../Base/Draw.h"
+#include "ComponentPropertyIds.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace GUI {
+
+//! (ctor)
+Plot::Plot(GUI_Manager & _gui,flag_t _flags/*=0*/) :
+		Component(_gui,_flags),sampleInterval(1.0),xMin(0),xMax(100),yMin(-1),yMax(1),following(false) {
+	setFlag(USE_SCISSOR,true);
+}
+
+//! (ctor)
+Plot::Plot(GUI_Manager & _gui,const Geometry::Rect & _r,flag_t _flags/*=0*/) :
+		Component(_gui,_r,_flags),sampleInterval(1.0),xMin(0),xMax(100),yMin(-1),yMax(1),following(false) {
+	setFlag(USE_SCISSOR,true);
+}
+//! (dtor)
+Plot::~Plot() {
+}
+
+// -------------------------------------------------------------------
+// Series
+
+size_t Plot::addSeries(const Util::Color4ub & color) {
+	seriesList.emplace_back(color);
+	invalidateRegion();
+	return seriesList.size()-1;
+}
+
+void Plot::setSeriesColor(size_t series,const Util::Color4ub & color) {
+	seriesList.at(series).color = color;
+	invalidateRegion();
+}
+
+void Plot::appendSample(size_t series,float value) {
+	seriesList.at(series).samples.append(value);
+	followSamples();
+	invalidateRegion();
+}
+
+void Plot::appendSamples(size_t series,const std::vector<float> & values) {
+	seriesList.at(series).samples.append(values.data(),values.size());
+	followSamples();
+	invalidateRegion();
+}
+
+void Plot::clearSamples(size_t series) {
+	seriesList.at(series).samples.clear();
+	invalidateRegion();
+}
+
+// -------------------------------------------------------------------
+// Visible range
+
+void Plot::setSampleInterval(double interval) {
+	if(!(interval>0))
+		throw std::invalid_argument("Plot::setSampleInterval: The interval has to be positive.");
+	sampleInterval = interval;
+	followSamples();
+	invalidateRegion();
+}
+
+void Plot::setXRange(double min,double max) {
+	if(!(min<max))
+		throw std::invalid_argument("Plot::setXRange: Invalid range.");
+	xMin = min;
+	xMax = max;
+	invalidateRegion();
+}
+
+void Plot::setYRange(float min,float max) {
+	if(!(min<max))
+		throw std::invalid_argument("Plot::setYRange: Invalid range.");
+	yMin = min;
+	yMax = max;
+	invalidateRegion();
+}
+
+void Plot::fitYRange() {
+	const size_t first = static_cast<size_t>(std::max(0.0,std::floor(xMin/sampleInterval)));
+	const size_t end = static_cast<size_t>(std::max(0.0,std::ceil(xMax/sampleInterval)))+1;
+	bool found = false;
+	float min = 0, max = 0;
+	for(const auto & series : seriesList) {
+		float seriesMin, seriesMax;
+		if(!series.samples.getRange(first,end,seriesMin,seriesMax))
+			continue;
+		min = found ? std::min(min,seriesMin) : seriesMin;
+		max = found ? std::max(max,seriesMax) : seriesMax;
+		found = true;
+	}
+	if(!found)
+		return;
+	if(max-min<=0) { // constant values
+		min -= 0.5f;
+		max += 0.5f;
+	}
+	setYRange(min,max);
+}
+
+void Plot::setFollowing(bool b) {
+	following = b;
+	followSamples();
+	invalidateRegion();
+}
+
+//! (internal)
+void Plot::followSamples() {
+	if(!following)
+		return;
+	size_t count = 0;
+	for(const auto & series : seriesList)
+		count = std::max(count,series.samples.size());
+	if(count==0)
+		return;
+	const double width = xMax-xMin;
+	xMax = (count-1)*sampleInterval;
+	xMin = xMax-width;
+}
+
+// -------------------------------------------------------------------
+// Display
+
+//! (internal)
+bool Plot::collectVertices(const Series & series,float width,float height) {
+	vertices.clear();
+	colors.clear();
+	const MinMaxPyramid & samples = series.samples;
+	const uint32_t color = series.color.getAsUInt();
+	const double pixelsPerSample = width*sampleInterval/(xMax-xMin);
+	const auto getX = [&](size_t sample) {	return static_cast<float>((sample*sampleInterval-xMin)*width/(xMax-xMin));	};
+	const auto getY = [&](float value) {	return height-(value-yMin)*height/(yMax-yMin);	};
+
+	// the samples in view (including one sample on each side for the lines leaving the plot)
+	const size_t first = static_cast<size_t>(std::max(0.0,std::floor(xMin/sampleInterval)));
+	const size_t end = std::min(samples.size(),static_cast<size_t>(std::max(0.0,std::ceil(xMax/sampleInterval)))+1);
+	if(first>=end)
+		return true;
+
+	if(pixelsPerSample>=0.5) { // line strip through the samples
+		for(size_t sample = first; sample < end; ++sample) {
+			vertices.push_back(getX(sample));
+			vertices.push_back(getY(samples.get(sample)));
+			colors.push_back(color);
+		}
+		return true;
+	}
+	// one vertical line per pixel column from the minimum to the maximum of its samples;
+	// the last sample of the previous column is included to connect the columns.
+	const size_t columnCount = static_cast<size_t>(std::ceil(width));
+	size_t columnFirst = first;
+	for(size_t column = 0; column < columnCount && columnFirst < end; ++column) {
+		const size_t columnEnd = std::min(end,static_cast<size_t>(std::max(0.0,std::ceil((xMin+(column+1)*(xMax-xMin)/width)/sampleInterval))));
+		float min, max;
+		if(columnEnd>columnFirst && samples.getRange(columnFirst>first ? columnFirst-1 : columnFirst,columnEnd,min,max)) {
+			const float x = column+0.5f;
+			vertices.insert(vertices.end(),{x,getY(max),x,getY(min)+1.0f});
+			colors.insert(colors.end(),{color,color});
+		}
+		columnFirst = std::max(columnFirst,columnEnd);
+	}
+	return false;
+}
+
+//! ---|> Component
+void Plot::doDisplay(const Geometry::Rect & /*region*/) {
+	enableLocalDisplayProperties();
+	displayDefaultShapes();
+	getGUI().displayShape(PROPERTY_PLOT_SHAPE,getLocalRect());
+	const Util::Color4ub gridColor = getGUI().getActiveColor(PROPERTY_PLOT_GRID_COLOR);
+
+	const float width = getWidth();
+	const float height = getHeight();
+	if(width>0 && height>0) {
+		if(yMin<0 && yMax>0) { // zero line
+			const float y = height-(0-yMin)*height/(yMax-yMin);
+			Draw::drawLines({0,y,width,y},{gridColor.getAsUInt(),gridColor.getAsUInt()});
+		}
+		for(const auto & series : seriesList) {
+			const bool strip = collectVertices(series,width,height);
+			if(colors.size()<2)
+				continue;
+			if(strip)
+				Draw::drawLine(vertices,colors);
+			else
+				Draw::drawLines(vertices,colors);
+		}
+	}
+	disableLocalDisplayProperties();
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_PLOT_H
+#define GUI_PLOT_H
+
+#include "Component.h"
+#include "../Base/MinMaxPyramid.h"
+#include <Util/Graphics/Color.h>
+#include <cstdint>
+#include <vector>
+
+namespace GUI {
+
+/***
+ **     Plot ---|> Component
+ **
+ ** Line plot of one or more series of equidistant samples (sample i is at x = i*getSampleInterval()).
+ ** The samples of a series are kept in a MinMaxPyramid. If a pixel column covers several samples, it is
+ ** drawn as a vertical line from the minimum to the maximum of its samples; so the number of vertices per
+ ** series is bounded by twice the plot's width, regardless of the number of samples.
+ ** Samples can only be appended (e.g. for streaming data); with setFollowing(true), the visible range
+ ** follows the newest samples.
+ **/
+class Plot : public Component {
+		PROVIDES_TYPE_NAME(Plot)
+	public:
+		GUIAPI Plot(GUI_Manager & gui,flag_t flags=0);
+		GUIAPI Plot(GUI_Manager & gui,const Geometry::Rect & r,flag_t flags=0);
+		GUIAPI virtual ~Plot();
+
+		//! @name Series
+		//	@{
+		//! Add an empty series and return its index.
+		GUIAPI size_t addSeries(const Util::Color4ub & color);
+		size_t getSeriesCount()const						{	return seriesList.size();	}
+		const MinMaxPyramid & getSamples(size_t series)const	{	return seriesList.at(series).samples;	}
+		GUIAPI void setSeriesColor(size_t series,const Util::Color4ub & color);
+
+		GUIAPI void appendSample(size_t series,float value);
+		GUIAPI void appendSamples(size_t series,const std::vector<float> & values);
+		GUIAPI void clearSamples(size_t series);
+		//	@}
+
+		//! @name Visible range
+		//	@{
+		double getSampleInterval()const						{	return sampleInterval;	}
+		GUIAPI void setSampleInterval(double interval);
+
+		double getXMin()const								{	return xMin;	}
+		double getXMax()const								{	return xMax;	}
+		GUIAPI void setXRange(double min,double max);
+		float getYMin()const								{	return yMin;	}
+		float getYMax()const								{	return yMax;	}
+		GUIAPI void setYRange(float min,float max);
+		//! Set the y range to the extremes of all samples in the visible x range (O(log n) per series).
+		GUIAPI void fitYRange();
+
+		/*! If enabled, the visible x range is moved (keeping its width) so that it ends with the newest sample
+			whenever samples are appended.	*/
+		GUIAPI void setFollowing(bool b);
+		bool isFollowing()const								{	return following;	}
+		//	@}
+
+	private:
+		// ---|> Component
+		GUIAPI virtual void doDisplay(const Geometry::Rect & region) override;
+
+		//! (internal) Move the visible range to the newest sample if following is enabled.
+		void followSamples();
+		struct Series{
+			MinMaxPyramid samples;
+			Util::Color4ub color;
+			explicit Series(const Util::Color4ub & _color) : color(_color) {}
+		};
+		/*! (internal) Fill the buffers with the vertices of the series for the given width in pixels; returns true
+			if they form a line strip (otherwise, they are pairs of vertices of separate lines).	*/
+		bool collectVertices(const Series & series,float width,float height);
+
+		std::vector<Series> seriesList;
+		double sampleInterval;
+		double xMin,xMax;
+		float yMin,yMax;
+		bool following;
+
+		// buffers reused for every series and frame
+		std::vector<float> vertices;
+		std::vector<uint32_t> colors;
+};
+
+}
+
+#endif // GUI_PLOT_H
@@ -10,7 +10,7 @@
 */
 #include "ScrollableContainer.h"
 #include "../GUI_Manager.h"
-#include "../Base/AnimationHandler.h"
+#include "../Base/TweenAnimation.h"
 #include "../Base/ListenerHelper.h"
 #include "../Base/StyleManager.h"
 #include "../Base/Layouters/ExtLayouter.h"
@@ -150,39 +150,10 @@ void ScrollableContainer::scrollTo(const Geometry::Vec2 & pos){
 	}
 }
 
-//! ScrollableContainer_ScrollAnimation ---|> AnimationHandler
-class ScrollableContainer_ScrollAnimation:public AnimationHandler{
-	public:
-		Geometry::Vec2 targetPos;
-
-		ScrollableContainer_ScrollAnimation(ScrollableContainer * p,Geometry::Vec2 _targetPos, float _duration) :
-			AnimationHandler(p,_duration),targetPos(std::move(_targetPos)){
-		}
-		virtual ~ScrollableContainer_ScrollAnimation()	{}
-
-		// ---|> AnimationHandler
-		bool animate(float t) override{
-			if(t > getEndTime()) {
-				finish();
-				return false;
-			}
-			ScrollableContainer * p= dynamic_cast<ScrollableContainer *>(getComponent());
-
-			for(float f=0.0f;f<t-getStartTime();f+=0.01f) // for every 10 ms
-				p->scrollTo( (p->getScrollPos()*99.0f + targetPos)*0.01f);
-			return true;
-		}
-
-		// ---|> AnimationHandler
-		void finish() override{
-			dynamic_cast<ScrollableContainer *>(getComponent())->scrollTo(targetPos);
-		}
-};
-
-
 void ScrollableContainer::scrollTo(const Geometry::Vec2 & pos,float duration){
 	getGUI().stopAnimations(this);
-	getGUI().addAnimationHandler(new ScrollableContainer_ScrollAnimation(this,pos,duration));
+	getGUI().addAnimationHandler(createScrollTween(this,scrollPos,pos,duration,
+												   [this](const Geometry::Vec2 & p){	scrollTo(p);	}));
 }
 
 }
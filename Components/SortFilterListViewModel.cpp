@@ -0,0 +1,287 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "SortFilterListViewModel.h"
+#include "ListView.h"
+#include "../GUI_Manager.h"
+#include "../Base/WorkerPool.h"
+#include <Util/Macros.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+namespace GUI{
+
+//! Number of source rows processed by one task.
+static const size_t chunkSize = 0x10000;
+
+//! Execute the tasks by the pool (or sequentially if there is none).
+static void runTasks(WorkerPool * pool,std::vector<WorkerPool::task_t> & tasks){
+	if(pool!=nullptr){
+		pool->run(tasks);
+	}else{
+		for(auto & task : tasks)
+			task();
+	}
+	tasks.clear();
+}
+
+struct SortFilterListViewModel::Job{
+	uint64_t generation;
+	size_t sourceCount;
+	filter_t filter;
+	less_t less;
+};
+
+struct SortFilterListViewModel::Result{
+	uint64_t generation;
+	bool identity;
+	std::vector<size_t> rows;
+	std::vector<size_t> sourceToRow;
+	Result() : generation(0),identity(false) {}
+};
+
+//! State shared by the model and its background thread; it outlives the model if a result is still posted.
+struct SortFilterListViewModel::SharedState{
+	GUI_Manager & gui;
+	std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::unique_ptr<Job> pendingJob;			// protected by mutex
+	bool shutdown;								// protected by mutex
+	std::atomic<uint64_t> latestGeneration;		// generation of the newest job; the older ones are canceled
+	uint64_t appliedGeneration;					// only accessed by the GUI's thread
+	SortFilterListViewModel * owner;			// only accessed by the GUI's thread; nullptr after the model's destruction
+	SharedState(GUI_Manager & _gui,SortFilterListViewModel * _owner) :
+			gui(_gui),shutdown(false),latestGeneration(0),appliedGeneration(0),owner(_owner) {}
+};
+
+//! (ctor)
+SortFilterListViewModel::SortFilterListViewModel(ListView & _view,const Util::Reference<AbstractListViewModel> & _source,size_t _threadCount) :
+		AbstractListViewModel(),view(&_view),viewDestructionListener(0),source(_source),identity(true),asyncThreshold(10000),
+		threadCount(std::max(static_cast<size_t>(1),_threadCount)),state(std::make_shared<SharedState>(_view.getGUI(),this)) {
+	if(source.isNull())
+		throw std::invalid_argument("SortFilterListViewModel: No source given.");
+	// the model may outlive the ListView
+	viewDestructionListener = state->gui.addComponentDestructionListener(view,[this]() {	view = nullptr;	});
+}
+
+//! (dtor)
+SortFilterListViewModel::~SortFilterListViewModel(){
+	state->owner = nullptr; // an already posted result is ignored
+	if(view!=nullptr)
+		state->gui.removeComponentDestructionListener(view,std::move(viewDestructionListener));
+	if(backgroundThread.joinable()){
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->shutdown = true;
+			state->pendingJob.reset();
+		}
+		++state->latestGeneration; // cancel a running job
+		state->jobAvailable.notify_all();
+		backgroundThread.join();
+	}
+}
+
+void SortFilterListViewModel::setFilter(filter_t newFilter){
+	filter = std::move(newFilter);
+	evaluate();
+}
+
+void SortFilterListViewModel::setSorting(less_t newLess){
+	less = std::move(newLess);
+	evaluate();
+}
+
+void SortFilterListViewModel::sourceChanged(){
+	const size_t count = source->getRowCount();
+	if(!identity && count<sourceToRow.size()){ // until the new result is available, the removed source rows are hidden
+		rows.erase(std::remove_if(rows.begin(),rows.end(),[count](size_t sourceRow){	return sourceRow>=count;	}),rows.end());
+		sourceToRow.resize(count);
+		for(size_t row=0;row<rows.size();++row)
+			sourceToRow[rows[row]] = row;
+		if(view!=nullptr && view->getModel()==this)
+			view->modelChanged();
+	}
+	evaluate();
+}
+
+bool SortFilterListViewModel::isEvaluating()const{
+	return state->appliedGeneration!=state->latestGeneration.load();
+}
+
+//! (internal)
+void SortFilterListViewModel::evaluate(){
+	const uint64_t generation = ++state->latestGeneration;
+	if(!filter && !less){
+		Result result;
+		result.generation = generation;
+		result.identity = true;
+		applyResult(result);
+		return;
+	}
+	std::unique_ptr<Job> job(new Job{generation,source->getRowCount(),filter,less});
+	if(job->sourceCount<asyncThreshold){
+		Result result;
+		execute(*job,*state,nullptr,result);
+		applyResult(result);
+		return;
+	}
+	if(!backgroundThread.joinable())
+		backgroundThread = std::thread(&SortFilterListViewModel::backgroundMain,state,threadCount);
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->pendingJob = std::move(job); // replaces a job that has not been started yet
+	}
+	state->jobAvailable.notify_one();
+}
+
+//! (internal)
+void SortFilterListViewModel::applyResult(Result & result){
+	if(result.generation!=state->latestGeneration.load()) // outdated; a newer result follows
+		return;
+	state->appliedGeneration = result.generation;
+
+	// the markings and the cursor stay at their source rows
+	ListView * listView = (view!=nullptr && view->getModel()==this) ? view : nullptr;
+	std::vector<size_t> markedSourceRows;
+	size_t cursorSourceRow = npos;
+	if(listView!=nullptr){
+		const size_t count = getRowCount();
+		for(const auto row : listView->getMarkedIndices()){
+			if(row<count)
+				markedSourceRows.push_back(getSourceRow(row));
+		}
+		if(listView->getCursorIndex()<count)
+			cursorSourceRow = getSourceRow(listView->getCursorIndex());
+	}
+
+	identity = result.identity;
+	rows.swap(result.rows);
+	sourceToRow.swap(result.sourceToRow);
+	if(listView==nullptr)
+		return;
+
+	std::vector<size_t> markedRows;
+	for(const auto sourceRow : markedSourceRows){
+		const size_t row = getRow(sourceRow);
+		if(row!=npos)
+			markedRows.push_back(row);
+	}
+	listView->modelChanged(markedRows);
+	const size_t cursor = cursorSourceRow==npos ? npos : getRow(cursorSourceRow);
+	if(cursor!=npos)
+		listView->setCursorIndex(cursor);
+}
+
+//! (internal)
+bool SortFilterListViewModel::execute(const Job & job,const SharedState & state,WorkerPool * pool,Result & result){
+	const auto canceled = [&]() {	return state.latestGeneration.load(std::memory_order_relaxed)!=job.generation;	};
+	const size_t sourceCount = job.sourceCount;
+	std::vector<WorkerPool::task_t> tasks;
+
+	// filter: every task collects the accepted rows of a chunk of the source rows
+	std::vector<std::vector<size_t>> acceptedRows((sourceCount+chunkSize-1)/chunkSize);
+	for(size_t chunk=0;chunk<acceptedRows.size();++chunk){
+		tasks.emplace_back([&,chunk]() {
+			if(canceled())
+				return;
+			const size_t end = std::min(sourceCount,(chunk+1)*chunkSize);
+			for(size_t sourceRow=chunk*chunkSize;sourceRow<end;++sourceRow){
+				if(!job.filter || job.filter(sourceRow))
+					acceptedRows[chunk].push_back(sourceRow);
+			}
+		});
+	}
+	runTasks(pool,tasks);
+	if(canceled())
+		return false;
+	size_t count = 0;
+	for(const auto & accepted : acceptedRows)
+		count += accepted.size();
+	auto & rows = result.rows;
+	rows.reserve(count);
+	for(auto & accepted : acceptedRows){
+		rows.insert(rows.end(),accepted.begin(),accepted.end());
+		std::vector<size_t>().swap(accepted);
+	}
+
+	// sort: the parts are sorted concurrently and then merged pairwise
+	if(job.less){
+		const size_t partCount = std::max(static_cast<size_t>(1),std::min(pool!=nullptr ? pool->getThreadCount() : 1,count/chunkSize));
+		std::vector<size_t> bounds;
+		for(size_t part=0;part<=partCount;++part)
+			bounds.push_back(count*part/partCount);
+		for(size_t part=0;part<partCount;++part){
+			tasks.emplace_back([&,part]() {
+				std::stable_sort(rows.begin()+bounds[part],rows.begin()+bounds[part+1],job.less);
+			});
+		}
+		runTasks(pool,tasks);
+		for(size_t width=1;width<partCount;width*=2){
+			if(canceled())
+				return false;
+			for(size_t part=0;part+width<partCount;part+=2*width){
+				tasks.emplace_back([&,part,width]() {
+					std::inplace_merge(rows.begin()+bounds[part],rows.begin()+bounds[part+width],
+									   rows.begin()+bounds[std::min(part+2*width,partCount)],job.less);
+				});
+			}
+			runTasks(pool,tasks);
+		}
+		if(canceled())
+			return false;
+	}
+
+	// inverse mapping
+	result.sourceToRow.assign(sourceCount,npos);
+	for(size_t begin=0;begin<count;begin+=chunkSize){
+		tasks.emplace_back([&,begin]() {
+			const size_t end = std::min(count,begin+chunkSize);
+			for(size_t row=begin;row<end;++row)
+				result.sourceToRow[rows[row]] = row;
+		});
+	}
+	runTasks(pool,tasks);
+	result.generation = job.generation;
+	result.identity = false;
+	return !canceled();
+}
+
+//! (internal)
+void SortFilterListViewModel::backgroundMain(std::shared_ptr<SharedState> state,size_t threadCount){
+	WorkerPool pool(threadCount);
+	while(true){
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(state->mutex);
+			state->jobAvailable.wait(lock,[&](){	return state->shutdown || state->pendingJob;	});
+			if(state->shutdown)
+				return;
+			job = std::move(state->pendingJob);
+		}
+		std::shared_ptr<Result> result = std::make_shared<Result>();
+		try{
+			if(!execute(*job,*state,&pool,*result))
+				continue;
+		}catch(const std::exception & e){
+			WARN(std::string("SortFilterListViewModel: ")+e.what());
+			continue;
+		}
+		// the result is applied by the GUI's thread at the beginning of a frame
+		state->gui.post([state,result]() {
+			if(state->owner!=nullptr)
+				state->owner->applyResult(*result);
+		});
+	}
+}
+
+}
@@ -0,0 +1,116 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_SORT_FILTER_LIST_VIEW_MODEL_H
+#define GUI_SORT_FILTER_LIST_VIEW_MODEL_H
+
+#include "AbstractListViewModel.h"
+#include "../Base/Listener.h"
+#include <Util/References.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace GUI{
+
+class ListView;
+class WorkerPool;
+/*! Sorted and filtered view on the rows of another AbstractListViewModel (the source).
+	The rows are not copied: The model only keeps the array of the accepted source rows in their sorted order
+	(and its inverse), so changing the filter or the sorting does not create, remove or move components.
+	Usage: Create the model for a ListView and set it as the ListView's model (ListView::setModel()).
+
+	If the source has at least getAsyncThreshold() rows, the arrays are created by a background thread,
+	which filters the rows in chunks and sorts them with a parallel merge sort on its own WorkerPool. The result
+	is posted to the GUI (GUI_Manager::post()) and applied at the beginning of a frame as a whole. A new filter
+	or sorting cancels a running evaluation; until its result is available, the ListView shows the old one.
+	When a result is applied, the marked rows and the cursor stay at the same source rows (if they are still accepted).
+	\note The filter and the comparison function are called concurrently by several threads. They must not
+		access data that is changed while an evaluation is running.	*/
+class SortFilterListViewModel : public AbstractListViewModel {
+		PROVIDES_TYPE_NAME(SortFilterListViewModel)
+
+	public:
+		//! Returns true if the source row is shown.
+		typedef std::function<bool (size_t sourceRow)> filter_t;
+		//! Returns true if @p sourceRow1 is shown in front of @p sourceRow2; rows with equal rank keep the source's order.
+		typedef std::function<bool (size_t sourceRow1,size_t sourceRow2)> less_t;
+
+		static const size_t npos = static_cast<size_t>(-1);
+
+		/*! @p threadCount is the number of threads used for an evaluation in the background (including the background thread;
+			at least one); the threads are only started on demand.	*/
+		GUIAPI SortFilterListViewModel(ListView & view,const Util::Reference<AbstractListViewModel> & source,
+									   size_t threadCount=std::thread::hardware_concurrency());
+		GUIAPI virtual ~SortFilterListViewModel();
+
+		AbstractListViewModel * getSource()const			{	return source.get();	}
+
+		//! Show only the source rows accepted by @p filter (nullptr: all rows).
+		GUIAPI void setFilter(filter_t filter);
+		//! Sort the rows using @p less (nullptr: the source's order).
+		GUIAPI void setSorting(less_t less);
+		//! Has to be called when the source's rows have changed; the filter and the sorting are applied again.
+		GUIAPI void sourceChanged();
+
+		//! Returns true while a new result is evaluated in the background.
+		GUIAPI bool isEvaluating()const;
+		//! Sources with fewer rows are filtered and sorted synchronously (default: 10000).
+		size_t getAsyncThreshold()const						{	return asyncThreshold;	}
+		void setAsyncThreshold(size_t rows)					{	asyncThreshold = rows;	}
+
+		//! The source row shown in the given row.
+		size_t getSourceRow(size_t row)const				{	return identity ? row : rows.at(row);	}
+		//! The row showing the given source row or npos if it is not accepted by the filter.
+		size_t getRow(size_t sourceRow)const {
+			return identity ? (sourceRow<source->getRowCount() ? sourceRow : npos) :
+					(sourceRow<sourceToRow.size() ? sourceToRow[sourceRow] : npos);
+		}
+
+		// ---|> AbstractListViewModel
+		size_t getRowCount()const override					{	return identity ? source->getRowCount() : rows.size();	}
+		Component::Ref createRow(GUI_Manager & gui) override	{	return source->createRow(gui);	}
+		void updateRow(Component & row,size_t index) override	{	source->updateRow(row,getSourceRow(index));	}
+		std::string getRowText(size_t index)const override	{	return source->getRowText(getSourceRow(index));	}
+
+	private:
+		struct Job;
+		struct Result;
+		struct SharedState;
+
+		//! (internal) Start the evaluation of the current filter and sorting.
+		void evaluate();
+		//! (internal) Replace the rows by the given result and inform the ListView.
+		void applyResult(Result & result);
+		//! (internal) Filter and sort the rows; returns false if the job has been canceled meanwhile.
+		static bool execute(const Job & job,const SharedState & state,WorkerPool * pool,Result & result);
+		//! (internal) Main function of the background thread.
+		static void backgroundMain(std::shared_ptr<SharedState> state,size_t threadCount);
+
+		ListView * view; // nullptr after the ListView's destruction
+		ComponentDestructionListenerHandle viewDestructionListener;
+		Util::Reference<AbstractListViewModel> source;
+		filter_t filter;
+		less_t less;
+		std::vector<size_t> rows; // rows[row] is the source row (unused if identity is set)
+		std::vector<size_t> sourceToRow; // inverse of rows (npos for not accepted source rows)
+		bool identity; // no filter and no sorting
+		size_t asyncThreshold;
+		size_t threadCount;
+		std::shared_ptr<SharedState> state;
+		std::thread backgroundThread;
+};
+
+}
+
+#endif // GUI_SORT_FILTER_LIST_VIEW_MODEL_H
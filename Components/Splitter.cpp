@@ -61,19 +61,21 @@ class StackingLayouter : public AbstractLayouter{
 		
 		//! ---|> AbstractLayouter
 		void layout(Util::WeakPointer<Component> component) override{
-			Container * container = dynamic_cast<Container*>(component.get());
+			Container * container = castTo<Container>(component.get());
 			if(!container){
 				throw std::invalid_argument("FlowLayouter can only be applied to Containers.");
 			}
 			if(vertical){
 				float x = 0;
-				for(Component * c=container->getFirstChild();c!=nullptr;c=c->getNext()){
+				for(const auto & childRef : container->getChildren()){
+					Component * c = childRef.get();
 					c->setPosition( Geometry::Vec2(x,0));
 					x+=c->getWidth();
 				}
 			}else{
 				float y = 0;
-				for(Component * c=container->getFirstChild();c!=nullptr;c=c->getNext()){
+				for(const auto & childRef : container->getChildren()){
+					Component * c = childRef.get();
 					c->setPosition( Geometry::Vec2(0,y));
 					y+=c->getHeight();
 				}
@@ -30,6 +30,9 @@ const Util::StringIdentifier TabbedPanel::Tab::ACTION_Tab_open("ACTION_Tab_open"
  **  TabTitlePanel ---|> Container ---|> Component
  **/
 struct TabTitlePanel : public Container {
+	static const kind_t KIND=Container::KIND|KIND_TAB_TITLE_PANEL;
+	typedef TabTitlePanel kindClass_t;
+
 	TabbedPanel::Tab & myTab;
 	KeyListener keyListener;
 	MouseButtonListener mouseButtonListener;
@@ -39,6 +42,7 @@ struct TabTitlePanel : public Container {
 			keyListener(createKeyListener(_gui, this, &TabTitlePanel::onKeyEvent)),
 			mouseButtonListener(createMouseButtonListener(_gui, this, &TabTitlePanel::onMouseButton)),
 			optionalMouseMotionListener(createOptionalMouseMotionListener(_gui, this, &TabTitlePanel::onMouseMove)) {
+		addKind(KIND);
 		setFlag(SELECTABLE,true);
 	}
 	virtual ~TabTitlePanel() = default;
@@ -61,9 +65,9 @@ struct TabTitlePanel : public Container {
 		}else if(keyEvent.key==Util::UI::KEY_LEFT) {
 			TabbedPanel::Tab * t=getTab();
 			if (t->getPrev())
-				t=dynamic_cast<TabbedPanel::Tab *>(t->getPrev());
+				t=castTo<TabbedPanel::Tab>(t->getPrev());
 			else
-				t=dynamic_cast<TabbedPanel::Tab *>(getTab()->getTabbedPanel()->getLastChild());
+				t=castTo<TabbedPanel::Tab>(getTab()->getTabbedPanel()->getLastChild());
 			if(t){
 //			    t->makeActiveTab();
 				t->getTitlePanel()->select();
@@ -72,9 +76,9 @@ struct TabTitlePanel : public Container {
 		}else if(keyEvent.key==Util::UI::KEY_RIGHT) {
 			TabbedPanel::Tab * t=getTab();
 			if (t->getNext())
-				t=dynamic_cast<TabbedPanel::Tab *>(t->getNext());
+				t=castTo<TabbedPanel::Tab>(t->getNext());
 			else
-				t=dynamic_cast<TabbedPanel::Tab *>(getTab()->getTabbedPanel()->getFirstChild());
+				t=castTo<TabbedPanel::Tab>(getTab()->getTabbedPanel()->getFirstChild());
 			if(t){
 //			    t->makeActiveTab();
 				t->getTitlePanel()->select();
@@ -115,7 +119,7 @@ struct TabTitlePanel : public Container {
 			return false;
 		}
 		const Geometry::Vec2 absPos = Geometry::Vec2(motionEvent.x, motionEvent.y);
-		TabTitlePanel * ttp=dynamic_cast<TabTitlePanel *>(getGUI().getComponentAtPos(absPos));
+		TabTitlePanel * ttp=castTo<TabTitlePanel>(getGUI().getComponentAtPos(absPos));
 		if (ttp) {// replace another tab
 			if ( ttp==this)
 				return true;
@@ -141,7 +145,7 @@ struct TabTitlePanel : public Container {
 			return true;
 		}
 
-		TabbedPanel * tp=dynamic_cast<TabbedPanel *>(getGUI().getComponentAtPos(absPos));
+		TabbedPanel * tp=castTo<TabbedPanel>(getGUI().getComponentAtPos(absPos));
 		if (tp==nullptr)
 			return true;
 //                    tp->insertTab(&myTab,0);
@@ -187,6 +191,7 @@ struct TabTitlePanel : public Container {
 //! (Tab] [ctor)
 TabbedPanel::Tab::Tab(GUI_Manager & _gui,const std::string & _title,Container * _clientArea/*=0*/)
 		:Container(_gui),clientAreaPanel(_clientArea),titlePanel(nullptr),titleTextLabel(nullptr) {
+	addKind(KIND);
 	setFlag(TRANSPARENT_COMPONENT,true);
 
 	setFlag(AUTO_MAXIMIZE,true);
@@ -271,7 +276,7 @@ bool TabbedPanel::Tab::isActiveTab()const {
 
 //! (Tab)
 TabbedPanel * TabbedPanel::Tab::getTabbedPanel()const {
-	return dynamic_cast<TabbedPanel * >(getParent());
+	return castTo<TabbedPanel>(getParent());
 }
 
 //! (Tab)
@@ -290,7 +295,7 @@ void TabbedPanel::Tab::makeActiveTab() {
 //! (ctor)
 TabbedPanel::TabbedPanel(GUI_Manager & _gui,flag_t _flags/*=0*/) : 
 		Container(_gui,_flags),activeTab(nullptr) {
-	//ctor
+	addKind(KIND);
 }
 
 
@@ -325,7 +330,7 @@ void TabbedPanel::setActiveTab(Tab * tab) {
 
 //! ----|> Component
 void TabbedPanel::bringChildToFront(Component * c) {
-	Tab * t=dynamic_cast<Tab *>(c);
+	Tab * t=castTo<Tab>(c);
 	if (c)
 		setActiveTab(t);
 	bringToFront();
@@ -334,7 +339,7 @@ void TabbedPanel::bringChildToFront(Component * c) {
 void TabbedPanel::recalculateTabTitlePositions() {
 	float pos=5;
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		Tab * t=dynamic_cast<Tab*>(c);
+		Tab * t=castTo<Tab>(c);
 		if (t!=nullptr) {
 			t->setTabTitlePos(pos);
 			pos+=t->getTabTitleWidth()+1;
@@ -347,7 +352,7 @@ void TabbedPanel::recalculateTabTitlePositions() {
 //! ----|> Component
 void TabbedPanel::doLayout() {
 	if ( activeTab==nullptr || activeTab->getParent()!=this ) {
-		setActiveTab(dynamic_cast<Tab*>(getLastChild()));
+		setActiveTab(castTo<Tab>(getLastChild()));
 	}
 	
 }
@@ -367,7 +372,7 @@ void TabbedPanel::removeContent(const Ref & child) {
 void TabbedPanel::setActiveTabIndex(int nr){
 	int currentIndex=0;
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		Tab * t=dynamic_cast<Tab*>(c);
+		Tab * t=castTo<Tab>(c);
 		if (t!=nullptr) {
 			if(currentIndex == nr){
 				setActiveTab(t);
@@ -381,7 +386,7 @@ void TabbedPanel::setActiveTabIndex(int nr){
 int TabbedPanel::getActiveTabIndex()const{
 	int currentIndex=0;
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		const Tab * t=dynamic_cast<const Tab*>(c);
+		const Tab * t=castTo<Tab>(c);
 		if (t!=nullptr) {
 			if( t==activeTab ){
 				return currentIndex;
@@ -22,6 +22,8 @@ namespace GUI {
 class TabbedPanel : public Container {
 		PROVIDES_TYPE_NAME(TabbedPanel)
 	public:
+		static const kind_t KIND=Container::KIND|KIND_TABBED_PANEL;
+		typedef TabbedPanel kindClass_t;
 
 		/***
 		 **     Tab ---|> Container ---|> Component
@@ -30,6 +32,9 @@ class TabbedPanel : public Container {
 		class Tab : public Container {
 				PROVIDES_TYPE_NAME(Tab)
 			public:
+				static const kind_t KIND=Container::KIND|KIND_TAB;
+				typedef Tab kindClass_t;
+
 				GUIAPI static const Util::StringIdentifier ACTION_Tab_close;
 				GUIAPI static const Util::StringIdentifier ACTION_Tab_open;
 
@@ -0,0 +1,668 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Table.h"
+#include "../GUI_Manager.h"
+#include "../Base/AbstractShape.h"
+#include "../Base/Draw.h"
+#include "../Base/StyleManager.h"
+#include "ComponentPropertyIds.h"
+#include "Scrollbar.h"
+#include "Textfield.h"
+#include <Util/UI/Event.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace GUI {
+
+//! Distance from a column's border in which the border can be dragged.
+static const float resizeBorderSize = 3.0f;
+static const float minColumnWidth = 8.0f;
+static const float cellPadding = 2.0f;
+
+/***
+ **     Table::CellEditor ---|> Textfield ---|> Component
+ **/
+class Table::CellEditor : public Textfield {
+	public:
+		CellEditor(GUI_Manager & _gui,Table & _table,const std::string & text) : Textfield(_gui,text),table(&_table) {}
+		virtual ~CellEditor() {}
+
+		void _detach()										{	table = nullptr;	}
+
+		// ---|> Textfield
+		virtual bool onUnselect() override {
+			const bool result = Textfield::onUnselect();
+			if(table!=nullptr)
+				table->editingFinished();
+			return result;
+		}
+	private:
+		Table * table;
+};
+
+//! (ctor)
+Table::Table(GUI_Manager & _gui,flag_t _flags/*=0*/) :
+		Container(_gui,_flags),
+		keyListener(createKeyListener(_gui, this, &Table::onKeyEvent)),
+		mouseButtonListener(createMouseButtonListener(_gui, this, &Table::onMouseButton)),
+		optionalMouseMotionListener(createOptionalMouseMotionListener(_gui, this, &Table::onMouseMove)),
+		rowHeight(_gui.getGlobalValue(PROPERTY_TABLE_DEFAULT_ROW_HEIGHT)),
+		headerHeight(_gui.getGlobalValue(PROPERTY_TABLE_DEFAULT_ROW_HEIGHT)+2),
+		defaultColumnWidth(_gui.getGlobalValue(PROPERTY_TABLE_DEFAULT_COLUMN_WIDTH)),
+		resizedColumn(npos),
+		sortColumn(npos),sortAscending(true),
+		cursorRow(0),cursorColumn(0),
+		editedRow(npos),editedColumn(npos),editorOutdated(false) {
+	columnOffsets.push_back(0);
+	setFlag(SELECTABLE,true);
+	setFlag(USE_SCISSOR,true);
+	setFlag(LOWERED_BORDER,true);
+}
+
+//! (dtor)
+Table::~Table() {
+	if(editor.isNotNull())
+		static_cast<CellEditor*>(editor.get())->_detach();
+	if(optionalVScrollBarListener)
+		getGUI().removeDataChangeListener(vScrollBar.get(),std::move(*optionalVScrollBarListener.get()));
+	if(optionalHScrollBarListener)
+		getGUI().removeDataChangeListener(hScrollBar.get(),std::move(*optionalHScrollBarListener.get()));
+}
+
+//! ---|> Component
+void Table::doLayout() {
+	if(editorOutdated) {
+		editorOutdated = false;
+		if(editor.isNotNull()) {
+			static_cast<CellEditor*>(editor.get())->_detach();
+			Component::destroy(editor.get());
+			editor = nullptr;
+		}
+		editedRow = editedColumn = npos;
+	}
+
+	const float scrollBarWidth = getGUI().getGlobalValue(PROPERTY_SCROLLBAR_WIDTH);
+	const Geometry::Vec2 contentSize(columnOffsets.back(),getRowCount()*rowHeight);
+	// the scroll bars take the place of the cells, so one may require the other
+	bool vertical = contentSize.y() > getHeight()-headerHeight;
+	const bool horizontal = contentSize.x() > getWidth() - (vertical ? scrollBarWidth : 0);
+	vertical = vertical || contentSize.y() > getHeight()-headerHeight-(horizontal ? scrollBarWidth : 0);
+	setScrollbarEnabled(true,vertical);
+	setScrollbarEnabled(false,horizontal);
+
+	const Geometry::Vec2 bodySize = getBodySize();
+	maxScrollPos = Geometry::Vec2(std::max(0.0f,contentSize.x()-bodySize.x()),std::max(0.0f,contentSize.y()-bodySize.y()));
+	scrollPos = Geometry::Vec2(std::min(std::max(0.0f,scrollPos.x()),maxScrollPos.x()),
+								std::min(std::max(0.0f,scrollPos.y()),maxScrollPos.y()));
+	if(vScrollBar.isNotNull()) {
+		vScrollBar->setRect(Geometry::Rect(getWidth()-scrollBarWidth-1,headerHeight,scrollBarWidth,bodySize.y()));
+		vScrollBar->setMaxScrollPos(static_cast<uint32_t>(maxScrollPos.y()));
+		vScrollBar->setScrollPos(static_cast<uint32_t>(scrollPos.y()));
+	}
+	if(hScrollBar.isNotNull()) {
+		hScrollBar->setRect(Geometry::Rect(0,getHeight()-scrollBarWidth-1,bodySize.x(),scrollBarWidth));
+		hScrollBar->setMaxScrollPos(static_cast<uint32_t>(maxScrollPos.x()));
+		hScrollBar->setScrollPos(static_cast<uint32_t>(scrollPos.x()));
+	}
+	updateEditorRect();
+}
+
+//! ---|> Component
+void Table::doDisplay(const Geometry::Rect & region) {
+	enableLocalDisplayProperties();
+	displayDefaultShapes();
+	if(isSelected()) {
+		Geometry::Rect r = getLocalRect();
+		r.changeSizeCentered(-2, -2);
+		getGUI().displayShape(PROPERTY_SELECTION_RECT_SHAPE,r);
+	}
+
+	if(model.isNotNull()) {
+		auto shape_markedRow = getGUI().getStyleManager().getShape(PROPERTY_TABLE_MARKED_ROW_SHAPE);
+		auto shape_cursor = getGUI().getStyleManager().getShape(PROPERTY_TABLE_CURSOR_SHAPE);
+		auto shape_header = getGUI().getStyleManager().getShape(PROPERTY_TABLE_HEADER_SHAPE);
+		AbstractFont * font = getGUI().getActiveFont(PROPERTY_DEFAULT_FONT);
+		const Util::Color4ub textColor = getGUI().getActiveColor(PROPERTY_TEXT_COLOR);
+		const Util::Color4ub gridColor = getGUI().getActiveColor(PROPERTY_TABLE_GRID_COLOR);
+
+		size_t firstRow, endRow, firstColumn, endColumn;
+		getRangeInView(firstRow,endRow,firstColumn,endColumn);
+		const Geometry::Vec2 bodySize = getBodySize();
+		const float rowsWidth = std::min(bodySize.x(),columnOffsets.back()-scrollPos.x());
+
+		// cells
+		for(size_t viewRow = firstRow; viewRow < endRow; ++viewRow) {
+			const size_t row = getModelRow(viewRow);
+			const float y = headerHeight + viewRow*rowHeight - scrollPos.y();
+			const bool marked = markedRows.contains(row);
+			if(marked)
+				shape_markedRow->display(Geometry::Rect(0,y,rowsWidth,rowHeight));
+			for(size_t column = firstColumn; column < endColumn; ++column) {
+				const Geometry::Rect cellRect(columnOffsets[column]-scrollPos.x(),y,columns[column].width,rowHeight);
+				if(columns[column].renderer.isNotNull()) {
+					columns[column].renderer->displayCell(getGUI(),*model.get(),row,column,cellRect,marked);
+				} else {
+					Geometry::Rect textRect(cellRect);
+					textRect.changeSizeCentered(-2*cellPadding,0);
+					Draw::drawText(model->getCellText(row,column),textRect,font,textColor);
+				}
+			}
+		}
+		if(isSelected() && cursorRow>=firstRow && cursorRow<endRow && cursorColumn>=firstColumn && cursorColumn<endColumn) {
+			shape_cursor->display(Geometry::Rect(columnOffsets[cursorColumn]-scrollPos.x(),
+									headerHeight + cursorRow*rowHeight - scrollPos.y(),columns[cursorColumn].width,rowHeight));
+		}
+
+		// column borders (as one batch of lines)
+		std::vector<float> lines;
+		std::vector<uint32_t> lineColors;
+		const float linesEnd = std::min(headerHeight+bodySize.y(),headerHeight+getRowCount()*rowHeight-scrollPos.y());
+		for(size_t column = firstColumn; column < endColumn; ++column) {
+			const float x = columnOffsets[column+1]-scrollPos.x()-0.5f;
+			lines.insert(lines.end(),{x,headerHeight,x,linesEnd});
+			lineColors.insert(lineColors.end(),{gridColor.getAsUInt(),gridColor.getAsUInt()});
+		}
+		if(!lines.empty())
+			Draw::drawLines(lines,lineColors);
+
+		// header
+		for(size_t column = firstColumn; column < endColumn; ++column) {
+			const Geometry::Rect headerRect(columnOffsets[column]-scrollPos.x(),0,columns[column].width,headerHeight);
+			shape_header->display(headerRect);
+			Geometry::Rect textRect(headerRect);
+			textRect.changeSizeCentered(-2*cellPadding,0);
+			Draw::drawText(model->getColumnTitle(column),textRect,font,textColor);
+			if(column==sortColumn && headerRect.getWidth()>headerHeight) { // triangle pointing up or down
+				const float s = headerHeight*0.25f;
+				const float cx = headerRect.getMaxX()-cellPadding-s;
+				const float cy = headerHeight*0.5f;
+				const float dy = sortAscending ? -s*0.5f : s*0.5f;
+				Draw::drawTriangleFan({cx-s,cy-dy, cx+s,cy-dy, cx,cy+dy},
+										std::vector<uint32_t>(3,textColor.getAsUInt()));
+			}
+		}
+	}
+	auto shape_scrollableMarkerTop = getGUI().getStyleManager().getShape(PROPERTY_SCROLLABLE_MARKER_TOP_SHAPE);
+	auto shape_scrollableMarkerBottom = getGUI().getStyleManager().getShape(PROPERTY_SCROLLABLE_MARKER_BOTTOM_SHAPE);
+	disableLocalDisplayProperties();
+
+	displayChildren(region,true);
+	if(scrollPos.y()>0)
+		shape_scrollableMarkerTop->display(Geometry::Rect(0,headerHeight,getWidth(),getHeight()-headerHeight));
+	if(scrollPos.y()<maxScrollPos.y())
+		shape_scrollableMarkerBottom->display(getLocalRect());
+}
+
+//! ---|> KeyListener
+bool Table::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
+	if(!keyEvent.pressed || model.isNull())
+		return true;
+	const size_t rowCount = getRowCount();
+	const size_t pageRows = std::max<size_t>(1,static_cast<size_t>(getBodySize().y()/rowHeight));
+	size_t row = cursorRow;
+	size_t column = cursorColumn;
+	switch(keyEvent.key) {
+		case Util::UI::KEY_TAB:
+			return false;
+		case Util::UI::KEY_UP:
+			row = row>0 ? row-1 : 0;
+			break;
+		case Util::UI::KEY_DOWN:
+			++row;
+			break;
+		case Util::UI::KEY_PAGEUP:
+			row = row>pageRows ? row-pageRows : 0;
+			break;
+		case Util::UI::KEY_PAGEDOWN:
+			row += pageRows;
+			break;
+		case Util::UI::KEY_HOME:
+			row = 0;
+			break;
+		case Util::UI::KEY_END:
+			row = rowCount;
+			break;
+		case Util::UI::KEY_LEFT:
+			column = column>0 ? column-1 : 0;
+			break;
+		case Util::UI::KEY_RIGHT:
+			++column;
+			break;
+		case Util::UI::KEY_RETURN:
+			editCell(cursorRow,cursorColumn);
+			return true;
+		case Util::UI::KEY_SPACE:
+			if(cursorRow<rowCount) {
+				const size_t modelRow = getModelRow(cursorRow);
+				if(isRowMarked(modelRow))
+					unmarkRow(modelRow);
+				else
+					markRow(modelRow);
+				markingChanged();
+			}
+			return true;
+		default:
+			return true;
+	}
+	if(rowCount==0)
+		return true;
+	row = std::min(row,rowCount-1);
+	column = std::min(column,columns.empty() ? 0 : columns.size()-1);
+	if(row!=cursorRow && !getGUI().isCtrlPressed()) { // move the marking with the cursor
+		clearMarkings();
+		markRow(getModelRow(row));
+		markingChanged();
+	}
+	setCursor(row,column);
+	scrollToCell(row,column);
+	return true;
+}
+
+bool Table::onMouseButton(Component * /*component*/, const Util::UI::ButtonEvent & buttonEvent) {
+	const Geometry::Vec2 localPos = Geometry::Vec2(buttonEvent.x, buttonEvent.y) - getAbsPosition();
+	if(buttonEvent.button == Util::UI::MOUSE_BUTTON_LEFT && !buttonEvent.pressed) {
+		if(resizedColumn!=npos) {
+			resizedColumn = npos;
+			optionalMouseMotionListener.disable();
+		}
+		return true;
+	}
+	if(!buttonEvent.pressed)
+		return false;
+	if(buttonEvent.button == Util::UI::MOUSE_WHEEL_UP) {
+		scrollTo(scrollPos - Geometry::Vec2(0,rowHeight*3));
+		return true;
+	} else if(buttonEvent.button == Util::UI::MOUSE_WHEEL_DOWN) {
+		scrollTo(scrollPos + Geometry::Vec2(0,rowHeight*3));
+		return true;
+	} else if(buttonEvent.button != Util::UI::MOUSE_BUTTON_LEFT || model.isNull()) {
+		return false;
+	}
+	select();
+
+	const float x = localPos.x()+scrollPos.x();
+	if(localPos.y()<headerHeight) {
+		// a column's right border? -> resize
+		const size_t column = getColumnAt(x);
+		const size_t left = column!=npos ? column : columns.size();
+		if(left>0 && x-columnOffsets[left]<resizeBorderSize) {
+			resizedColumn = left-1;
+		} else if(column!=npos && columnOffsets[column+1]-x<resizeBorderSize) {
+			resizedColumn = column;
+		} else if(column!=npos) {
+			sortByColumn(column, column==sortColumn ? !sortAscending : true);
+			return true;
+		}
+		if(resizedColumn!=npos)
+			optionalMouseMotionListener.enable();
+		return true;
+	}
+
+	const float y = localPos.y()-headerHeight+scrollPos.y();
+	const size_t column = getColumnAt(x);
+	const size_t viewRow = static_cast<size_t>(y/rowHeight);
+	if(column==npos || viewRow>=getRowCount())
+		return true;
+	const size_t row = getModelRow(viewRow);
+	if(getGUI().isCtrlPressed()) {
+		if(isRowMarked(row))
+			unmarkRow(row);
+		else
+			markRow(row);
+	} else if(getGUI().isShiftPressed()) {
+		clearMarkings();
+		const size_t first = std::min(cursorRow,viewRow);
+		const size_t end = std::min(std::max(cursorRow,viewRow)+1,getRowCount());
+		if(rowOrder.empty()) {
+			markedRows.add(first,end);
+		} else { // the model's rows of the range are not consecutive
+			for(size_t r = first; r<end; ++r)
+				markedRows.add(rowOrder[r],rowOrder[r]+1);
+		}
+		invalidateRegion();
+	} else if(viewRow==cursorRow && column==cursorColumn && isRowMarked(row)) {
+		// a second click into the active cell starts editing
+		editCell(viewRow,column);
+		return true;
+	} else {
+		clearMarkings();
+		markRow(row);
+	}
+	markingChanged();
+	if(!getGUI().isShiftPressed())
+		setCursor(viewRow,column);
+	return true;
+}
+
+bool Table::onMouseMove(Component * /*component*/, const Util::UI::MotionEvent & motionEvent) {
+	if(resizedColumn==npos || !(motionEvent.buttonMask & Util::UI::MASK_MOUSE_BUTTON_LEFT)) {
+		resizedColumn = npos;
+		optionalMouseMotionListener.disable();
+		return false;
+	}
+	const float x = motionEvent.x - getAbsPosition().x() + scrollPos.x();
+	setColumnWidth(resizedColumn,x-columnOffsets[resizedColumn]);
+	return true;
+}
+
+// -------------------------------------------------------------------
+// Model
+
+void Table::setModel(const Util::Reference<AbstractTableModel> & m) {
+	if(m == model)
+		return;
+	if(editor.isNotNull()) {
+		static_cast<CellEditor*>(editor.get())->_detach();
+		editorOutdated = true;
+	}
+	model = m;
+	columns.clear();
+	markedRows.clear();
+	sortColumn = npos;
+	rowOrder.clear();
+	viewRows.clear();
+	cursorRow = cursorColumn = 0;
+	scrollPos = Geometry::Vec2(0,0);
+	modelChanged();
+}
+
+void Table::modelChanged() {
+	updateColumns();
+	const size_t rowCount = getRowCount();
+	// keep the cursor on the same row of the model
+	const size_t cursorModelRow = rowOrder.empty() ? cursorRow : (cursorRow<rowOrder.size() ? rowOrder[cursorRow] : npos);
+	if(sortColumn!=npos)
+		updateRowOrder();
+	if(!markedRows.empty() && markedRows.back()>=rowCount) {
+		markedRows.remove(rowCount,markedRows.back()+1);
+		markingChanged();
+	}
+	if(cursorModelRow<rowCount)
+		cursorRow = getViewRow(cursorModelRow);
+	else if(cursorRow>=rowCount)
+		cursorRow = rowCount>0 ? rowCount-1 : 0;
+	if(editor.isNotNull()) { // the edited cell may be gone
+		static_cast<CellEditor*>(editor.get())->_detach();
+		editorOutdated = true;
+	}
+	invalidateLayout();
+	invalidateRegion();
+}
+
+// -------------------------------------------------------------------
+// Columns and rows
+
+//! (internal)
+void Table::updateColumns() {
+	const size_t count = model.isNotNull() ? model->getColumnCount() : 0;
+	if(count==columns.size())
+		return;
+	const size_t firstNewColumn = std::min(count,columns.size());
+	columns.resize(count,Column(defaultColumnWidth));
+	if(sortColumn!=npos && sortColumn>=count) {
+		sortColumn = npos;
+		rowOrder.clear();
+		viewRows.clear();
+	}
+	if(cursorColumn>=count)
+		cursorColumn = count>0 ? count-1 : 0;
+	updateColumnOffsets(firstNewColumn);
+}
+
+//! (internal)
+void Table::updateColumnOffsets(size_t firstColumn) {
+	columnOffsets.resize(columns.size()+1);
+	for(size_t i = firstColumn; i<columns.size(); ++i)
+		columnOffsets[i+1] = columnOffsets[i]+columns[i].width;
+}
+
+void Table::setColumnWidth(size_t column,float width) {
+	width = std::max(width,minColumnWidth);
+	if(column>=columns.size() || columns[column].width==width)
+		return;
+	columns[column].width = width;
+	updateColumnOffsets(column);
+	invalidateLayout();
+	invalidateRegion();
+}
+
+void Table::setCellRenderer(size_t column,const Util::Reference<AbstractTableCellRenderer> & renderer) {
+	columns.at(column).renderer = renderer;
+	invalidateRegion();
+}
+
+void Table::setRowHeight(float h) {
+	if(h<=0)
+		throw std::invalid_argument("Table::setRowHeight: The height has to be positive.");
+	rowHeight = h;
+	invalidateLayout();
+	invalidateRegion();
+}
+
+//! (internal)
+size_t Table::getColumnAt(float x)const {
+	if(x<0 || x>=columnOffsets.back())
+		return npos;
+	return static_cast<size_t>(std::upper_bound(columnOffsets.begin(),columnOffsets.end(),x)-columnOffsets.begin())-1;
+}
+
+//! (internal)
+void Table::getRangeInView(size_t & firstRow,size_t & endRow,size_t & firstColumn,size_t & endColumn)const {
+	const Geometry::Vec2 bodySize = getBodySize();
+	const size_t rowCount = getRowCount();
+	firstRow = std::min(rowCount,static_cast<size_t>(scrollPos.y()/rowHeight));
+	endRow = std::min(rowCount,static_cast<size_t>((scrollPos.y()+bodySize.y())/rowHeight)+1);
+
+	// the offsets are sorted -> binary search
+	firstColumn = static_cast<size_t>(std::upper_bound(columnOffsets.begin(),columnOffsets.end(),scrollPos.x())-columnOffsets.begin());
+	firstColumn = std::min(firstColumn>0 ? firstColumn-1 : 0,columns.size());
+	endColumn = static_cast<size_t>(std::lower_bound(columnOffsets.begin(),columnOffsets.end(),scrollPos.x()+bodySize.x())-columnOffsets.begin());
+	endColumn = std::max(firstColumn,std::min(endColumn,columns.size()));
+}
+
+// -------------------------------------------------------------------
+// Sorting
+
+void Table::sortByColumn(size_t column,bool ascending) {
+	if(column!=npos && column>=columns.size())
+		throw std::out_of_range("Table::sortByColumn: Invalid column.");
+	// keep the row under the cursor
+	const size_t cursorModelRow = cursorRow<getRowCount() ? getModelRow(cursorRow) : npos;
+	sortColumn = column;
+	sortAscending = ascending;
+	updateRowOrder();
+	if(cursorModelRow!=npos) {
+		cursorRow = getViewRow(cursorModelRow);
+		scrollToCell(cursorRow,cursorColumn);
+	}
+	invalidateRegion();
+	updateEditorRect();
+}
+
+//! (internal)
+void Table::updateRowOrder() {
+	if(sortColumn==npos || model.isNull()) {
+		rowOrder.clear();
+		viewRows.clear();
+		return;
+	}
+	const size_t rowCount = model->getRowCount();
+	rowOrder.resize(rowCount);
+	for(size_t i = 0; i<rowCount; ++i)
+		rowOrder[i] = i;
+	const AbstractTableModel & m = *model.get();
+	const size_t column = sortColumn;
+	if(sortAscending)
+		std::stable_sort(rowOrder.begin(),rowOrder.end(),[&m,column](size_t a,size_t b){	return m.isLess(a,b,column);	});
+	else
+		std::stable_sort(rowOrder.begin(),rowOrder.end(),[&m,column](size_t a,size_t b){	return m.isLess(b,a,column);	});
+	viewRows.resize(rowCount);
+	for(size_t i = 0; i<rowCount; ++i)
+		viewRows[rowOrder[i]] = i;
+}
+
+// -------------------------------------------------------------------
+// Markings and cursor
+
+void Table::markRow(size_t modelRow) {
+	if(modelRow<getRowCount() && !markedRows.contains(modelRow)) {
+		markedRows.add(modelRow,modelRow+1);
+		invalidateRegion();
+	}
+}
+
+void Table::unmarkRow(size_t modelRow) {
+	if(markedRows.contains(modelRow)) {
+		markedRows.remove(modelRow,modelRow+1);
+		invalidateRegion();
+	}
+}
+
+void Table::clearMarkings() {
+	if(!markedRows.empty()) {
+		markedRows.clear();
+		invalidateRegion();
+	}
+}
+
+void Table::markingChanged() {
+	getGUI().componentDataChanged(this);
+}
+
+void Table::setCursor(size_t viewRow,size_t column) {
+	if(viewRow==cursorRow && column==cursorColumn)
+		return;
+	cursorRow = viewRow;
+	cursorColumn = column;
+	invalidateRegion();
+}
+
+void Table::scrollToCell(size_t viewRow,size_t column) {
+	const Geometry::Vec2 bodySize = getBodySize();
+	Geometry::Vec2 pos = scrollPos;
+	const float y = viewRow*rowHeight;
+	if(y<pos.y())
+		pos.y(y);
+	else if(y+rowHeight>pos.y()+bodySize.y())
+		pos.y(y+rowHeight-bodySize.y());
+	if(column<columns.size()) {
+		if(columnOffsets[column]<pos.x())
+			pos.x(columnOffsets[column]);
+		else if(columnOffsets[column+1]>pos.x()+bodySize.x())
+			pos.x(std::min(columnOffsets[column],columnOffsets[column+1]-bodySize.x()));
+	}
+	scrollTo(pos);
+}
+
+// -------------------------------------------------------------------
+// Editing
+
+bool Table::editCell(size_t viewRow,size_t column) {
+	if(model.isNull() || viewRow>=getRowCount() || column>=columns.size())
+		return false;
+	const size_t row = getModelRow(viewRow);
+	if(!model->isCellEditable(row,column))
+		return false;
+	if(editor.isNotNull()) { // finish the previous editing
+		editor->unselect();
+		if(editor.isNotNull()) {
+			static_cast<CellEditor*>(editor.get())->_detach();
+			Component::destroy(editor.get());
+			editor = nullptr;
+		}
+	}
+	editorOutdated = false;
+	editedRow = row;
+	editedColumn = column;
+	setCursor(viewRow,column);
+	scrollToCell(viewRow,column);
+
+	editor = new CellEditor(getGUI(),*this,model->getCellText(row,column));
+	_addChild(editor.get());
+	updateEditorRect();
+	editor->select();
+	return true;
+}
+
+//! (internal)
+void Table::editingFinished() {
+	if(editor.isNull() || editorOutdated)
+		return;
+	// the editor can not be removed while it is unselected; this is done during the next layout.
+	editorOutdated = true;
+	static_cast<CellEditor*>(editor.get())->_detach();
+	if(model.isNotNull() && editedRow<model->getRowCount() && editedColumn<columns.size()) {
+		const std::string text = editor->getText();
+		if(text!=model->getCellText(editedRow,editedColumn) && model->setCellText(editedRow,editedColumn,text)) {
+			if(sortColumn==editedColumn)
+				updateRowOrder();
+			getGUI().componentDataChanged(this);
+		}
+	}
+	invalidateLayout();
+	invalidateRegion();
+}
+
+//! (internal)
+void Table::updateEditorRect() {
+	if(editor.isNull() || editorOutdated)
+		return;
+	// the edited row is given by the model's index
+	const size_t viewRow = getViewRow(editedRow);
+	editor->setRect(Geometry::Rect(columnOffsets[editedColumn]-scrollPos.x(),headerHeight+viewRow*rowHeight-scrollPos.y(),
+								columns[editedColumn].width,rowHeight));
+}
+
+// -------------------------------------------------------------------
+// Scrolling
+
+void Table::scrollTo(const Geometry::Vec2 & pos) {
+	const Geometry::Vec2 newPos(std::min(std::max(0.0f,pos.x()),maxScrollPos.x()),
+								std::min(std::max(0.0f,pos.y()),maxScrollPos.y()));
+	if(newPos!=scrollPos) {
+		scrollPos = newPos;
+		invalidateLayout();
+		invalidateRegion();
+	}
+}
+
+//! (internal)
+Geometry::Vec2 Table::getBodySize()const {
+	const float scrollBarWidth = getGUI().getGlobalValue(PROPERTY_SCROLLBAR_WIDTH);
+	return Geometry::Vec2(std::max(0.0f,getWidth() - (vScrollBar.isNotNull() ? scrollBarWidth+1 : 0)),
+						std::max(0.0f,getHeight() - headerHeight - (hScrollBar.isNotNull() ? scrollBarWidth+1 : 0)));
+}
+
+//! (internal)
+void Table::setScrollbarEnabled(bool vertical,bool enabled) {
+	Util::WeakPointer<Scrollbar> & scrollBar = vertical ? vScrollBar : hScrollBar;
+	std::unique_ptr<DataChangeListenerHandle> & listener = vertical ? optionalVScrollBarListener : optionalHScrollBarListener;
+	if(enabled && scrollBar.isNull()) {
+		scrollBar = new Scrollbar(getGUI(), vertical ? Scrollbar::VERTICAL : 0);
+		listener.reset(new DataChangeListenerHandle(getGUI().addDataChangeListener(
+											scrollBar.get(),
+											[this,vertical](Component *) {
+												Scrollbar * s = (vertical ? vScrollBar : hScrollBar).get();
+												if(s!=nullptr) {
+													const float pos = static_cast<float>(s->getScrollPos());
+													scrollTo(vertical ? Geometry::Vec2(scrollPos.x(),pos) : Geometry::Vec2(pos,scrollPos.y()));
+												}
+											})));
+		_addChild(scrollBar.get());
+	} else if(!enabled && scrollBar.isNotNull()) {
+		getGUI().removeDataChangeListener(scrollBar.get(),std::move(*listener.get()));
+		listener.reset();
+		Component::destroy(scrollBar.get());
+		scrollBar = nullptr;
+	}
+}
+
+}
@@ -0,0 +1,208 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2008-2013 Benjamin Eikel <benjamin@eikel.org>
+	Copyright (C) 2008-2012 Claudius Jähn <claudius@uni-paderborn.de>
+	Copyright (C) 2008-2012 Ralf Petring <ralf@petring.net>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_TABLE_H
+#define GUI_TABLE_H
+
+#include "AbstractTableCellRenderer.h"
+#include "AbstractTableModel.h"
+#include "Container.h"
+#include "../Base/IndexRangeSet.h"
+#include "../Base/ListenerHelper.h"
+#include <memory>
+#include <vector>
+
+namespace GUI {
+class Scrollbar;
+class Textfield;
+
+/***
+ **     Table ---|> Container ---|> Component
+ **
+ ** Shows the cells of an AbstractTableModel in rows and columns below a header.
+ ** Only the cells in view are requested from the model and they are drawn directly (by the columns'
+ ** cell renderers); there are no components for the rows or cells. An editable cell is edited by
+ ** a Textfield that only exists while the cell is edited.
+ ** Columns can be resized by dragging the border in the header and the rows can be sorted by
+ ** clicking on a column's header.
+ **/
+class Table : public Container {
+		PROVIDES_TYPE_NAME(Table)
+	public:
+		static const size_t npos = static_cast<size_t>(-1);
+
+		GUIAPI Table(GUI_Manager & gui,flag_t flags=0);
+		GUIAPI virtual ~Table();
+
+		// ---|> Component
+		GUIAPI virtual void doLayout() override;
+
+	private:
+		// ---|> Component
+		GUIAPI virtual void doDisplay(const Geometry::Rect & region) override;
+
+		GUIAPI bool onKeyEvent(const Util::UI::KeyboardEvent & keyEvent);
+		GUIAPI bool onMouseButton(Component * component, const Util::UI::ButtonEvent & buttonEvent);
+		GUIAPI bool onMouseMove(Component * component, const Util::UI::MotionEvent & motionEvent);
+
+		KeyListener keyListener;
+		MouseButtonListener mouseButtonListener;
+		OptionalMouseMotionListener optionalMouseMotionListener;
+
+	// ------------------
+
+	//! @name Model
+	//	@{
+	public:
+		GUIAPI void setModel(const Util::Reference<AbstractTableModel> & m);
+		AbstractTableModel * getModel()const				{	return model.get();	}
+		/*! Has to be called when the model's rows or columns have changed. If the table is sorted,
+			the rows are sorted again and the cursor stays on the same row of the model.	*/
+		GUIAPI void modelChanged();
+
+		size_t getRowCount()const							{	return model.isNotNull() ? model->getRowCount() : 0;	}
+		size_t getColumnCount()const						{	return columns.size();	}
+		//! Return the model's index of the row shown at the given position in the table.
+		size_t getModelRow(size_t viewRow)const				{	return rowOrder.empty() ? viewRow : rowOrder[viewRow];	}
+		//! Return the position in the table of the model's row with the given index.
+		size_t getViewRow(size_t modelRow)const				{	return viewRows.empty() ? modelRow : viewRows[modelRow];	}
+	private:
+		Util::Reference<AbstractTableModel> model;
+	//	@}
+
+	// ------------------
+
+	//! @name Columns and rows
+	//	@{
+	public:
+		float getColumnWidth(size_t column)const			{	return columns.at(column).width;	}
+		GUIAPI void setColumnWidth(size_t column,float width);
+		//! Horizontal offset of the column's left border.
+		float getColumnOffset(size_t column)const			{	return columnOffsets.at(column);	}
+		//! Draw the cells of the column with the given renderer (or as text if @p renderer is nullptr).
+		GUIAPI void setCellRenderer(size_t column,const Util::Reference<AbstractTableCellRenderer> & renderer);
+
+		float getRowHeight()const							{	return rowHeight;	}
+		GUIAPI void setRowHeight(float h);
+		float getHeaderHeight()const						{	return headerHeight;	}
+
+	private:
+		struct Column{
+			float width;
+			Util::Reference<AbstractTableCellRenderer> renderer;
+			explicit Column(float _width) : width(_width) {}
+		};
+		//! (internal) Update the columns after the model's column count has changed.
+		void updateColumns();
+		//! (internal) Recalculate the column offsets starting with the given column.
+		void updateColumnOffsets(size_t firstColumn);
+		//! (internal) Return the column at the given horizontal position in the table's contents or npos.
+		size_t getColumnAt(float x)const;
+		//! (internal) Calculate the range of visible rows [first, end) and columns [first, end).
+		void getRangeInView(size_t & firstRow,size_t & endRow,size_t & firstColumn,size_t & endColumn)const;
+
+		std::vector<Column> columns;
+		std::vector<float> columnOffsets; // columnOffsets[i] is the left border of column i; the last value is the total width
+		float rowHeight;
+		float headerHeight;
+		float defaultColumnWidth;
+		size_t resizedColumn; //!< column whose border is dragged or npos
+	//	@}
+
+	// ------------------
+
+	//! @name Sorting
+	//	@{
+	public:
+		/*! Sort the rows by the given column (using AbstractTableModel::isLess()); the order of equal rows is kept.
+			If @p column is npos, the rows are shown in the model's order.	*/
+		GUIAPI void sortByColumn(size_t column,bool ascending=true);
+		size_t getSortColumn()const							{	return sortColumn;	}
+		bool isSortedAscending()const						{	return sortAscending;	}
+	private:
+		void updateRowOrder();
+
+		std::vector<size_t> rowOrder; // rowOrder[viewRow] is the model's row; empty if not sorted
+		std::vector<size_t> viewRows; // inverse of rowOrder: viewRows[modelRow] is the row in the table
+		size_t sortColumn;
+		bool sortAscending;
+	//	@}
+
+	// ------------------
+
+	//! @name Markings and cursor
+	//	@{
+	public:
+		//! Markings are stored by the model's row indices, so they are kept when the rows are sorted.
+		bool isRowMarked(size_t modelRow)const				{	return markedRows.contains(modelRow);	}
+		const IndexRangeSet & getMarkedRows()const			{	return markedRows;	}
+		GUIAPI void markRow(size_t modelRow);
+		GUIAPI void unmarkRow(size_t modelRow);
+		GUIAPI void clearMarkings();
+		GUIAPI void markingChanged();
+
+		//! The cursor is the active cell (in view coordinates: the row's position in the table and the column).
+		size_t getCursorRow()const							{	return cursorRow;	}
+		size_t getCursorColumn()const						{	return cursorColumn;	}
+		GUIAPI void setCursor(size_t viewRow,size_t column);
+		//! Scroll so that the given cell is visible.
+		GUIAPI void scrollToCell(size_t viewRow,size_t column);
+	private:
+		IndexRangeSet markedRows;
+		size_t cursorRow;
+		size_t cursorColumn;
+	//	@}
+
+	// ------------------
+
+	//! @name Editing
+	//	@{
+	public:
+		/*! Open a Textfield over the given cell if it is editable. When the Textfield is unselected,
+			a changed text is passed to AbstractTableModel::setCellText() and the Textfield is removed.
+			Returns false if the cell is not editable.	*/
+		GUIAPI bool editCell(size_t viewRow,size_t column);
+		bool isEditing()const								{	return editor.isNotNull();	}
+	private:
+		class CellEditor;
+		//! (internal) Called by the editor when it is unselected.
+		void editingFinished();
+		//! (internal) Place the editor over its cell.
+		void updateEditorRect();
+
+		Util::WeakPointer<Textfield> editor;
+		size_t editedRow; // model row
+		size_t editedColumn;
+		bool editorOutdated; // the editor is removed during the next layout
+	//	@}
+
+	// ------------------
+
+	//! @name Scrolling
+	//	@{
+	public:
+		GUIAPI void scrollTo(const Geometry::Vec2 & pos);
+		const Geometry::Vec2 & getScrollPos()const			{	return scrollPos;	}
+	private:
+		//! (internal) Create or destroy a scroll bar.
+		void setScrollbarEnabled(bool vertical,bool enabled);
+		//! Size of the area showing the cells.
+		Geometry::Vec2 getBodySize()const;
+
+		Util::WeakPointer<Scrollbar> vScrollBar;
+		Util::WeakPointer<Scrollbar> hScrollBar;
+		std::unique_ptr<DataChangeListenerHandle> optionalVScrollBarListener;
+		std::unique_ptr<DataChangeListenerHandle> optionalHScrollBarListener;
+		Geometry::Vec2 scrollPos;
+		Geometry::Vec2 maxScrollPos;
+	//	@}
+};
+}
+#endif // GUI_TABLE_H
@@ -11,7 +11,7 @@
 #include "TreeView.h"
 #include "../GUI_Manager.h"
 #include "../Base/AbstractShape.h"
-#include "../Base/AnimationHandler.h"
+#include "../Base/TweenAnimation.h"
 #include "../Base/ListenerHelper.h"
 #include "../Base/Layouters/ExtLayouter.h"
 #include "../Base/StyleManager.h"
@@ -21,42 +21,32 @@
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
 
 namespace GUI {
 
-//! TV_ScrollAnimation ---|> AnimationHandler
-class TV_ScrollAnimation:public AnimationHandler{
-	public:
-		float targetPos;
-
-		TV_ScrollAnimation(TreeView * tv,float _targetPos, float _duration) :
-			AnimationHandler(tv,_duration),targetPos(_targetPos){
-		}
-		virtual ~TV_ScrollAnimation()	{}
-
-		// ---|> AnimationHandler
-		bool animate(float t) override{
-			if(t > getEndTime()) {
-				finish();
-				return false;
-			}
-			TreeView * tv= dynamic_cast<TreeView *>(getComponent());
-			tv->scrollTo( (tv->getScrollPos()*2 + targetPos ) /3.0f );
-			return true;
-		}
+//! Horizontal offset per tree level.
+static const float indentation = 10.0f;
+//! The label of an entry used by the type-ahead search.
+static std::string getEntryLabel(TreeView::TreeViewEntry * entry){
+	Component * c = entry->getFirstChild();
+	return isA<TreeView::TreeViewEntry>(c) ? "" : TypeAheadIndex::findLabel(c);
+}
+//! Smooth scrolling of the tree view to the target position.
+static AnimationHandler * createScrollAnimation(TreeView * tv,float targetPos,float duration){
+	return new TweenAnimation<float>(tv,tv->getScrollPos(),targetPos,duration,
+									 [tv](const float & pos){	tv->scrollTo(pos);	});
+}
 
-		// ---|> AnimationHandler
-		void finish() override{
-			dynamic_cast<TreeView *>(getComponent())->scrollTo(targetPos);
-		}
-};
 // ------------------------------------------------------------------------------------------------------------
 
 //! (TreeView::TreeViewEntry] [ctor)
 TreeView::TreeViewEntry::TreeViewEntry(GUI_Manager & _gui,TreeView * _treeView,Component * c/*=nullptr*/,flag_t _flags/*=0*/):
 		Container(_gui,_flags),
 		myTreeView(_treeView),marked(false),
-		mouseButtonListener(createMouseButtonListener(_gui, this, &TreeViewEntry::onMouseButton)) {
+		mouseButtonListener(createMouseButtonListener(_gui, this, &TreeViewEntry::onMouseButton)),
+		firstOutdatedChild(0) {
+	addKind(KIND);
 	if(c) {
 		Container::_insertAfter(c,getLastChild());
 	}
@@ -99,7 +89,7 @@ void TreeView::TreeViewEntry::doDisplay(const Geometry::Rect & region) {
 				break;
 		}
 	}
-	if(getContentsCount() > 1 && dynamic_cast<TreeViewEntry*>(getParent())) {
+	if(getContentsCount() > 1 && isA<TreeViewEntry>(getParent())) {
 		const int markerHeight = std::min<int>(static_cast<int>(getFirstChild()->getHeight()),20);
 	
 		shape_activeIndentation->display(Geometry::Rect(4,0,1,markerHeight*0.3f));
@@ -153,24 +143,18 @@ const Util::StringIdentifier TreeView::TreeViewEntry::ACTION_TreeViewEntry_open(
 void TreeView::TreeViewEntry::collapse(){
 	getGUI().componentActionPerformed(this,ACTION_TreeViewEntry_collapse);
 	setFlag(COLLAPSED_ENTRY, true);
+	// only the own height changes; the parents are informed during the layout
 	invalidateLayout();
-	if(hasParent())
-		getParent()->invalidateLayout();
-	if(myTreeView){
-		myTreeView->invalidateLayout();
+	if(myTreeView)
 		myTreeView->invalidateRegion();
-	}
 }
 void TreeView::TreeViewEntry::open(){
 	getGUI().componentActionPerformed(this,ACTION_TreeViewEntry_open);
 	setFlag(COLLAPSED_ENTRY, false);
+	// only the own height changes; the parents are informed during the layout
 	invalidateLayout();
-	if(hasParent())
-		getParent()->invalidateLayout();
-	if(myTreeView){
-		myTreeView->invalidateLayout();
+	if(myTreeView)
 		myTreeView->invalidateRegion();
-	}
 }
 
 //! [TreeView::TreeViewEntry] ---|> Container
@@ -181,17 +165,22 @@ void TreeView::TreeViewEntry::insertAfter(const Ref & child,const Ref & after) {
 		if(myTreeView!=nullptr)
 			myTreeView->invalidateRegion();
 		_insertAfter(child,after);
+		if(myTreeView!=nullptr) // the entry's label is changed
+			myTreeView->updateTypeAheadIndex(this,true);
 	}else{
-		TreeViewEntry * e=dynamic_cast<TreeViewEntry*>(child.get());
+		TreeViewEntry * e=castTo<TreeViewEntry>(child.get());
 		if(e==nullptr) {
 			e=new TreeViewEntry(getGUI(),myTreeView,child.get());
 		} else {
 			e->setTreeView(myTreeView);
 		}
-		if(myTreeView!=nullptr)
+		if(myTreeView!=nullptr){
 			myTreeView->invalidateRegion();
+			myTreeView->updateTypeAheadIndex(e,true);
+		}
 		_insertAfter(e,after);
 	}
+	firstOutdatedChild = 0; // the child may have been moved inside this entry
 }
 //
 //! [TreeView::TreeViewEntry] ---|> Container
@@ -204,15 +193,18 @@ void TreeView::TreeViewEntry::insertBefore(const Ref & child,const Ref & after)
 	if(child.isNull()) return;
 
 //	std::cout << " <addEntry2 ";
-	TreeViewEntry * e=dynamic_cast<TreeViewEntry*>(child.get());
+	TreeViewEntry * e=castTo<TreeViewEntry>(child.get());
 	if(e==nullptr) {
 		e=new TreeViewEntry(getGUI(),myTreeView,child.get());
 	} else {
 		e->setTreeView(myTreeView);
 	}
-	if(myTreeView!=nullptr)
+	if(myTreeView!=nullptr){
 		myTreeView->invalidateRegion();
+		myTreeView->updateTypeAheadIndex(e,true);
+	}
 	Container::insertBefore(e,after);
+	firstOutdatedChild = 0; // the child may have been moved inside this entry
 }
 
 //! [TreeView::TreeViewEntry] ---|> Container
@@ -221,22 +213,30 @@ void TreeView::TreeViewEntry::removeContent(const Ref & child) {
 		return;
 
 	unmarkSubtree(child.get());
-	TreeViewEntry * e = dynamic_cast<TreeViewEntry*>(child.get());
+	TreeViewEntry * e = castTo<TreeViewEntry>(child.get());
 
 	if(e==nullptr)
-		e = dynamic_cast<TreeViewEntry*>(child->getParent());
+		e = castTo<TreeViewEntry>(child->getParent());
 
 	if(e==nullptr){
 		std::cerr << "Wrong parent!";
 		return;
 	}
+	if(myTreeView!=nullptr)
+		myTreeView->updateTypeAheadIndex(e,false);
 	Container::removeContent(e);
 }
 
 //! [TreeView::TreeViewEntry] ---|> Container
 void TreeView::TreeViewEntry::clearContents() {
 	unmarkSubtree(this);
+	if(myTreeView!=nullptr) { // the removed entries must not remain in the index
+		for(Component * c=getFirstChild();c!=nullptr;c=c->getNext())
+			myTreeView->updateTypeAheadIndex(c,false);
+	}
 	Container::clearContents();
+	if(myTreeView!=nullptr) // the entry's label is removed as well
+		myTreeView->updateTypeAheadIndex(this,true);
 }
 
 //! [TreeView::TreeViewEntry] ---|> Container
@@ -251,7 +251,7 @@ std::vector<Component*> TreeView::TreeViewEntry::getContents(){
 //! (TreeView::TreeViewEntry)
 TreeView::TreeViewEntry * TreeView::TreeViewEntry::getFirstSubentry()const{
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		TreeViewEntry * e=dynamic_cast<TreeViewEntry*>(c);
+		TreeViewEntry * e=castTo<TreeViewEntry>(c);
 		if(e)
 			return e;
 	}
@@ -262,11 +262,14 @@ TreeView::TreeViewEntry * TreeView::TreeViewEntry::getFirstSubentry()const{
 void TreeView::TreeViewEntry::setComponent(const Ref & c){
 	Component * first = getFirstChild();
 	if(c!=first){
-		if(dynamic_cast<TreeViewEntry*>(first)==nullptr) // there is an old component? -> remove it
+		if(!isA<TreeViewEntry>(first)) // there is an old component? -> remove it
 			Container::removeContent(first);
 		Container::insertBefore(c,getFirstChild());
-		if(myTreeView!=nullptr)
+		if(myTreeView!=nullptr){
 			myTreeView->invalidateRegion();
+			if(myTreeView->typeAheadIndexValid)
+				myTreeView->typeAheadIndex.set(reinterpret_cast<TypeAheadIndex::id_t>(this),getEntryLabel(this));
+		}
 	}
 }
 
@@ -274,17 +277,40 @@ void TreeView::TreeViewEntry::setComponent(const Ref & c){
 void TreeView::TreeViewEntry::doLayout() {
 	if(myTreeView==nullptr)
 		return;
-	uint32_t h=0;
+	const size_t count = getChildCount();
 
 	// \note Even if isCollapsed(), the other entries need to be moved out of the way 
 	//   so that they do not grab the click events for the first component.
-	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		c->setPosition(Geometry::Vec2(10,static_cast<float>(h)));
-		h += static_cast<uint32_t>(c->getHeight());
+	if(firstOutdatedChild<count){
+		uint32_t h=0;
+		if(firstOutdatedChild>0){ // the children in front are already placed
+			const Component * prev = getChild(firstOutdatedChild-1);
+			h = static_cast<uint32_t>(prev->getPosition().y()) + static_cast<uint32_t>(prev->getHeight());
+		}
+		for(size_t i=firstOutdatedChild;i<count;++i){
+			Component * c = getChild(i);
+			c->setPosition(Geometry::Vec2(10,static_cast<float>(h)));
+			h += static_cast<uint32_t>(c->getHeight());
+		}
 	}
-	setSize( getParent()->getWidth()-getPosition().x(),
-			(isCollapsed()&&getFirstChild()!=nullptr) ? 
-				getFirstChild()->getHeight() : h);
+	firstOutdatedChild = count;
+
+	const Component * last = getLastChild();
+	const float height = (isCollapsed()&&getFirstChild()!=nullptr) ? getFirstChild()->getHeight() :
+			(last!=nullptr ? static_cast<float>(static_cast<uint32_t>(last->getPosition().y()) + static_cast<uint32_t>(last->getHeight())) : 0.0f);
+	const float width = getParent()->getWidth()-getPosition().x();
+	if(static_cast<int>(width)!=static_cast<int>(getWidth()))
+		setSize(width,height);
+	else // the children's layout does not depend on the entry's height
+		_setHeightKeepingSubtreeLayout(height);
+}
+
+//! [TreeView::TreeViewEntry] ---|> Container
+void TreeView::TreeViewEntry::childRectChanged(Component * c) {
+	// \note A removed child still knows its former index.
+	if(c!=nullptr)
+		firstOutdatedChild = std::min(firstOutdatedChild,c->getIndexInParent());
+	Container::childRectChanged(c);
 }
 
 //! (TreeView::TreeViewEntry)
@@ -292,7 +318,7 @@ void TreeView::TreeViewEntry::setTreeView( TreeView * tv) {
 	myTreeView=tv;
 
 	for (Component * c=getFirstChild();c!=nullptr;c=c->getNext()) {
-		TreeViewEntry * e=dynamic_cast<TreeViewEntry*>(c);
+		TreeViewEntry * e=castTo<TreeViewEntry>(c);
 		if(e) {
 			e->setTreeView(myTreeView);
 		}
@@ -301,23 +327,22 @@ void TreeView::TreeViewEntry::setTreeView( TreeView * tv) {
 
 //! (TreeView::TreeViewEntry) ( internal)
 void TreeView::TreeViewEntry::unmarkSubtree(Component * subroot)const{
-	if(getTreeView()==nullptr) // no treeView set -> no marking possible
+	TreeView * treeView = getTreeView();
+	if(treeView==nullptr || treeView->markedEntryIndices.empty()) // no marking possible
 		return;
 
-	struct MyVisitor : public Visitor {
-		TreeView * treeView;
-		MyVisitor(TreeView * tw) : treeView(tw){}
-		virtual ~MyVisitor() {};
-
-		visitorResult_t visit(Component & c) override{
-			TreeViewEntry * e = dynamic_cast<TreeViewEntry *>(&c);
-			if(e!=nullptr && e->isMarked() && e->getTreeView()==treeView){
-				treeView->unmarkEntry(e);
+	// Instead of traversing the (normally much larger) subtree, the ancestors of the marked entries are checked.
+	std::vector<TreeViewEntry*> entriesInSubtree;
+	for(const auto & entry : treeView->markedEntries){
+		for(Component * c = entry.get(); c!=nullptr && c!=treeView; c=c->getParent()){
+			if(c==subroot){
+				entriesInSubtree.push_back(entry.get());
+				break;
 			}
-			return CONTINUE_TRAVERSAL;
-		};
-	}visitor(getTreeView());
-	subroot->traverseSubtree(visitor);
+		}
+	}
+	for(auto entry : entriesInSubtree)
+		treeView->unmarkEntry(entry);
 }
 
 //// ------------------------------------------------------------------------------
@@ -328,13 +353,16 @@ TreeView::TreeView(GUI_Manager & _gui,const Geometry::Rect & _r,const std::strin
 		actionName(_actionName),root(new TreeViewEntry(_gui,this)),scrollPos(0),multiSelect(true),scrollBar(nullptr),
 		keyListener(createKeyListener(_gui, this, &TreeView::onKeyEvent)),
 		mouseButtonListener(createMouseButtonListener(_gui, this, &TreeView::onMouseButton)),
-		optionalMouseMotionListener(createOptionalMouseMotionListener(_gui, this, &TreeView::onMouseMove)) {
+		optionalMouseMotionListener(createOptionalMouseMotionListener(_gui, this, &TreeView::onMouseMove)),
+		firstVisibleRow(0),cursorNode(0),cursorRow(npos),cursorRowValid(false),rowHeight(_gui.getGlobalValue(PROPERTY_TREEVIEW_DEFAULT_ENTRY_HEIGHT)),rowsOutdated(false),
+		typeAheadIndexValid(false) {
 	setFlag(SELECTABLE,true);
 
 	_addChild(root.get());
 
 	setFlag(USE_SCISSOR,true);
 	setFlag(LOWERED_BORDER,true);
+	typeAheadIndex.setEntryOrder([this](TypeAheadIndex::id_t a,TypeAheadIndex::id_t b) {	return isEntryBefore(a,b);	});
 }
 
 //! (dtor)
@@ -350,7 +378,8 @@ TreeView::~TreeView() {
 
 //! ---|> Component
 void TreeView::doLayout() {
-	if(root->getHeight()>=getHeight()){
+	const float contentHeight = getContentHeight();
+	if(contentHeight>=getHeight()){
 		if(scrollBar.isNull()){
 			scrollBar = new Scrollbar(getGUI(), Scrollbar::VERTICAL);
 			scrollBar->setExtLayout( 	ExtLayouter::POS_X_ABS|ExtLayouter::REFERENCE_X_RIGHT|ExtLayouter::ALIGN_X_RIGHT|
@@ -368,8 +397,8 @@ void TreeView::doLayout() {
 												})));
 			_addChild(scrollBar.get());
 		}
-		const int maxScrollPos = std::max(0,static_cast<int>(root->getHeight()-getHeight()));
-		scrollPos = std::min(root->getHeight()-getHeight(),scrollPos);
+		const int maxScrollPos = std::max(0,static_cast<int>(contentHeight-getHeight()));
+		scrollPos = std::min(contentHeight-getHeight(),scrollPos);
 		scrollBar->setMaxScrollPos(maxScrollPos); 
 		scrollBar->setScrollPos( static_cast<uint32_t>(scrollPos) );
 	}else{
@@ -383,7 +412,13 @@ void TreeView::doLayout() {
 		}
 	}
 	root->setPosition(Geometry::Vec2(-10,-scrollPos));
+	if(model.isNotNull())
+		updateVisibleRows();
+}
 
+//! (internal)
+float TreeView::getContentHeight()const {
+	return model.isNotNull() ? rows.size()*rowHeight : root->getHeight();
 }
 
 //! ---|> Component
@@ -398,6 +433,8 @@ void TreeView::doDisplay(const Geometry::Rect & region) {
 	}
 	auto shape_scrollableMarkerTop = getGUI().getStyleManager().getShape(PROPERTY_SCROLLABLE_MARKER_TOP_SHAPE);
 	auto shape_scrollableMarkerBottom = getGUI().getStyleManager().getShape(PROPERTY_SCROLLABLE_MARKER_BOTTOM_SHAPE);
+	if(model.isNotNull())
+		displayModelRows();
 	disableLocalDisplayProperties();
 	
 	displayChildren(region,true);
@@ -419,19 +456,49 @@ bool TreeView::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 	else if(keyEvent.key == Util::UI::KEY_TAB){
 		return false;
 	}
+	else if(onTypeAheadInput(keyEvent)){
+		return true;
+	}
+	else if(model.isNotNull()) {
+		if(markedNodes.size()!=1)
+			return true;
+		const size_t index = getCursorRow();
+		if(index==npos)
+			return true;
+		size_t newIndex = index;
+		if(keyEvent.key == Util::UI::KEY_UP && index>0) {
+			newIndex = index-1;
+		} else if(keyEvent.key == Util::UI::KEY_DOWN && index+1<rows.size()) {
+			newIndex = index+1;
+		} else if(keyEvent.key == Util::UI::KEY_RIGHT && rows[index].hasChildren && !rows[index].open) {
+			openRow(index);
+		} else if(keyEvent.key == Util::UI::KEY_LEFT) {
+			if(rows[index].open) {
+				collapseRow(index);
+			} else { // go to the parent
+				while(newIndex>0 && rows[newIndex].depth>=rows[index].depth)
+					--newIndex;
+			}
+		}
+		if(newIndex!=index) {
+			unmarkAll();
+			markNode(rows[newIndex].node,newIndex);
+			markingChanged();
+		}
+	}
 	else if(keyEvent.key == Util::UI::KEY_UP) {
 //		scroll(-15);
-		if(markedEntries.size()==1){
-			TreeViewEntry * m = markedEntries.front().get();
-			TreeViewEntry * newEntry=dynamic_cast<TreeViewEntry*>(m->getPrev());
+		if(markedEntryIndices.size()==1){
+			TreeViewEntry * m = getFirstMarkedEntry();
+			TreeViewEntry * newEntry=castTo<TreeViewEntry>(m->getPrev());
 
 			if(newEntry){
-				if(dynamic_cast<TreeViewEntry*>(newEntry->getLastChild())){
-					newEntry=dynamic_cast<TreeViewEntry*>(newEntry->getLastChild());
+				if(isA<TreeViewEntry>(newEntry->getLastChild())){
+					newEntry=castTo<TreeViewEntry>(newEntry->getLastChild());
 				}
 			}else{
-				if(dynamic_cast<TreeViewEntry*>(m->getParent())){
-					newEntry=dynamic_cast<TreeViewEntry*>(m->getParent());
+				if(isA<TreeViewEntry>(m->getParent())){
+					newEntry=castTo<TreeViewEntry>(m->getParent());
 				}
 			}
 			if(newEntry){
@@ -444,16 +511,16 @@ bool TreeView::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 	}
 	else if(keyEvent.key == Util::UI::KEY_DOWN) {
 //		scroll(15);
-		if(markedEntries.size()==1){
+		if(markedEntryIndices.size()==1){
 			TreeViewEntry * newEntry = nullptr;
-			TreeViewEntry * m = markedEntries.front().get();
-			if(m->getContentsCount()>1 && dynamic_cast<TreeViewEntry*>(m->getFirstChild()->getNext())){
-				newEntry=dynamic_cast<TreeViewEntry*>(m->getFirstChild()->getNext());
+			TreeViewEntry * m = getFirstMarkedEntry();
+			if(m->getContentsCount()>1 && isA<TreeViewEntry>(m->getFirstChild()->getNext())){
+				newEntry=castTo<TreeViewEntry>(m->getFirstChild()->getNext());
 			}else{
-				newEntry=dynamic_cast<TreeViewEntry*>(m->getNext());
+				newEntry=castTo<TreeViewEntry>(m->getNext());
 				if(!newEntry){
-					if(dynamic_cast<TreeViewEntry*>(m->getParent())){
-						newEntry=dynamic_cast<TreeViewEntry*>(m->getParent()->getNext());
+					if(isA<TreeViewEntry>(m->getParent())){
+						newEntry=castTo<TreeViewEntry>(m->getParent()->getNext());
 					}
 				}
 			}
@@ -469,6 +536,7 @@ bool TreeView::onKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 
 //! ---|> Container
 void TreeView::addContent(const Ref & child) {
+	assertHasNoModel();
 	if(child.isNull()) return;
 	invalidateRegion();
 	root->addContent(child);
@@ -476,6 +544,7 @@ void TreeView::addContent(const Ref & child) {
 
 //! ---|> Container
 void TreeView::removeContent(const Ref & child) {
+	assertHasNoModel();
 	if(child.isNull()) return;
 	invalidateRegion();
 	root->removeContent(child);
@@ -484,7 +553,13 @@ void TreeView::removeContent(const Ref & child) {
 //! ---|> Container
 void TreeView::clearContents() {
 	unmarkAll();
-	root->clearContents();
+	if(model.isNotNull()) {
+		releaseRows();
+		rowsOutdated = true;
+		invalidateLayout();
+	} else {
+		root->clearContents();
+	}
 	scrollPos = 0;
 }
 
@@ -500,13 +575,20 @@ bool TreeView::onMouseButton(Component * /*component*/, const Util::UI::ButtonEv
 //		scroll(-getHeight()*0.25);
 
 		getGUI().stopAnimations(this);
-		getGUI().addAnimationHandler(new TV_ScrollAnimation(this, scrollPos-getHeight()*0.5f ,0.3f));
+		getGUI().addAnimationHandler(createScrollAnimation(this, scrollPos-getHeight()*0.5f ,0.3f));
 
 		return true;
 	}else if(buttonEvent.pressed && buttonEvent.button == Util::UI::MOUSE_WHEEL_DOWN) {
 //		scroll(+getHeight()*0.25);
 		getGUI().stopAnimations(this);
-		getGUI().addAnimationHandler(new TV_ScrollAnimation(this, scrollPos+getHeight()*0.5f ,0.3f));
+		getGUI().addAnimationHandler(createScrollAnimation(this, scrollPos+getHeight()*0.5f ,0.3f));
+		return true;
+	}else if(model.isNotNull() && buttonEvent.pressed && buttonEvent.button == Util::UI::MOUSE_BUTTON_LEFT) {
+		select();
+		return onModelRowClicked(Geometry::Vec2(buttonEvent.x, buttonEvent.y) - getAbsPosition());
+	}else if(model.isNotNull() && buttonEvent.pressed && buttonEvent.button == Util::UI::MOUSE_BUTTON_RIGHT) {
+		unmarkAll();
+		markingChanged();
 		return true;
 	}else{
 		return false;
@@ -530,11 +612,12 @@ void TreeView::scroll(float amount) {
 void TreeView::scrollTo(float _position) {
 	const float oldScrollPos=scrollPos;
 	scrollPos=_position;
-	if(scrollPos<0 || root->getHeight()<getHeight() ){
+	const float contentHeight = getContentHeight();
+	if(scrollPos<0 || contentHeight<getHeight() ){
 		
 		scrollPos=0;
-	}else if(scrollPos>root->getHeight() - getHeight()){
-		scrollPos=root->getHeight() - getHeight();
+	}else if(scrollPos>contentHeight - getHeight()){
+		scrollPos=contentHeight - getHeight();
 	}
 	if(scrollPos!=oldScrollPos){
 		invalidateLayout();
@@ -543,72 +626,108 @@ void TreeView::scrollTo(float _position) {
 }
 
 void TreeView::scrollToSelection() {
-	if(!markedEntries.empty()) {
-		TreeViewEntry * entry = markedEntries.front().get();
-		const float yPos = entry->getAbsPosition().y()-getAbsPosition().y()+scrollPos;
-
-
-		if( yPos < scrollPos+entry->getHeight()*0.5 ){
-			getGUI().stopAnimations(this);
-			getGUI().addAnimationHandler(new TV_ScrollAnimation(this,yPos - entry->getHeight()*0.5f ,0.4f));
-		}
-		else if( yPos+entry->getHeight()*2.0 > scrollPos+getHeight() ){
-			getGUI().stopAnimations(this);
-			getGUI().addAnimationHandler(new TV_ScrollAnimation(this,yPos - std::max(getHeight()-entry->getHeight()*3.0f,getHeight()*0.3f ),0.4f));
+	if(model.isNotNull()) {
+		if(!markedNodes.empty()) {
+			const size_t index = getCursorRow();
+			if(index!=npos)
+				scrollIntoView(index*rowHeight,rowHeight);
 		}
+	} else if(!markedEntryIndices.empty()) {
+		TreeViewEntry * entry = getFirstMarkedEntry();
+		scrollIntoView(entry->getAbsPosition().y()-getAbsPosition().y()+scrollPos,entry->getHeight());
 	}
 //	std::cout << getHeight();
 }
 
+//! (internal)
+void TreeView::scrollIntoView(float yPos,float height) {
+	if( yPos < scrollPos+height*0.5 ){
+		getGUI().stopAnimations(this);
+		getGUI().addAnimationHandler(createScrollAnimation(this, yPos - height*0.5f ,0.4f));
+	}
+	else if( yPos+height*2.0 > scrollPos+getHeight() ){
+		getGUI().stopAnimations(this);
+		getGUI().addAnimationHandler(createScrollAnimation(this, yPos - std::max(getHeight()-height*3.0f,getHeight()*0.3f ),0.4f));
+	}
+}
+
 
 void TreeView::markEntry(TreeViewEntry * entry) {
 	if(entry && entry->getTreeView()==this && !entry->isMarked()){
 		if(!multiSelect)
 			unmarkAll();
-		markedEntries.push_back(entry);
+		markedEntryIndices.emplace(entry,markedEntries.size());
+		markedEntries.emplace_back(entry);
 		entry->_setMarked(true);
 
-		if(markedEntries.size()==1)
+		if(markedEntryIndices.size()==1)
 			scrollToSelection();
 	}
 }
 
 
 void TreeView::unmarkEntry(TreeViewEntry * entry) {
-	if(entry && entry->isMarked()){
-		const auto pos = std::find(markedEntries.begin(),markedEntries.end(),entry);
-		if(pos!=markedEntries.end()){
-			markedEntries.erase(pos);
-			entry->_setMarked(false);
-		}
+	if(entry==nullptr || !entry->isMarked())
+		return;
+	const auto it = markedEntryIndices.find(entry);
+	if(it==markedEntryIndices.end())
+		return;
+	markedEntries[it->second] = nullptr;
+	markedEntryIndices.erase(it);
+	entry->_setMarked(false);
+
+	// remove the unused slots if they are the majority (keeps the order of the remaining entries)
+	if(markedEntries.size() > 2*markedEntryIndices.size()) {
+		markedEntries.erase(std::remove_if(markedEntries.begin(),markedEntries.end(),
+											[](const Util::Reference<TreeViewEntry> & e) {	return e.isNull();	}),markedEntries.end());
+		for(size_t i = 0; i < markedEntries.size(); ++i)
+			markedEntryIndices[markedEntries[i].get()] = i;
+	}
+}
+
+//! (internal)
+TreeView::TreeViewEntry * TreeView::getFirstMarkedEntry()const {
+	for(const auto & entry : markedEntries) {
+		if(entry.isNotNull())
+			return entry.get();
 	}
+	return nullptr;
 }
 
 
 void TreeView::unmarkAll() {
-	for(auto entry : markedEntries)
-		entry->_setMarked(false);
+	for(auto & entry : markedEntries) {
+		if(entry.isNotNull())
+			entry->_setMarked(false);
+	}
 	markedEntries.clear();
+	markedEntryIndices.clear();
+	if(!markedNodes.empty()) {
+		markedNodes.clear();
+		invalidateRegion();
+	}
 }
 
 
 void TreeView::markComponent(Component * c){
 	if(c!=nullptr) 
-		markEntry(dynamic_cast<TreeViewEntry *>(c->getParent()));
+		markEntry(castTo<TreeViewEntry>(c->getParent()));
 }
 
 
 void TreeView::unmarkComponent(Component * c){
 	if(c!=nullptr)
-		unmarkEntry(dynamic_cast<TreeViewEntry *>(c->getParent()));
+		unmarkEntry(castTo<TreeViewEntry>(c->getParent()));
 }
 
 
 std::vector<Component*> TreeView::getMarkedComponents(){
 	std::vector<Component*> arr;
 	for(auto & entry : markedEntries) {
+		if(entry.isNull())
+			continue;
 		Component * c = entry->getFirstChild();
-		if( dynamic_cast<TreeViewEntry *>(c) == nullptr ) // should be the real content, not an entry...
+		if( !isA<TreeViewEntry>(c) ) // should be the real content, not an entry...
 			arr.push_back(c);
 	}
 	return arr;
@@ -624,4 +743,372 @@ std::vector<Component*> TreeView::getContents(){
 	return root->getContents();
 }
 
+// -------------------------------------------------------------------
+// Model
+
+void TreeView::assertHasNoModel()const {
+	if(model.isNotNull())
+		throw std::logic_error("The contents of this TreeView are provided by a model.");
+}
+
+void TreeView::setModel(const Util::Reference<AbstractTreeViewModel> & m) {
+	if(m == model)
+		return;
+	unmarkAll();
+	if(model.isNotNull()) {
+		releaseRows();
+		unusedRows.clear(); // the rows of the old model can not be reused
+	} else {
+		root->clearContents();
+	}
+	model = m;
+	rows.clear();
+	scrollPos = 0;
+	modelChanged();
+}
+
+void TreeView::modelChanged() {
+	std::unordered_set<node_t> openNodes;
+	for(const auto & row : rows) {
+		if(row.open)
+			openNodes.insert(row.node);
+	}
+	rows.clear();
+	if(model.isNotNull())
+		collectRows(model->getRoot(),0,openNodes,rows);
+	cursorRowValid = false;
+	nodeRows.clear();
+	rowsOutdated = true;
+	typeAheadIndexValid = false;
+	invalidateLayout();
+	invalidateRegion();
+}
+
+void TreeView::rowsChanged(size_t first,size_t count) {
+	if(model.isNull())
+		return;
+	if(typeAheadIndexValid) {
+		for(size_t index = first; index < std::min(first+count,rows.size()); ++index)
+			typeAheadIndex.set(rows[index].node,model->getNodeText(rows[index].node));
+	}
+	if(rowsOutdated)
+		return;
+	const size_t begin = std::max(first,firstVisibleRow);
+	const size_t end = std::min(first+count,firstVisibleRow+visibleRows.size());
+	for(size_t index = begin; index < end; ++index)
+		model->updateRow(*visibleRows[index-firstVisibleRow],rows[index].node,rows[index].depth);
+}
+
+//! (internal)
+void TreeView::collectRows(node_t node,uint32_t depth,const std::unordered_set<node_t> & openNodes,std::vector<Row> & result) {
+	const size_t count = model->getChildCount(node);
+	for(size_t i = 0; i < count; ++i) {
+		const node_t child = model->getChild(node,i);
+		result.emplace_back(child,depth,model->hasChildren(child));
+		if(result.back().hasChildren && openNodes.count(child)>0) {
+			result.back().open = true;
+			collectRows(child,depth+1,openNodes,result);
+		}
+	}
+}
+
+size_t TreeView::findRow(node_t node)const {
+	for(size_t index = 0; index < rows.size(); ++index) {
+		if(rows[index].node == node)
+			return index;
+	}
+	return npos;
+}
+
+void TreeView::openRow(size_t index) {
+	if(model.isNull() || index>=rows.size() || rows[index].open || !rows[index].hasChildren)
+		return;
+	std::vector<Row> children;
+	collectRows(rows[index].node,rows[index].depth+1,std::unordered_set<node_t>(),children);
+	rows[index].open = true;
+	rows.insert(rows.begin()+index+1,children.begin(),children.end());
+	nodeRows.clear();
+	if(cursorRowValid) {
+		if(cursorRow==npos) // the cursor may be one of the new rows
+			cursorRowValid = false;
+		else if(cursorRow>index)
+			cursorRow += children.size();
+	}
+	if(typeAheadIndexValid) {
+		for(const auto & row : children)
+			typeAheadIndex.set(row.node,model->getNodeText(row.node));
+	}
+	if(index+1 < firstVisibleRow+visibleRows.size()) // the rows behind are moved
+		rowsOutdated = true;
+	invalidateLayout();
+	invalidateRegion();
+}
+
+void TreeView::collapseRow(size_t index) {
+	if(model.isNull() || index>=rows.size() || !rows[index].open)
+		return;
+	size_t end = index+1;
+	while(end<rows.size() && rows[end].depth>rows[index].depth)
+		++end;
+	rows[index].open = false;
+	if(typeAheadIndexValid) {
+		for(size_t i = index+1; i < end; ++i)
+			typeAheadIndex.remove(rows[i].node);
+	}
+	rows.erase(rows.begin()+index+1,rows.begin()+end);
+	nodeRows.clear();
+	if(cursorRowValid && cursorRow!=npos && cursorRow>index) {
+		if(cursorRow<end)
+			cursorRow = npos;
+		else
+			cursorRow -= end-index-1;
+	}
+	if(index+1 < firstVisibleRow+visibleRows.size())
+		rowsOutdated = true;
+	invalidateLayout();
+	invalidateRegion();
+}
+
+void TreeView::setRowHeight(float h) {
+	rowHeight = h;
+	invalidateLayout();
+	invalidateRegion();
+}
+
+void TreeView::markNode(node_t node) {
+	markNode(node,npos);
+}
+
+//! (internal)
+void TreeView::markNode(node_t node,size_t row) {
+	if(model.isNull() || isNodeMarked(node))
+		return;
+	if(!multiSelect)
+		unmarkAll();
+	markedNodes.insert(node);
+	cursorNode = node;
+	cursorRow = row;
+	cursorRowValid = row!=npos;
+	invalidateRegion();
+	if(markedNodes.size()==1)
+		scrollToSelection();
+}
+
+void TreeView::unmarkNode(node_t node) {
+	if(markedNodes.erase(node)>0)
+		invalidateRegion();
+}
+
+//! (internal)
+size_t TreeView::getCursorRow() {
+	if(markedNodes.empty())
+		return npos;
+	if(!isNodeMarked(cursorNode)) { // the cursor has been unmarked
+		cursorNode = *markedNodes.begin();
+		cursorRowValid = false;
+	}
+	if(!cursorRowValid) {
+		cursorRow = findRow(cursorNode);
+		cursorRowValid = true;
+	}
+	return cursorRow;
+}
+//! (internal)
+bool TreeView::onModelRowClicked(const Geometry::Vec2 & localPos) {
+	if(rowHeight<=0 || localPos.y()+scrollPos<0)
+		return false;
+	const size_t index = static_cast<size_t>((localPos.y()+scrollPos)/rowHeight);
+	if(index>=rows.size())
+		return false;
+	const Row & row = rows[index];
+	const float x = row.depth*indentation;
+	if(row.hasChildren && localPos.x()>=x && localPos.x()<x+indentation) {
+		if(row.open)
+			collapseRow(index);
+		else
+			openRow(index);
+	} else {
+		if(getGUI().isCtrlPressed()) {
+			if(isNodeMarked(row.node))
+				unmarkNode(row.node);
+			else
+				markNode(row.node,index);
+		} else {
+			unmarkAll();
+			markNode(row.node,index);
+		}
+		markingChanged();
+	}
+	return true;
+}
+
+//! (internal) Display the markings and the open/collapse markers of the rows in view.
+void TreeView::displayModelRows() {
+	if(rowHeight<=0)
+		return;
+	auto shape_marking = getGUI().getStyleManager().getShape(PROPERTY_TREEVIEW_ENTRY_MARKING_SHAPE);
+	auto shape_subgroup = getGUI().getStyleManager().getShape(PROPERTY_TREEVIEW_SUBROUP_SHAPE);
+	const float markerHeight = std::min(rowHeight,20.0f);
+	const size_t end = std::min(rows.size(),static_cast<size_t>((scrollPos+getHeight())/rowHeight)+1);
+	for(size_t index = static_cast<size_t>(scrollPos/rowHeight); index < end; ++index) {
+		const Row & row = rows[index];
+		const float y = index*rowHeight-scrollPos;
+		if(!markedNodes.empty() && isNodeMarked(row.node))
+			shape_marking->display(Geometry::Rect(0,y,getWidth(),rowHeight));
+		if(row.hasChildren)
+			shape_subgroup->display(Geometry::Rect(row.depth*indentation+1,y+1,8,markerHeight),row.open ? AbstractShape::ACTIVE : 0);
+	}
+}
+
+//! (internal)
+void TreeView::updateVisibleRows() {
+	static const size_t overscan = 2;
+	const size_t count = rows.size();
+	const size_t firstInView = rowHeight>0 ? static_cast<size_t>(scrollPos/rowHeight) : 0;
+	const size_t endInView = rowHeight>0 ? static_cast<size_t>((scrollPos+getHeight())/rowHeight)+1 : count;
+	const size_t begin = std::min(count, firstInView > overscan ? firstInView - overscan : 0);
+	const size_t end = std::min(count, endInView + overscan);
+
+	if(rowsOutdated || begin != firstVisibleRow || end - begin != visibleRows.size()) {
+		// keep the rows that stay in view; the others are reused for the new rows.
+		std::vector<Component*> newRows(end - begin, nullptr);
+		std::vector<Component*> reusableRows;
+		for(size_t i = 0; i < visibleRows.size(); ++i) {
+			const size_t index = firstVisibleRow + i;
+			if(!rowsOutdated && index >= begin && index < end)
+				newRows[index - begin] = visibleRows[i];
+			else
+				reusableRows.push_back(visibleRows[i]);
+		}
+		for(size_t i = 0; i < newRows.size(); ++i) {
+			if(newRows[i] != nullptr)
+				continue;
+			Component * row;
+			if(!reusableRows.empty()) {
+				row = reusableRows.back();
+				reusableRows.pop_back();
+			} else if(!unusedRows.empty()) {
+				row = unusedRows.back().get();
+				_insertAfter(unusedRows.back(), root.get()); // keep the scroll bar in front
+				unusedRows.pop_back();
+			} else {
+				const Ref newRow = model->createRow(getGUI());
+				if(newRow.isNull())
+					throw std::logic_error("TreeView: The model did not create a row.");
+				_insertAfter(newRow, root.get());
+				row = newRow.get();
+			}
+			model->updateRow(*row, rows[begin + i].node, rows[begin + i].depth);
+			newRows[i] = row;
+		}
+		for(Component * row : reusableRows) {
+			unusedRows.emplace_back(row);
+			_removeChild(row);
+		}
+		visibleRows.swap(newRows);
+		firstVisibleRow = begin;
+		rowsOutdated = false;
+	}
+	// the rows are children of the tree view, so they are moved when scrolling
+	for(size_t i = 0; i < visibleRows.size(); ++i) {
+		const Row & row = rows[firstVisibleRow + i];
+		const float x = (row.depth + 1) * indentation;
+		Component * c = visibleRows[i];
+		c->setPosition(Geometry::Vec2(x, (firstVisibleRow + i) * rowHeight - scrollPos));
+		c->setWidth(getWidth() - x);
+		c->layout();
+	}
+}
+
+//! (internal)
+void TreeView::releaseRows() {
+	for(Component * row : visibleRows) {
+		unusedRows.emplace_back(row);
+		_removeChild(row);
+	}
+	visibleRows.clear();
+	firstVisibleRow = 0;
+}
+
+// ------------------------------------------------------------------------------------------------------------
+// Type-ahead search
+
+void TreeView::entryLabelsChanged() {
+	typeAheadIndexValid = false;
+}
+
+//! (internal)
+void TreeView::updateTypeAheadIndex(Component * c,bool add) {
+	TreeViewEntry * entry = castTo<TreeViewEntry>(c);
+	if(!typeAheadIndexValid || entry==nullptr)
+		return;
+	const auto id = reinterpret_cast<TypeAheadIndex::id_t>(entry);
+	if(add && entry!=root.get())
+		typeAheadIndex.set(id,getEntryLabel(entry));
+	else
+		typeAheadIndex.remove(id);
+	for(Component * child = entry->getFirstChild(); child!=nullptr; child = child->getNext())
+		updateTypeAheadIndex(child,add);
+}
+
+//! (internal)
+void TreeView::assertTypeAheadIndexValid() {
+	if(typeAheadIndexValid)
+		return;
+	typeAheadIndex.clear();
+	typeAheadIndexValid = true;
+	if(model.isNotNull()) {
+		for(const auto & row : rows)
+			typeAheadIndex.set(row.node,model->getNodeText(row.node));
+	} else {
+		updateTypeAheadIndex(root.get(),true);
+	}
+}
+
+//! (internal)
+bool TreeView::isEntryBefore(TypeAheadIndex::id_t a,TypeAheadIndex::id_t b) {
+	if(model.isNull())
+		return TypeAheadIndex::isBeforeInTree(reinterpret_cast<TreeViewEntry *>(a),reinterpret_cast<TreeViewEntry *>(b));
+	if(nodeRows.empty()) {
+		nodeRows.reserve(rows.size());
+		for(size_t index = 0; index < rows.size(); ++index)
+			nodeRows.emplace(rows[index].node,index);
+	}
+	return nodeRows[a] < nodeRows[b];
+}
+
+//! (internal)
+bool TreeView::onTypeAheadInput(const Util::UI::KeyboardEvent & keyEvent) {
+	if(getGUI().isCtrlPressed() || !typeAheadIndex.appendInput(keyEvent,getGUI().getTimerWheel().getTime()))
+		return false;
+	assertTypeAheadIndexValid();
+
+	const bool hasCurrent = model.isNotNull() ? markedNodes.size()==1 : markedEntryIndices.size()==1;
+	const TypeAheadIndex::id_t current = !hasCurrent ? 0 : (model.isNotNull() ? *markedNodes.begin() :
+			reinterpret_cast<TypeAheadIndex::id_t>(getFirstMarkedEntry()));
+	TypeAheadIndex::id_t id;
+	// a found entry whose label has changed in the meantime is re-indexed and the search is repeated
+	for(size_t attempts = typeAheadIndex.size(); attempts>0 && typeAheadIndex.search(hasCurrent,current,id); --attempts) {
+		if(model.isNotNull()) {
+			if(typeAheadIndex.set(id,model->getNodeText(id)))
+				continue;
+			unmarkAll();
+			markNode(id);
+		} else {
+			TreeViewEntry * entry = reinterpret_cast<TreeViewEntry *>(id);
+			if(typeAheadIndex.set(id,getEntryLabel(entry)))
+				continue;
+			for(Component * c = entry->getParent(); c!=nullptr && c!=this; c = c->getParent()) {
+				TreeViewEntry * ancestor = castTo<TreeViewEntry>(c);
+				if(ancestor!=nullptr && ancestor->isCollapsed())
+					ancestor->open();
+			}
+			unmarkAll();
+			markEntry(entry);
+		}
+		markingChanged();
+		break;
+	}
+	return true;
+}
 }
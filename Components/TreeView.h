@@ -11,10 +11,17 @@
 #ifndef GUI_TREEVIEW_H
 #define GUI_TREEVIEW_H
 
+#include "AbstractTreeViewModel.h"
 #include "Container.h"
 #include "Label.h"
 #include "../Base/ListenerHelper.h"
+#include "../Base/TypeAheadIndex.h"
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace GUI {
 class Scrollbar;
@@ -33,6 +40,8 @@ class TreeView: public Container {
 		class TreeViewEntry: public Container {
 				PROVIDES_TYPE_NAME(TreeViewEntry)
 			public:
+				static const kind_t KIND=Container::KIND|KIND_TREE_VIEW_ENTRY;
+				typedef TreeViewEntry kindClass_t;
 
 				GUIAPI static const Util::StringIdentifier ACTION_TreeViewEntry_collapse;
 				GUIAPI static const Util::StringIdentifier ACTION_TreeViewEntry_open;
@@ -42,8 +51,13 @@ class TreeView: public Container {
 				GUIAPI TreeViewEntry(GUI_Manager & gui,TreeView * myTreeView,Component * c=nullptr,flag_t flags=0);
 				GUIAPI virtual ~TreeViewEntry();
 
-				//! ---|> Component
+				/*! ---|> Component
+					Only the children behind a changed child are moved (by the change of its height); the entry's
+					own height change is passed to the parent without invalidating the layout of the subtree.
+					So opening or collapsing an entry does not relayout the rest of the tree.	*/
 				GUIAPI virtual void doLayout() override;
+				//! ---|> Container
+				GUIAPI virtual void childRectChanged(Component * c) override;
 
 				//! (internal) should only be called from within the owning TreeView
 				void _setMarked(bool b)			{	marked=b;	}
@@ -75,6 +89,7 @@ class TreeView: public Container {
 				TreeView * myTreeView;
 				bool marked;
 				MouseButtonListener mouseButtonListener;
+				size_t firstOutdatedChild; //!< index of the first child that has to be moved during the next layout
 
 				GUIAPI void unmarkSubtree(Component * root)const;
 		};
@@ -82,6 +97,8 @@ class TreeView: public Container {
 		GUIAPI TreeView(GUI_Manager & gui,const Geometry::Rect & r,const std::string & actionName="",flag_t flags=0);
 		GUIAPI virtual ~TreeView();
 
+		static const size_t npos = static_cast<size_t>(-1);
+
 		TreeViewEntry * getRootEntry()const					{	return root.get();	}
 		Util::StringIdentifier getActionName()const			{	return actionName;	}
 
@@ -96,6 +113,8 @@ class TreeView: public Container {
 
 		GUIAPI void markComponent(Component * c);
 		GUIAPI void unmarkComponent(Component * c);
+		/*! The components of the marked entries (in the order in which they have been marked).
+			\note In model mode, the list is empty (use getMarkedNodes() instead).	*/
 		GUIAPI std::vector<Component*> getMarkedComponents();
 		GUIAPI void markingChanged();
 
@@ -119,7 +138,11 @@ class TreeView: public Container {
 		Geometry::Vec2 currentMousePos;
 
 	protected:
-		std::vector<Util::Reference<TreeViewEntry>> markedEntries;
+		//! The first marked entry that is still marked (or nullptr).
+		TreeViewEntry * getFirstMarkedEntry()const;
+
+		std::vector<Util::Reference<TreeViewEntry>> markedEntries; // in marking order; unmarked entries are nullptr until the vector is compacted
+		std::unordered_map<const TreeViewEntry*,size_t> markedEntryIndices; // entry -> index in markedEntries
 		Util::StringIdentifier actionName;
 		Util::WeakPointer<TreeViewEntry> root;
 		float scrollPos;
@@ -130,6 +153,120 @@ class TreeView: public Container {
 		KeyListener keyListener;
 		MouseButtonListener mouseButtonListener;
 		OptionalMouseMotionListener optionalMouseMotionListener;
+
+	private:
+		//! Height of the tree's contents (used for scrolling).
+		float getContentHeight()const;
+
+	// ------------------
+
+	//! @name Model
+	//	@{
+	public:
+		typedef AbstractTreeViewModel::node_t node_t;
+
+		/*! Let the tree be provided by the given model (or by the entries if @p m is nullptr); the current
+			entries are removed. In model mode, the opened part of the tree is kept as a flat list of rows
+			(node and depth). Opening or collapsing a node inserts or removes the range of its descendants'
+			rows; only the rows in view are represented by components, which are reused while scrolling.
+			The contents can not be changed directly; clearContents() only discards the row components.	*/
+		GUIAPI void setModel(const Util::Reference<AbstractTreeViewModel> & m);
+		AbstractTreeViewModel * getModel()const				{	return model.get();	}
+		/*! Has to be called when the structure of the model has changed: The rows are rebuilt and
+			the opened nodes that are still present stay opened.	*/
+		GUIAPI void modelChanged();
+		//! Has to be called when the contents of the rows [@p first, @p first+@p count) have changed.
+		GUIAPI void rowsChanged(size_t first,size_t count);
+
+		//! Number of rows (the nodes whose ancestors are all opened).
+		size_t getRowCount()const							{	return rows.size();	}
+		node_t getRowNode(size_t row)const					{	return rows.at(row).node;	}
+		size_t getRowDepth(size_t row)const					{	return rows.at(row).depth;	}
+		bool isRowOpen(size_t row)const						{	return rows.at(row).open;	}
+		/*! Return the row showing the given node or npos if the node is not visible (linear search).
+			The row of the last marked node is tracked while rows are opened or collapsed, so the
+			keyboard navigation and scrollToSelection() do not search.	*/
+		GUIAPI size_t findRow(node_t node)const;
+		//! Request the children of the row's node from the model and insert them as rows behind it.
+		GUIAPI void openRow(size_t row);
+		//! Remove the rows of the node's descendants; opened descendants are collapsed as well.
+		GUIAPI void collapseRow(size_t row);
+
+		//! Height of each row in model mode (default: PROPERTY_TREEVIEW_DEFAULT_ENTRY_HEIGHT).
+		float getRowHeight()const							{	return rowHeight;	}
+		GUIAPI void setRowHeight(float h);
+
+		//! Markings of the nodes in model mode (they are kept if the node's row is collapsed).
+		GUIAPI void markNode(node_t node);
+		GUIAPI void unmarkNode(node_t node);
+		bool isNodeMarked(node_t node)const					{	return markedNodes.count(node)>0;	}
+		const std::unordered_set<node_t> & getMarkedNodes()const	{	return markedNodes;	}
+
+	private:
+		struct Row{
+			node_t node;
+			uint32_t depth;
+			bool open;
+			bool hasChildren;
+			Row(node_t _node,uint32_t _depth,bool _hasChildren) : node(_node),depth(_depth),open(false),hasChildren(_hasChildren) {}
+		};
+		//! (internal) Append the rows of the children of @p node; the children contained in @p openNodes are opened as well.
+		void collectRows(node_t node,uint32_t depth,const std::unordered_set<node_t> & openNodes,std::vector<Row> & result);
+		//! (internal) Called by the layout: assign row components to the rows in view.
+		GUIAPI void updateVisibleRows();
+		//! (internal) Remove all row components and keep them for reuse.
+		GUIAPI void releaseRows();
+		//! (internal) Throws if the contents are provided by a model.
+		void assertHasNoModel()const;
+		//! (internal) Handle a click at the given local position in model mode.
+		bool onModelRowClicked(const Geometry::Vec2 & localPos);
+		//! (internal) Mark @p node whose row is @p row (npos if unknown) and make it the cursor.
+		void markNode(node_t node,size_t row);
+		//! (internal) Row of the cursor (the last marked node) or npos; it is only searched if it is unknown.
+		size_t getCursorRow();
+		void displayModelRows();
+		//! (internal) Scroll (animated) so that the range [@p yPos, @p yPos+@p height) of the contents is in view.
+		void scrollIntoView(float yPos,float height);
+
+		Util::Reference<AbstractTreeViewModel> model;
+		std::vector<Row> rows;
+		std::vector<Component*> visibleRows; // visibleRows[i] shows row firstVisibleRow+i
+		size_t firstVisibleRow;
+		std::vector<Ref> unusedRows;
+		std::unordered_set<node_t> markedNodes;
+		node_t cursorNode;
+		size_t cursorRow; // row of cursorNode, npos if it is hidden in a collapsed row
+		bool cursorRowValid; // false if cursorRow has to be searched
+		float rowHeight;
+		bool rowsOutdated;
+	//	@}
+
+	// ------------------
+
+	//! @name Type-ahead search
+	//	@{
+	public:
+		/*! Typed characters mark the first entry whose label begins with them (see TypeAheadIndex); collapsed
+			entries containing the found entry are opened. The label of an entry is the text of the first Label of its
+			component. In model mode, the labels are provided by AbstractTreeViewModel::getNodeText() and only the
+			nodes having a row (i.e. whose ancestors are opened) are found.
+			The index of the labels is built on the first input and is updated when entries are inserted or removed
+			(or rows are opened or collapsed). Call entryLabelsChanged() if labels of existing entries have changed.	*/
+		GUIAPI void entryLabelsChanged();
+		TypeAheadIndex & getTypeAheadIndex()				{	return typeAheadIndex;	}
+	private:
+		//! (internal) Returns false if the event contains no printable character.
+		GUIAPI bool onTypeAheadInput(const Util::UI::KeyboardEvent & keyEvent);
+		//! (internal) Add (or remove) the entries of the subtree of @p c to (or from) the index (if it is already built).
+		void updateTypeAheadIndex(Component * c,bool add);
+		//! (internal) Build the index if necessary.
+		void assertTypeAheadIndexValid();
+		//! (internal) The order of entries with equal labels: the order of the entries in the tree (or of the rows).
+		bool isEntryBefore(TypeAheadIndex::id_t a,TypeAheadIndex::id_t b);
+		TypeAheadIndex typeAheadIndex; // the ids are the TreeViewEntries (or the nodes in model mode)
+		bool typeAheadIndexValid;
+		std::unordered_map<node_t,size_t> nodeRows; // node -> row; built for ordering nodes with equal labels, empty if outdated
+	//	@}
 };
 }
 #endif // GUI_TreeView_H
@@ -22,9 +22,11 @@
 #include "Components/ListView.h"
 #include "Components/Menu.h"
 #include "Components/Panel.h"
+#include "Components/Plot.h"
 #include "Components/Slider.h"
 #include "Components/Splitter.h"
 #include "Components/Tab.h"
+#include "Components/Table.h"
 #include "Components/Textarea.h"
 #include "Components/Textfield.h"
 #include "Components/Image.h"
@@ -38,6 +40,7 @@
 #include "Base/ImageData.h"
 #include "Base/ListenerHelper.h"
 #include "Base/StyleManager.h"
+#include "Base/WorkerPool.h"
 #include "Style/Style.h"
 #include "Style/Colors.h" // \todo remove this!
 
@@ -48,7 +51,6 @@
 #include <Util/UI/EventContext.h>
 #include <Util/UI/UI.h>
 #include <Util/UI/Window.h>
-#include <Util/Timer.h>
 #include <Rendering/RenderingContext/RenderingContext.h>
 
 #include <algorithm>
@@ -148,7 +150,7 @@ class MouseCursorHandler {
  */
 class TooltipHandler : public Component {
 		Util::Reference<Component> activeComponent;
-		float startingTime;
+		TimerWheel::handle_t activationTimer;
 		Vec2 lastMousePos;
 		std::string text;
 		enum mode_t{
@@ -156,11 +158,12 @@ class TooltipHandler : public Component {
 		} mode;
 		FrameListenerHandle frameListenerHandle;
 		MouseMotionListener mouseMotionListener;
+		static constexpr double tooltipDelay = 0.250; // sec
 	public:
 
 		TooltipHandler(GUI_Manager & _gui) : 
 			Component(_gui),
-			startingTime(0),
+			activationTimer(0),
 			mode(SEARCHING),
 			frameListenerHandle(_gui.addFrameListener(std::bind(&TooltipHandler::onFrame,
 																this,
@@ -169,6 +172,7 @@ class TooltipHandler : public Component {
 		}
 		virtual ~TooltipHandler() {
 			getGUI().removeFrameListener(std::move(frameListenerHandle));
+			getGUI().getTimerWheel().cancel(activationTimer);
 		}
 
 		Component * findTooltitComponent(const Vec2 & pos)const{
@@ -190,18 +194,15 @@ class TooltipHandler : public Component {
 			switch(mode){
 				case ACTIVE:{
 					if(activeComponent.isNull()){
-						startingTime=static_cast<float>(Util::Timer::now());
 						mode=SEARCHING;
 						invalidateRegion();
 					}
 					break;
 				}
 				case SEARCHING:{
-					startingTime=static_cast<float>(Util::Timer::now());
 					break;
 				}
 				case INACTIVE:{
-					startingTime=static_cast<float>(Util::Timer::now());
 					mode=SEARCHING;
 					invalidateRegion();
 					break;
@@ -209,16 +210,21 @@ class TooltipHandler : public Component {
 				default:
 					WARN("unexpected case in switch statement");
 			}
-//                std::cout <<  startingTime <<"; ";
+			if(mode==SEARCHING){ // (re)start the delay
+				TimerWheel & timerWheel = getGUI().getTimerWheel();
+				timerWheel.cancel(activationTimer);
+				activationTimer = timerWheel.scheduleIn(tooltipDelay,std::bind(&TooltipHandler::onDelayElapsed,this));
+			}
 			return false;
 		}
-		void onFrame(double timeSecs) {
-			if(mode==INACTIVE){
-				return;
-			}else if(mode==SEARCHING && timeSecs-startingTime > 0.250){
+		void onDelayElapsed() {
+			activationTimer = 0;
+			if(mode==SEARCHING){
 				mode=activeComponent.isNull() ? INACTIVE : ACTIVE;
 				invalidateRegion();
 			}
+		}
+		void onFrame(double /*timeSecs*/) {
 			if(mode!=ACTIVE)
 				return;
 
@@ -271,8 +277,12 @@ class TooltipHandler : public Component {
 
 //! (ctor)
 GUI_Manager::GUI_Manager(Util::UI::EventContext * context) : 
-		eventContext(context), window(nullptr), debugMode(0),
-		lazyRendering(false), style(new StyleManager),
+		eventContext(context), window(nullptr),
+		motionHistoryUsers(0), receivedEventCount(0), dispatchedEventCount(0), debugMode(0), lastComponentListenerHandle(0), keyRepeatTimer(0),
+		deferDataChanges(false),
+		lazyRendering(false), parallelLayoutRunning(false), dataChangesDeferredBeforeParallelLayout(false),
+		postedTaskTimeBudget(0.004), redrawRequested(true),
+		style(new StyleManager),
 		mouseCursorHandler(new MouseCursorHandler(*this)),
 		tooltipHandler(new TooltipHandler(*this)){
 	globalContainer=new GlobalContainer(*this,Rect(0,0,1280,1024));
@@ -309,8 +319,9 @@ bool GUI_Manager::isShiftPressed() const {
 
 //! (internal)
 bool GUI_Manager::handleMouseMovement(const Util::UI::MotionEvent & motionEvent){
-	// Use a copy to allow insertions and deletions.
-	for(const auto & handleMouseMoveFun : globalMouseMotionListener.getElementsCopy()) {
+	// Keep the snapshot to allow insertions and deletions.
+	const auto listeners = globalMouseMotionListener.getSnapshot();
+	for(const auto & handleMouseMoveFun : *listeners) {
 		if(handleMouseMoveFun(nullptr, motionEvent)) {
 			return true;
 		}
@@ -320,12 +331,10 @@ bool GUI_Manager::handleMouseMovement(const Util::UI::MotionEvent & motionEvent)
 
 //! (internal)
 bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
-	// Handle global listeners
-	// Use nullptr as component to access global registry.
-	const auto globalIt = mouseButtonListener.find(nullptr);
-	if(globalIt != mouseButtonListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & handleMouseButtonFun : globalIt->second.getElementsCopy()) {
+	{	// Handle global listeners
+		// Keep the snapshot to allow insertions and deletions.
+		const auto listeners = globalMouseButtonListener.getSnapshot();
+		for(const auto & handleMouseButtonFun : *listeners) {
 			if(handleMouseButtonFun(nullptr, buttonEvent)) {
 				return true;
 			}
@@ -340,11 +349,11 @@ bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
 			c.isNotNull() && c->isEnabled() && c->coversAbsPosition(absPos);
 			c=c->getParent() ){
 
-		const auto componentIt = mouseButtonListener.find(c.get());
-		if(componentIt == mouseButtonListener.cend()) {
+		if(!c->hasListeners(Component::LISTENER_MOUSE_BUTTON)) {
 			continue;
 		}
-		for(const auto & handleMouseButtonFun : componentIt->second.getElementsCopy()) {
+		const auto listeners = c->_getListeners()->mouseButton.getSnapshot();
+		for(const auto & handleMouseButtonFun : *listeners) {
 			if(!(handleMouseButtonFun(c.get(), buttonEvent))) {
 				continue;
 			}
@@ -353,11 +362,11 @@ bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
 			if (buttonEvent.pressed || c!=lastActive)
 				return true;
 
-			const auto clickIt = mouseClickListener.find(c.get());
-			if(clickIt != mouseClickListener.cend()) {
+			if(c->hasListeners(Component::LISTENER_MOUSE_CLICK)) {
 				const Geometry::Vec2 localPos = absPos - c->getAbsPosition();
-				// Use a copy to allow insertions and deletions.
-				for(const auto & clickListener : clickIt->second.getElementsCopy()) {
+				// Keep the snapshot to allow insertions and deletions.
+				const auto clickListeners = c->_getListeners()->mouseClick.getSnapshot();
+				for(const auto & clickListener : *clickListeners) {
 					if(clickListener(c.get(), buttonEvent.button, localPos)) {
 						break;
 					}
@@ -374,14 +383,14 @@ bool GUI_Manager::handleMouseButton(const Util::UI::ButtonEvent & buttonEvent) {
 
 //! (internal)
 bool GUI_Manager::handleKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
-	if(!keyEvent.pressed && keyRepeatInfo.get()!=nullptr){
-		keyRepeatInfo.reset(nullptr);
+	if(!keyEvent.pressed && repeatedKeyEvent.get()!=nullptr){
+		disableKeyRepetition();
 	}
 	for(Component::Ref c=globalContainer->findSelectedComponent();c!=nullptr && c->isEnabled(); c=c->getParent() ){
-		const auto it = keyListener.find(c.get());
-		if(it != keyListener.cend()) {
-			// Use a copy to allow insertions and deletions.
-			for(const auto & fun : it->second.getElementsCopy()) {
+		if(c->hasListeners(Component::LISTENER_KEY)) {
+			// Keep the snapshot to allow insertions and deletions.
+			const auto listeners = c->_getListeners()->key.getSnapshot();
+			for(const auto & fun : *listeners) {
 				const bool consumed = fun(keyEvent);
 				if(consumed) {
 					return true;
@@ -408,12 +417,79 @@ bool GUI_Manager::handleKeyEvent(const Util::UI::KeyboardEvent & keyEvent) {
 }
 
 bool GUI_Manager::handleEvent(const Util::UI::Event & e) {
+	++receivedEventCount;
+	if(e.type == Util::UI::EVENT_MOUSE_MOTION){
+		currentMotionHistory.clear();
+		currentMotionHistory.push_back(e.motion);
+	}
+	return dispatchEvent(e);
+}
+
+void GUI_Manager::queueEvent(const Util::UI::Event & e) {
+	++receivedEventCount;
+	if(e.type == Util::UI::EVENT_MOUSE_MOTION){
+		if(isMotionHistoryEnabled())
+			queuedMotionHistory.push_back(e.motion);
+		// collapse with the previous motion event
+		if(!eventQueue.empty() && eventQueue.back().event.type == Util::UI::EVENT_MOUSE_MOTION){
+			QueuedEvent & prev = eventQueue.back();
+			const float deltaX = prev.event.motion.deltaX + e.motion.deltaX;
+			const float deltaY = prev.event.motion.deltaY + e.motion.deltaY;
+			prev.event = e;
+			prev.event.motion.deltaX = deltaX;
+			prev.event.motion.deltaY = deltaY;
+			prev.historyEnd = queuedMotionHistory.size();
+			return;
+		}
+	}
+	QueuedEvent queuedEvent;
+	queuedEvent.event = e;
+	queuedEvent.historyBegin = e.type == Util::UI::EVENT_MOUSE_MOTION && isMotionHistoryEnabled() ? queuedMotionHistory.size()-1 : queuedMotionHistory.size();
+	queuedEvent.historyEnd = queuedMotionHistory.size();
+	eventQueue.push_back(queuedEvent);
+}
+
+bool GUI_Manager::processQueuedEvents() {
+	bool consumed = false;
+	// swap the queue, as events may be queued while dispatching
+	std::vector<QueuedEvent> events;
+	std::vector<Util::UI::MotionEvent> motionHistory;
+	events.swap(eventQueue);
+	motionHistory.swap(queuedMotionHistory);
+	for(const auto & queuedEvent : events){
+		if(queuedEvent.event.type == Util::UI::EVENT_MOUSE_MOTION){
+			currentMotionHistory.clear();
+			if(queuedEvent.historyBegin<queuedEvent.historyEnd)
+				currentMotionHistory.assign(motionHistory.begin()+queuedEvent.historyBegin,motionHistory.begin()+queuedEvent.historyEnd);
+			else
+				currentMotionHistory.push_back(queuedEvent.event.motion);
+		}
+		consumed |= dispatchEvent(queuedEvent.event);
+	}
+	// keep the allocated memory for the next frame
+	if(eventQueue.empty()){
+		events.clear();
+		eventQueue.swap(events);
+	}
+	if(queuedMotionHistory.empty()){
+		motionHistory.clear();
+		queuedMotionHistory.swap(motionHistory);
+	}
+	return consumed;
+}
+
+//! (internal)
+bool GUI_Manager::dispatchEvent(const Util::UI::Event & e) {
+	++dispatchedEventCount;
 	switch(e.type) {
 		case Util::UI::EVENT_MOUSE_BUTTON:
+			requestRedraw();
 			return handleMouseButton(e.button);
 		case Util::UI::EVENT_MOUSE_MOTION:
+			requestRedraw();
 			return handleMouseMovement(e.motion);
 		case Util::UI::EVENT_KEYBOARD:
+			requestRedraw();
 			return handleKeyEvent(e.keyboard);
 		case Util::UI::EVENT_JOY_AXIS:
 		case Util::UI::EVENT_JOY_BUTTON:
@@ -427,13 +503,29 @@ bool GUI_Manager::handleEvent(const Util::UI::Event & e) {
 }
 
 void GUI_Manager::enableKeyRepetition(const Util::UI::KeyboardEvent & keyEvent){
-	if(keyRepeatInfo.get()==nullptr || keyRepeatInfo->second.key != keyEvent.key){
-		keyRepeatInfo.reset( new std::pair<float,Util::UI::KeyboardEvent>(
-				static_cast<float>(Util::Timer::now())+ getGlobalValue(PROPERTY_KEY_REPEAT_DELAY_1),keyEvent) );
+	if(repeatedKeyEvent.get()==nullptr || repeatedKeyEvent->key != keyEvent.key){
+		repeatedKeyEvent.reset(new Util::UI::KeyboardEvent(keyEvent));
+		scheduleKeyRepetition(getGlobalValue(PROPERTY_KEY_REPEAT_DELAY_1));
 	}
 }
 void GUI_Manager::disableKeyRepetition(){
-	keyRepeatInfo.reset(nullptr);
+	repeatedKeyEvent.reset(nullptr);
+	timerWheel.cancel(keyRepeatTimer);
+	keyRepeatTimer = 0;
+}
+
+//! (internal)
+void GUI_Manager::scheduleKeyRepetition(double delay){
+	timerWheel.cancel(keyRepeatTimer);
+	keyRepeatTimer = timerWheel.scheduleIn(delay,[this](double){
+		keyRepeatTimer = 0;
+		if(repeatedKeyEvent.get()!=nullptr){
+			const Util::UI::KeyboardEvent keyEvent(*repeatedKeyEvent);
+			// schedule first, as handling the event may disable the repetition.
+			scheduleKeyRepetition(getGlobalValue(PROPERTY_KEY_REPEAT_DELAY_2));
+			handleKeyEvent(keyEvent);
+		}
+	});
 }
 		
 // ------------------------------------------------------------------------
@@ -448,7 +540,18 @@ void GUI_Manager::unregisterWindow(Component *w){
 }
 
 void GUI_Manager::invalidateRegion(const Rect & region){
+	const auto lock = _lockSharedState();
 	invalidRegion.include(region);
+	requestRedraw();
+}
+
+bool GUI_Manager::needsRedraw()const{
+	return redrawRequested || !eventQueue.empty() || postQueue.getPendingCount()>0 || hasPendingDataChanges() || !animator.empty() || !removalList.empty() ||
+			!globalContainer->getFlag(Component::LAYOUT_VALID) || !globalContainer->getFlag(Component::SUBTREE_LAYOUT_VALID);
+}
+
+double GUI_Manager::getNextWakeupTime()const{
+	return timerWheel.getNextDeadline();
 }
 
 #ifdef GUI_BACKEND_RENDERING
@@ -471,8 +574,28 @@ void GUI_Manager::display()
 			Draw::beginDrawing(Geometry::Vec2i(viewport.getWidth(),viewport.getHeight()));
 		#endif // GUI_BACKEND_RENDERING
 	}
+	displayFrame();
+	Draw::endDrawing();
+}
 
-			
+std::shared_ptr<const DrawList> GUI_Manager::recordFrame(const Geometry::Vec2i & screenSize){
+	#ifdef GUI_BACKEND_RENDERING
+		Geometry::Vec2 renderScale(static_cast<float>(screenSize.getWidth()) / globalContainer->getWidth(), static_cast<float>(screenSize.getHeight()) / globalContainer->getHeight());
+		Draw::beginRecording(screenSize, renderScale);
+	#else // GUI_BACKEND_RENDERING
+		globalContainer->setSize(static_cast<float>(screenSize.getWidth()), static_cast<float>(screenSize.getHeight()));
+		Draw::beginRecording(screenSize);
+	#endif // GUI_BACKEND_RENDERING
+	displayFrame();
+	return Draw::endRecording();
+}
+
+//! (internal)
+void GUI_Manager::displayFrame(){
+	processQueuedEvents();
+	postQueue.execute(postedTaskTimeBudget,[this](){	return timerWheel.getTime();	});
+	timerWheel.execute();
+	flushDataChanges();
 	cleanup();
 	executeAnimations();
 
@@ -493,6 +616,10 @@ void GUI_Manager::display()
 			lastLayoutCount = layoutCount;
 		}
 	}
+	
+	{ // reset idle state; changes made while drawing or by frame listeners trigger another frame.
+		redrawRequested = false;
+	}
 
 	if(isLazyRenderingEnabled()){
 		Draw::drawLineRect(invalidRegion,Util::Color4ub(255,0,0,128));
@@ -510,19 +637,13 @@ void GUI_Manager::display()
 
 	
 	{ // execute frameListeners
-		const double time = Util::Timer::now();
-		// Use a copy to allow insertions and deletions.
-		for(const auto & fun : frameListener.getElementsCopy()) {
+		const double time = timerWheel.getTime();
+		// Keep the snapshot to allow insertions and deletions.
+		const auto listeners = frameListener.getSnapshot();
+		for(const auto & fun : *listeners) {
 			fun(time);
 		}
-
-		//! key repetition \note !!! This is not the proper place to do this, as this may introduce side effects !!!!
-		if(keyRepeatInfo.get()!=nullptr && keyRepeatInfo->first < time){
-			keyRepeatInfo->first = static_cast<float>(time) + getGlobalValue(PROPERTY_KEY_REPEAT_DELAY_2);
-			handleKeyEvent(keyRepeatInfo->second);
-		}
 	}
-	Draw::endDrawing();
 }
 
 void GUI_Manager::setActiveComponent(Component * c){
@@ -536,7 +657,7 @@ void GUI_Manager::unselectAll(){
 
 void GUI_Manager::closeAllMenus(){
 	for(Component * c = globalContainer->getFirstChild();c!=nullptr;c=c->getNext()){
-		if(Menu * m = dynamic_cast<Menu*>(c))
+		if(Menu * m = castTo<Menu>(c))
 			m->close();
 	}
 }
@@ -576,13 +697,14 @@ bool GUI_Manager::selectFirst(Component * c){
 		c->select();
 		return true;
 	}
-	Container * con=dynamic_cast<Container*>(c);
+	Container * con=castTo<Container>(c);
 	if(con==nullptr){
 		return false;
 	}
 
-	for(c=con->getFirstChild();c!=nullptr;c=c->getNext()){
-		if(selectFirst(c)){
+	// \note the children are only modified by the successful selection, which ends the iteration.
+	for(const auto & child : con->getChildren()){
+		if(selectFirst(child.get())){
 			return true;
 
 		}
@@ -598,19 +720,33 @@ bool GUI_Manager::selectLast(Component * c){
 		c->select();
 		return true;
 	}
-	Container * con=dynamic_cast<Container*>(c);
+	Container * con=castTo<Container>(c);
 	if(con==nullptr)
 		return false;
-	for(c=con->getLastChild();c!=nullptr;c=c->getPrev()){
-		if(selectLast(c))
+	const auto & children = con->getChildren();
+	for(auto it=children.rbegin();it!=children.rend();++it){
+		if(selectLast(it->get()))
 			return true;
 	}
 	return false;
 }
 
 void GUI_Manager::componentActionPerformed(Component * c, const Util::StringIdentifier & actionName) {
-	// Use a copy to allow insertions and deletions.
-	for(const auto & handleAction : actionListener.getElementsCopy()) {
+	// Listeners for the action's name
+	const auto namedIt = namedActionListener.find(actionName.getValue());
+	if(namedIt != namedActionListener.end()) {
+		// Keep the snapshot to allow insertions and deletions.
+		const auto listeners = namedIt->second.getSnapshot();
+		for(const auto & handleAction : *listeners) {
+			if(handleAction(c, actionName)) {
+				return;
+			}
+		}
+	}
+	// Wildcard listeners
+	// Keep the snapshot to allow insertions and deletions.
+	const auto listeners = actionListener.getSnapshot();
+	for(const auto & handleAction : *listeners) {
 		if(handleAction(c, actionName)) {
 			return;
 		}
@@ -618,37 +754,146 @@ void GUI_Manager::componentActionPerformed(Component * c, const Util::StringIden
 }
 
 void GUI_Manager::componentDataChanged(Component * component) {
+	const auto lock = _lockSharedState();
+	++dataChangeStatistics.reportedCount;
+	if(!deferDataChanges) {
+		++dataChangeStatistics.dispatchedCount;
+		dispatchDataChange(component);
+		return;
+	}
+	++componentDataChangeStatistics[component].reportedCount;
+	if(pendingDataChangeIndices.emplace(component, pendingDataChanges.size()).second) {
+		pendingDataChanges.push_back(component);
+		requestRedraw();
+	}
+}
+
+//! (internal)
+void GUI_Manager::dispatchDataChange(Component * component) {
 	// Inform component's data change listener
-	const auto componentIt = dataChangeListener.find(component);
-	if(componentIt != dataChangeListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & changeListener : componentIt->second.getElementsCopy()) {
+	if(component->hasListeners(Component::LISTENER_DATA_CHANGE)) {
+		// Keep the snapshot to allow insertions and deletions.
+		const auto listeners = component->_getListeners()->dataChange.getSnapshot();
+		for(const auto & changeListener : *listeners) {
 			changeListener(component);
 		}
 	}
-	// Inform global data change listeners
-	// Use nullptr as component to access global registry.
-	const auto globalIt = dataChangeListener.find(nullptr);
-	if(globalIt != dataChangeListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & changeListener : globalIt->second.getElementsCopy()) {
+	{	// Inform global data change listeners
+		// Keep the snapshot to allow insertions and deletions.
+		const auto listeners = globalDataChangeListener.getSnapshot();
+		for(const auto & changeListener : *listeners) {
 			changeListener(component);
 		}
 	}
 }
 
+void GUI_Manager::setDataChangesDeferred(bool b) {
+	deferDataChanges = b;
+	if(!deferDataChanges) {
+		flushDataChanges();
+	}
+}
+
+void GUI_Manager::flushDataChanges() {
+	// A listener disabling the deferred mode must not start a nested flush; the outer one continues.
+	if(!dispatchedDataChanges.empty()) {
+		return;
+	}
+	// Listeners may report further changes, which are dispatched in the following rounds.
+	// Limit the number of rounds to not hang on cyclic dependencies; the rest is sent in the next frame.
+	for(int round = 0; round < 8 && !pendingDataChanges.empty(); ++round) {
+		// The components are not referenced here (that could delete components without owner);
+		// components destroyed by a listener are set to nullptr by componentDestruction().
+		dispatchedDataChanges.swap(pendingDataChanges);
+		dispatchedDataChangeIndices.swap(pendingDataChangeIndices);
+		for(size_t i = 0; i < dispatchedDataChanges.size(); ++i) {
+			Component * const c = dispatchedDataChanges[i];
+			if(c != nullptr) {
+				++dataChangeStatistics.dispatchedCount;
+				++componentDataChangeStatistics[c].dispatchedCount;
+				dispatchDataChange(c);
+			}
+		}
+		dispatchedDataChanges.clear();
+		dispatchedDataChangeIndices.clear();
+	}
+}
+
+GUI_Manager::DataChangeStatistics GUI_Manager::getDataChangeStatistics(const Component * c) const {
+	const auto it = componentDataChangeStatistics.find(c);
+	return it == componentDataChangeStatistics.end() ? DataChangeStatistics() : it->second;
+}
+
+void GUI_Manager::resetDataChangeStatistics() {
+	dataChangeStatistics = DataChangeStatistics();
+	componentDataChangeStatistics.clear();
+}
+
 void GUI_Manager::componentDestruction(const Component * component) {
+	const auto lock = _lockSharedState();
+	if(!pendingDataChangeIndices.empty()) {
+		const auto it = pendingDataChangeIndices.find(component);
+		if(it != pendingDataChangeIndices.end()) {
+			pendingDataChanges[it->second] = nullptr;
+			pendingDataChangeIndices.erase(it);
+		}
+	}
+	if(!dispatchedDataChangeIndices.empty()) {
+		const auto it = dispatchedDataChangeIndices.find(component);
+		if(it != dispatchedDataChangeIndices.end()) {
+			dispatchedDataChanges[it->second] = nullptr;
+			dispatchedDataChangeIndices.erase(it);
+		}
+	}
+	// prune the statistics of destroyed components
+	if(!componentDataChangeStatistics.empty()) {
+		componentDataChangeStatistics.erase(component);
+	}
 	// Inform functions listening for a component's destruction
-	const auto componentIt = componentDestructionListener.find(component);
-	if(componentIt != componentDestructionListener.cend()) {
-		// Use a copy to allow insertions and deletions.
-		for(const auto & onComponentDestruction : componentIt->second.getElementsCopy()) {
+	if(component->hasListeners(Component::LISTENER_COMPONENT_DESTRUCTION)) {
+		// Keep the snapshot to allow insertions and deletions.
+		const auto listeners = component->_getListeners()->componentDestruction.getSnapshot();
+		for(const auto & onComponentDestruction : *listeners) {
 			onComponentDestruction();
 		}
-		componentDestructionListener.erase(componentIt);
+		// The listeners may have been removed in the meantime.
+		if(component->hasListeners(Component::LISTENER_COMPONENT_DESTRUCTION)) {
+			component->_getListeners()->componentDestruction = ComponentDestructionListenerRegistry();
+			component->_updateListenerKinds();
+		}
 	}
 }
 
+void GUI_Manager::setLayoutThreadCount(size_t count) {
+	if(parallelLayoutRunning) {
+		WARN("setLayoutThreadCount: The layout is running.");
+		return;
+	}
+	if(count <= 1) {
+		layoutWorkerPool.reset();
+	} else if(count != getLayoutThreadCount()) {
+		layoutWorkerPool.reset(new WorkerPool(count));
+	}
+}
+
+size_t GUI_Manager::getLayoutThreadCount() const {
+	return layoutWorkerPool ? layoutWorkerPool->getThreadCount() : 1;
+}
+
+WorkerPool * GUI_Manager::_beginParallelLayout() {
+	if(!layoutWorkerPool || parallelLayoutRunning)
+		return nullptr;
+	parallelLayoutRunning = true;
+	dataChangesDeferredBeforeParallelLayout = deferDataChanges;
+	deferDataChanges = true;
+	return layoutWorkerPool.get();
+}
+
+void GUI_Manager::_endParallelLayout() {
+	parallelLayoutRunning = false;
+	setDataChangesDeferred(dataChangesDeferredBeforeParallelLayout);
+}
+
 Component * GUI_Manager::getComponentAtPos(const Geometry::Vec2 & pos){
 	return globalContainer->getComponentAtPos(pos);
 }
@@ -691,6 +936,7 @@ void GUI_Manager::popScissor() {
 // -----------
 // ---- Cleanup
 void GUI_Manager::markForRemoval(Component *c){
+	const auto lock = _lockSharedState();
 	if(c!=nullptr)
 		removalList.push_back(c);
 }
@@ -709,56 +955,13 @@ void GUI_Manager::cleanup(){
 // ----------
 // ---- animation handling
 
-void GUI_Manager::addAnimationHandler(AnimationHandler * h){
-	animationHandlerList.emplace_back(h);
-	h->setStartTime( static_cast<float>(Util::Timer::now()) );
+Animator::handle_t GUI_Manager::addAnimationHandler(AnimationHandler * h){
+	return animator.add(h,static_cast<float>(timerWheel.getTime()));
 }
 
 //! (internal)
 void GUI_Manager::executeAnimations(){
-	const float t = static_cast<float>(Util::Timer::now());
-	animationHandlerList_t animationHandlerList2;
-	animationHandlerList2.reserve( animationHandlerList.size() );
-	std::swap(animationHandlerList2,animationHandlerList);
-
-	while( !animationHandlerList2.empty() ){
-		std::unique_ptr<AnimationHandler> handler = std::move(animationHandlerList2.back());
-		animationHandlerList2.pop_back();
-		if( handler->animate(t) ){
-			handler->updateLastTime(t);
-			animationHandlerList.emplace_back( std::move(handler) );
-		}
-	}
-}
-
-//! (internal)
-void GUI_Manager::finishAnimations(Component * c){
-	animationHandlerList_t animationHandlerList2;
-	animationHandlerList2.reserve( animationHandlerList.size() );
-	std::swap(animationHandlerList2,animationHandlerList);	
-	
-	while( !animationHandlerList2.empty() ){
-		std::unique_ptr<AnimationHandler> handler = std::move(animationHandlerList2.back());
-		animationHandlerList2.pop_back();
-		if( handler->getComponent()==c ){
-			handler->finish();
-		}else{
-			animationHandlerList.emplace_back( std::move(handler) );
-		}
-	}
-}
-//! (internal)
-void GUI_Manager::stopAnimations(Component * c){
-	animationHandlerList_t animationHandlerList2;
-	animationHandlerList2.reserve( animationHandlerList.size() );
-	std::swap(animationHandlerList2,animationHandlerList);	
-	
-	while( !animationHandlerList2.empty() ){
-		std::unique_ptr<AnimationHandler> handler = std::move(animationHandlerList2.back());
-		animationHandlerList2.pop_back();
-		if( handler->getComponent()!=c )
-			animationHandlerList.emplace_back( std::move(handler) );
-	}
+	animator.execute(static_cast<float>(timerWheel.getTime()));
 }
 
 // ----------
@@ -915,6 +1118,10 @@ Panel * GUI_Manager::createPanel(flag_t flags/*=0*/){
 	return new Panel(*this,flags);
 }
 
+//! [factory] Plot
+Plot * GUI_Manager::createPlot(const Geometry::Rect & r,flag_t flags/*=0*/){
+	return new Plot(*this,r,flags);
+}
 //! [factory] Slider
 Slider * GUI_Manager::createSlider(const Geometry::Rect & r,float left/*=0*/,float right/*=1*/,int steps/*=10*/,flag_t flags/*=0*/){
 	return new Slider(*this,r,left,right,steps,flags);
@@ -946,6 +1153,11 @@ Textfield * GUI_Manager::createTextfield(const std::string &text/*=""*/,flag_t f
 	return new Textfield(*this,text,flags);
 }
 
+//! [factory] Table
+Table * GUI_Manager::createTable(flag_t flags/*=0*/){
+	return new Table(*this,flags);
+}
+
 //! [factory] TreeView
 TreeView * GUI_Manager::createTreeView(const Geometry::Rect & r,unsigned int flags/*=0*/){
 	return new TreeView(*this,r,"",flags);
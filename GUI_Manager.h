@@ -11,14 +11,21 @@
 #ifndef GUI_MANAGER_H
 #define GUI_MANAGER_H
 
+#include "Base/Animator.h"
 #include "Base/Listener.h"
+#include "Base/PostQueue.h"
+#include "Base/TimerWheel.h"
 #include "Components/Component.h"
 #include <Util/Graphics/Color.h>
-#include <Util/Registry.h>
 #include <Util/AttributeProvider.h>
+#include <Util/StringIdentifier.h>
+#include <Util/UI/Event.h>
 
 #include <list>
+#include <memory>
+#include <mutex>
 #include <stack>
+#include <unordered_map>
 #include <utility>
 
 // Forward declarations
@@ -32,6 +39,7 @@ class EventContext;
 struct KeyboardEvent;
 struct MotionEvent;
 class Window;
+class WorkerPool;
 }
 }
 
@@ -46,6 +54,7 @@ class AbstractShape;
 class Button;
 class Checkbox;
 class Connector;
+class DrawList;
 class EditorPanel;
 class Icon;
 class Image;
@@ -56,10 +65,12 @@ class NextColumn;
 class NextRow;
 class Menu;
 class Panel;
+class Plot;
 class DisplayProperty;
 class Slider;
 class Splitter;
 class TabbedPanel;
+class Table;
 class Textarea;
 class Textfield;
 class Window;
@@ -104,6 +115,9 @@ class GUI_Manager {
 	#else // GUI_BACKEND_RENDERING
 		GUIAPI void display();
 	#endif // GUI_BACKEND_RENDERING
+		/*! Like display(), but the frame is recorded into a draw list instead of being drawn. The list can be
+			submitted by another thread owning the graphics context (see Draw::submit() and RenderThread).	*/
+		GUIAPI std::shared_ptr<const DrawList> recordFrame(const Geometry::Vec2i & screenSize);
 		GUIAPI Geometry::Rect getScreenRect()const;
 		GUIAPI void setScreenSize(const Geometry::Vec2& size);
 
@@ -122,6 +136,56 @@ class GUI_Manager {
 		Util::UI::EventContext * eventContext;
 		Util::UI::Window * window;
 		std::string alternativeClipboard; // used if no window is available to provide the clipboard.
+
+		//! (internal) Process the pending work and draw the frame between begin and end of drawing (or recording).
+		void displayFrame();
+	//	@}
+
+	// ----------
+
+	//! @name Batched event processing
+	//	@{
+	public:
+		/*! Queue an event for processing in processQueuedEvents() (called at the beginning of display()).
+			Consecutive mouse motion events (without any other event in between) are collapsed into a single
+			event with the latest position and the accumulated delta. */
+		GUIAPI void queueEvent(const Util::UI::Event & e);
+		//! Dispatch all queued events. Returns true if at least one event has been consumed.
+		GUIAPI bool processQueuedEvents();
+		bool hasQueuedEvents()const								{	return !eventQueue.empty();	}
+
+		/*! Opt-in for the full history of mouse motion events (e.g. for drawing widgets).
+			While enabled (by at least one caller), the motion events collapsed into one dispatched event
+			are recorded and are accessible via getMotionHistory() inside the motion listeners. */
+		void enableMotionHistory()								{	++motionHistoryUsers;	}
+		void disableMotionHistory()								{	if(motionHistoryUsers>0) --motionHistoryUsers;	}
+		bool isMotionHistoryEnabled()const						{	return motionHistoryUsers>0;	}
+
+		/*! The raw motion events represented by the currently dispatched motion event (oldest first).
+			If the history is not enabled (or the event has not been queued), it only contains the dispatched event. */
+		const std::vector<Util::UI::MotionEvent> & getMotionHistory()const	{	return currentMotionHistory;	}
+
+		//! Number of events passed to handleEvent(...) or queueEvent(...).
+		uint64_t getReceivedEventCount()const					{	return receivedEventCount;	}
+		//! Number of events actually dispatched to the components (received minus collapsed events).
+		uint64_t getDispatchedEventCount()const					{	return dispatchedEventCount;	}
+		void resetEventCounters()								{	receivedEventCount = dispatchedEventCount = 0;	}
+
+	private:
+		struct QueuedEvent{
+			Util::UI::Event event;
+			size_t historyBegin;	// range in queuedMotionHistory
+			size_t historyEnd;
+		};
+		std::vector<QueuedEvent> eventQueue;
+		std::vector<Util::UI::MotionEvent> queuedMotionHistory;
+		std::vector<Util::UI::MotionEvent> currentMotionHistory;
+		uint32_t motionHistoryUsers;
+		uint64_t receivedEventCount;
+		uint64_t dispatchedEventCount;
+
+		//! (internal) Dispatch a single event to the components.
+		GUIAPI bool dispatchEvent(const Util::UI::Event & e);
 	//	@}
 
 	// --------------------------------------------------------------------------------
@@ -129,13 +193,14 @@ class GUI_Manager {
 	//! @name Animation handling
 	//	@{
 	public:
-		GUIAPI void addAnimationHandler(AnimationHandler * );
-		GUIAPI void finishAnimations(Component * c);
-		GUIAPI void stopAnimations(Component * c);
+		//! Start the animation; the GUI_Manager takes ownership of the handler.
+		GUIAPI Animator::handle_t addAnimationHandler(AnimationHandler * );
+		void finishAnimations(Component * c)						{	animator.finishAnimations(c);	}
+		void stopAnimations(Component * c)							{	animator.stopAnimations(c);	}
+		Animator & getAnimator()									{	return animator;	}
 	private:
 		GUIAPI void executeAnimations();
-		typedef std::vector<std::unique_ptr<AnimationHandler>> animationHandlerList_t;
-		animationHandlerList_t animationHandlerList;
+		Animator animator;
 	//	@}
 
 	// ----------
@@ -192,58 +257,90 @@ class GUI_Manager {
 
 	//! @name Event handling & Listener
 	//	@{
+	/*	Action listeners are either registered for a single action name or as wildcard listener receiving
+		all actions. An action is passed to the listeners of its name first and then to the wildcard listeners.	*/
 	private:
-		ActionListenerRegistry actionListener;
+		ActionListenerRegistry actionListener; // wildcard listeners
+		typedef std::unordered_map<uint32_t, ActionListenerRegistry> NamedActionListenerMap; // action name's value -> listeners
+		NamedActionListenerMap namedActionListener;
 	public:
+		//! Register a wildcard listener receiving all actions.
 		ActionListenerHandle addActionListener(HandleActionFun fun) {
 			return actionListener.registerElement(std::move(fun));
 		}
 		void removeActionListener(ActionListenerHandle handle) {
 			actionListener.unregisterElement(std::move(handle));
 		}
+		//! Register a listener receiving only the actions with the given name.
+		ActionListenerHandle addActionListener(const Util::StringIdentifier & actionName, HandleActionFun fun) {
+			return namedActionListener[actionName.getValue()].registerElement(std::move(fun));
+		}
+		void removeActionListener(const Util::StringIdentifier & actionName, ActionListenerHandle handle) {
+			const auto it = namedActionListener.find(actionName.getValue());
+			if(it != namedActionListener.end()) {
+				it->second.unregisterElement(std::move(handle));
+				if(it->second.empty()) {
+					namedActionListener.erase(it);
+				}
+			}
+		}
 
+	/*	The component specific listeners are stored in the components (see Component::_accessListeners).
+		After removing a listener, Component::_updateListenerKinds() clears the listener bits and releases
+		the registries if the component has no more listeners.
+		The handles are taken from a counter of the GUI_Manager, so a stale handle never matches a listener
+		registered later. A listener has to be removed before its component is destroyed; the destruction of
+		a component releases all of its listeners.	*/
 	private:
-		typedef std::unordered_map<const Component *, ComponentDestructionListenerRegistry> ComponentDestructionListenerMap;
-		ComponentDestructionListenerMap componentDestructionListener;
+		uint32_t lastComponentListenerHandle;
+
+		//! (internal) Access the registries of the component for registering a listener of the given kind.
+		Component::ListenerRegistries & accessComponentListeners(const Component * component, Component::listenerKind_t kind) {
+			return component->_accessListeners(kind);
+		}
+		//! (internal) Returns the registries if the component has listeners of the given kind.
+		Component::ListenerRegistries * findComponentListeners(const Component * component, Component::listenerKind_t kind) const {
+			return component->hasListeners(kind) ? component->_getListeners() : nullptr;
+		}
+		//! (internal) Has to be called after a listener of the component has been removed.
+		void componentListenerRemoved(const Component * component) {
+			component->_updateListenerKinds();
+		}
 	public:
 		ComponentDestructionListenerHandle addComponentDestructionListener(const Component * component, 
 																		   HandleComponentDestructionFun fun) {
-			return componentDestructionListener[component].registerElement(std::move(fun));
+			return accessComponentListeners(component, Component::LISTENER_COMPONENT_DESTRUCTION).componentDestruction.registerElement(std::move(fun), ++lastComponentListenerHandle);
 		}
 		void removeComponentDestructionListener(const Component * component, 
 												ComponentDestructionListenerHandle handle) {
-			const auto it = componentDestructionListener.find(component);
-			if(it != componentDestructionListener.cend()) {
-				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
-					componentDestructionListener.erase(it);
-				}
+			if(Component::ListenerRegistries * registries = findComponentListeners(component, Component::LISTENER_COMPONENT_DESTRUCTION)) {
+				registries->componentDestruction.unregisterElement(std::move(handle));
+				componentListenerRemoved(component);
 			}
 		}
 
 	private:
-		typedef std::unordered_map<Component *, DataChangeListenerRegistry> DataChangeListenerMap;
-		DataChangeListenerMap dataChangeListener;
+		DataChangeListenerRegistry globalDataChangeListener;
 	public:
 		DataChangeListenerHandle addDataChangeListener(Component * component, HandleDataChangeFun fun) {
-			return dataChangeListener[component].registerElement(std::move(fun));
+			if(component == nullptr) {
+				return addGlobalDataChangeListener(std::move(fun));
+			}
+			return accessComponentListeners(component, Component::LISTENER_DATA_CHANGE).dataChange.registerElement(std::move(fun), ++lastComponentListenerHandle);
 		}
 		void removeDataChangeListener(Component * component, DataChangeListenerHandle handle) {
-			const auto it = dataChangeListener.find(component);
-			if(it != dataChangeListener.cend()) {
-				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
-					dataChangeListener.erase(it);
-				}
+			if(component == nullptr) {
+				removeGlobalDataChangeListener(std::move(handle));
+			} else if(Component::ListenerRegistries * registries = findComponentListeners(component, Component::LISTENER_DATA_CHANGE)) {
+				registries->dataChange.unregisterElement(std::move(handle));
+				componentListenerRemoved(component);
 			}
 		}
 		DataChangeListenerHandle addGlobalDataChangeListener(HandleDataChangeFun fun) {
-			// Use nullptr as component to access global registry.
-			return addDataChangeListener(nullptr, std::move(fun));
+			return globalDataChangeListener.registerElement(std::move(fun));
 		}
 		void removeGlobalDataChangeListener(DataChangeListenerHandle handle) {
-			// Use nullptr as component to access global registry.
-			removeDataChangeListener(nullptr, std::move(handle));
+			globalDataChangeListener.unregisterElement(std::move(handle));
 		}
 
 	private:
@@ -256,62 +353,49 @@ class GUI_Manager {
 			frameListener.unregisterElement(std::move(handle));
 		}
 
-	private:
-		typedef std::unordered_map<Component *, KeyListenerRegistry> KeyListenerMap;
-		KeyListenerMap keyListener;
 	public:
 		KeyListenerHandle addKeyListener(Component * component, HandleKeyFun fun) {
-			return keyListener[component].registerElement(std::move(fun));
+			return accessComponentListeners(component, Component::LISTENER_KEY).key.registerElement(std::move(fun), ++lastComponentListenerHandle);
 		}
 		void removeKeyListener(Component * component, KeyListenerHandle handle) {
-			const auto it = keyListener.find(component);
-			if(it != keyListener.cend()) {
-				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
-					keyListener.erase(it);
-				}
+			if(Component::ListenerRegistries * registries = findComponentListeners(component, Component::LISTENER_KEY)) {
+				registries->key.unregisterElement(std::move(handle));
+				componentListenerRemoved(component);
 			}
 		}
 
 	private:
-		typedef std::unordered_map<Component *, MouseButtonListenerRegistry> MouseButtonListenerMap;
-		MouseButtonListenerMap mouseButtonListener;
+		MouseButtonListenerRegistry globalMouseButtonListener;
 	public:
 		MouseButtonListenerHandle addMouseButtonListener(Component * component, HandleMouseButtonFun fun) {
-			return mouseButtonListener[component].registerElement(std::move(fun));
+			if(component == nullptr) {
+				return addGlobalMouseButtonListener(std::move(fun));
+			}
+			return accessComponentListeners(component, Component::LISTENER_MOUSE_BUTTON).mouseButton.registerElement(std::move(fun), ++lastComponentListenerHandle);
 		}
 		void removeMouseButtonListener(Component * component, MouseButtonListenerHandle handle) {
-			const auto it = mouseButtonListener.find(component);
-			if(it != mouseButtonListener.cend()) {
-				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
-					mouseButtonListener.erase(it);
-				}
+			if(component == nullptr) {
+				removeGlobalMouseButtonListener(std::move(handle));
+			} else if(Component::ListenerRegistries * registries = findComponentListeners(component, Component::LISTENER_MOUSE_BUTTON)) {
+				registries->mouseButton.unregisterElement(std::move(handle));
+				componentListenerRemoved(component);
 			}
 		}
 		MouseButtonListenerHandle addGlobalMouseButtonListener(HandleMouseButtonFun fun) {
-			// Use nullptr as component to access global registry.
-			return addMouseButtonListener(nullptr, std::move(fun));
+			return globalMouseButtonListener.registerElement(std::move(fun));
 		}
 		void removeGlobalMouseButtonListener(MouseButtonListenerHandle handle) {
-			// Use nullptr as component to access global registry.
-			removeMouseButtonListener(nullptr, std::move(handle));
+			globalMouseButtonListener.unregisterElement(std::move(handle));
 		}
 
-	private:
-		typedef std::unordered_map<Component *, MouseClickListenerRegistry> MouseClickListenerMap;
-		MouseClickListenerMap mouseClickListener;
 	public:
 		MouseClickListenerHandle addMouseClickListener(Component * component, HandleMouseClickFun fun) {
-			return mouseClickListener[component].registerElement(std::move(fun));
+			return accessComponentListeners(component, Component::LISTENER_MOUSE_CLICK).mouseClick.registerElement(std::move(fun), ++lastComponentListenerHandle);
 		}
 		void removeMouseClickListener(Component * component, MouseClickListenerHandle handle) {
-			const auto it = mouseClickListener.find(component);
-			if(it != mouseClickListener.cend()) {
-				it->second.unregisterElement(std::move(handle));
-				if(it->second.getElements().empty()) {
-					mouseClickListener.erase(it);
-				}
+			if(Component::ListenerRegistries * registries = findComponentListeners(component, Component::LISTENER_MOUSE_CLICK)) {
+				registries->mouseClick.unregisterElement(std::move(handle));
+				componentListenerRemoved(component);
 			}
 		}
 
@@ -337,11 +421,53 @@ class GUI_Manager {
 		GUIAPI void enableKeyRepetition(const Util::UI::KeyboardEvent & keyEvent);
 		GUIAPI void disableKeyRepetition();
 	private:
-		std::unique_ptr<std::pair<float,Util::UI::KeyboardEvent>> keyRepeatInfo; // next activation time(sec), keyboard event
+		std::unique_ptr<Util::UI::KeyboardEvent> repeatedKeyEvent;
+		TimerWheel::handle_t keyRepeatTimer;
+		GUIAPI void scheduleKeyRepetition(double delay);
 
 		GUIAPI bool handleMouseMovement(const Util::UI::MotionEvent & motionEvent);
 		GUIAPI bool handleMouseButton(const Util::UI::ButtonEvent & buttonEvent);
 		GUIAPI bool handleKeyEvent(const Util::UI::KeyboardEvent & keyEvent);
+		//! (internal) Inform the data change listeners of the component and the global ones.
+		GUIAPI void dispatchDataChange(Component * component);
+	//	@}
+
+	// ----------
+
+	/*! @name Deferred data change notifications
+		In deferred mode, componentDataChanged() only records the component; the listeners are informed
+		once per component when flushDataChanges() is called, which happens in display() after the
+		events and timers have been processed. Components destroyed before are not reported.	*/
+	//	@{
+	public:
+		struct DataChangeStatistics{
+			size_t reportedCount;	//!< number of calls of componentDataChanged()
+			size_t dispatchedCount;	//!< number of notifications sent to the listeners
+			DataChangeStatistics() : reportedCount(0),dispatchedCount(0) {}
+			size_t getCoalescedCount()const		{	return reportedCount-dispatchedCount;	}
+		};
+
+		//! When disabling the deferred mode, the pending notifications are sent.
+		GUIAPI void setDataChangesDeferred(bool b);
+		bool areDataChangesDeferred()const								{	return deferDataChanges;	}
+		bool hasPendingDataChanges()const								{	return !pendingDataChangeIndices.empty();	}
+		//! Inform the listeners of all components that changed since the last call.
+		GUIAPI void flushDataChanges();
+
+		const DataChangeStatistics & getDataChangeStatistics()const	{	return dataChangeStatistics;	}
+		//! Statistics of a single component (only collected in deferred mode).
+		GUIAPI DataChangeStatistics getDataChangeStatistics(const Component * c)const;
+		GUIAPI void resetDataChangeStatistics();
+	private:
+		bool deferDataChanges;
+		//! Changed components in the order of their first change; destroyed components are set to nullptr.
+		std::vector<Component *> pendingDataChanges;
+		std::unordered_map<const Component *,size_t> pendingDataChangeIndices;
+		//! The components whose listeners are informed by the running flushDataChanges(); same layout as the pending ones.
+		std::vector<Component *> dispatchedDataChanges;
+		std::unordered_map<const Component *,size_t> dispatchedDataChangeIndices;
+		DataChangeStatistics dataChangeStatistics;
+		std::unordered_map<const Component *,DataChangeStatistics> componentDataChangeStatistics;
 	//	@}
 
 	// ----------
@@ -366,10 +492,12 @@ class GUI_Manager {
 		GUIAPI Menu * createMenu(flag_t flags=0);
 		GUIAPI NextColumn * createNextColumn(float additionalSpacing=0.0f);
 		GUIAPI NextRow * createNextRow(float additionalSpacing=0.0f);
+		GUIAPI Plot * createPlot(const Geometry::Rect & r,flag_t flags=0);
 		GUIAPI Slider * createSlider(const Geometry::Rect & r,float left=0,float right=1,int steps=10,flag_t flags=0);
 		GUIAPI Splitter * createVSplitter(flag_t flags=0);
 		GUIAPI Splitter * createHSplitter(flag_t flags=0);
 		GUIAPI TabbedPanel * createTabbedPanel(flag_t flags=0);
+		GUIAPI Table * createTable(flag_t flags=0);
 		GUIAPI Textarea * createTextarea(const std::string &text="",flag_t flags=0);
 		GUIAPI Textfield * createTextfield(const std::string &text="",flag_t flags=0);
 		GUIAPI TreeView * createTreeView(const Geometry::Rect & r,flag_t flags=0);
@@ -393,6 +521,96 @@ class GUI_Manager {
 
 	// ----------
 
+	/*! @name Parallel layout
+		Opt-in: The enabled children marked with Component::INDEPENDENT_LAYOUT are layouted in parallel by a pool
+		of threads. While the parallel layout is running, the GUI's shared state (invalidated regions, removal list,
+		component destruction, data changes and the pool allocator) is locked and data change notifications are
+		deferred until the layout of the subtrees is finished. Every thread uses its own style stack.	*/
+	//	@{
+	private:
+		std::unique_ptr<WorkerPool> layoutWorkerPool;
+		bool parallelLayoutRunning;
+		bool dataChangesDeferredBeforeParallelLayout;
+		std::recursive_mutex sharedStateMutex;
+	public:
+		//! Use up to @p count threads (including the GUI's thread) for the layout; a value <= 1 disables the parallel layout (default).
+		GUIAPI void setLayoutThreadCount(size_t count);
+		GUIAPI size_t getLayoutThreadCount()const;
+		bool isParallelLayoutRunning()const								{	return parallelLayoutRunning;	}
+
+		/*! (internal) Used by Component::layoutChildren(): Returns the worker pool and enables the locking of the shared state;
+			nullptr if the parallel layout is disabled or already running.	*/
+		GUIAPI WorkerPool * _beginParallelLayout();
+		//! (internal) Disables the locking and sends the data change notifications deferred in the meantime.
+		GUIAPI void _endParallelLayout();
+		//! (internal) Lock for the shared state; it only locks while the parallel layout is running.
+		std::unique_lock<std::recursive_mutex> _lockSharedState()		{
+			return parallelLayoutRunning ? std::unique_lock<std::recursive_mutex>(sharedStateMutex) : std::unique_lock<std::recursive_mutex>();
+		}
+	//	@}
+
+	// ----------
+
+	//! @name Posted tasks
+	//	@{
+	private:
+		PostQueue postQueue;
+		double postedTaskTimeBudget;
+	public:
+		/*! (thread safe) Execute the task in the GUI's thread. The posted tasks are executed in their posting order
+			in display() after the queued events; if executing them takes longer than the posted task time budget,
+			the remaining tasks are executed in the following frames.
+			\note To wake up an idle main loop when a task is posted, set a notifier at getPostQueue().	*/
+		void post(PostQueue::task_t task)								{	postQueue.post(std::move(task));	}
+
+		//! Maximal time (in seconds) spent per frame for executing posted tasks (at least one task is executed).
+		void setPostedTaskTimeBudget(double seconds)					{	postedTaskTimeBudget = seconds;	}
+		double getPostedTaskTimeBudget()const							{	return postedTaskTimeBudget;	}
+
+		//! Access to the queue's statistics (e.g. for detecting a backlog) and notifier.
+		PostQueue & getPostQueue()										{	return postQueue;	}
+	//	@}
+
+	// ----------
+
+	//! @name Timers
+	//	@{
+	private:
+		TimerWheel timerWheel;
+	public:
+		/*! Central timer service for time driven tasks (e.g. tooltips and key repetition). The due timers
+			are executed at the beginning of display(); the next deadline is included in getNextWakeupTime().	*/
+		TimerWheel & getTimerWheel()									{	return timerWheel;	}
+	//	@}
+
+	// ----------
+
+	//! @name Idle handling
+	//	@{
+	public:
+		/*! Returns true iff something changed since the last call of display() that requires a new frame:
+			An event has been handled, a region or a layout has been invalidated, an animation is running or
+			components are waiting for their removal. If false is returned (and the wakeup time is not reached),
+			the application may skip calling display() and keep the last frame. */
+		GUIAPI bool needsRedraw()const;
+
+		/*! Returns the time (in seconds, see Util::Timer::now()) at which display() should be called
+			even if needsRedraw() returns false (e.g. for showing a tooltip or for repeating a key).
+			If nothing is scheduled, infinity is returned. */
+		GUIAPI double getNextWakeupTime()const;
+
+		//! Force the next call of needsRedraw() to return true.
+		void requestRedraw()							{	redrawRequested = true;	}
+
+		/*! Request a call of display() not later than the given time (in seconds, see Util::Timer::now()).
+			Each request is kept as an empty timer of the timer wheel until it is due.	*/
+		void requestWakeup(double time)					{	timerWheel.schedule(time,[](double){});	}
+	private:
+		std::atomic<bool> redrawRequested; // may be set by the layout threads
+	//	@}
+
+	// ----------
+
 	//! @name Properties, shapes, style and mouse cursor
 	//	@{
 	private:
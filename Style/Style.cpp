@@ -127,12 +127,24 @@ void Style::initStyleManager(StyleManager & m){
 	m.setGlobalValue(PROPERTY_TEXTFIELD_INDENTATION , 3);
 	m.setGlobalValue(PROPERTY_TEXTFIELD_CLEAR_BUTTON_SIZE , 6);
 
+	// table
+	m.setDefaultShape(PROPERTY_TABLE_HEADER_SHAPE , new Rect3dShape(Colors::BUTTON_BG_1,Colors::BUTTON_BG_2,false));
+	m.setDefaultShape(PROPERTY_TABLE_MARKED_ROW_SHAPE , new RectShape( Colors::SELECTED_TEXT_BG,Colors::NO_COLOR,true));
+	m.setDefaultShape(PROPERTY_TABLE_CURSOR_SHAPE , new RectShape( Colors::NO_COLOR,Colors::ACTIVE_COLOR_1,true));
+	m.setDefaultColor(PROPERTY_TABLE_GRID_COLOR , Colors::LIGHT_BORDER_COLOR);
+	m.setGlobalValue(PROPERTY_TABLE_DEFAULT_ROW_HEIGHT , 15);
+	m.setGlobalValue(PROPERTY_TABLE_DEFAULT_COLUMN_WIDTH , 100);
+	// plot
+	m.setDefaultShape(PROPERTY_PLOT_SHAPE , new RectShape(Colors::TEXTFIELD_BG,Colors::TEXTFIELD_BORDER,true));
+	m.setDefaultColor(PROPERTY_PLOT_GRID_COLOR , Colors::LIGHT_BORDER_COLOR);
+
 	// treeview
 	m.setDefaultShape(PROPERTY_TREEVIEW_SUBROUP_SHAPE , new TriangleSelectorShape(Colors::ACTIVE_COLOR_1));
 	m.setDefaultShape(PROPERTY_TREEVIEW_ENTRY_SELECTION_SHAPE , new RectShape( Colors::NO_COLOR,Colors::BRIGHT_COLOR,true));
 	m.setDefaultShape(PROPERTY_TREEVIEW_ENTRY_MARKING_SHAPE , new RectShape( Colors::SELECTED_TEXT_BG,Colors::NO_COLOR,true));
 	m.setDefaultShape(PROPERTY_TREEVIEW_ACTIVE_INDENTATION_SHAPE , new RectShape( Colors::ACTIVE_COLOR_1,Colors::NO_COLOR,true));
 	m.setDefaultShape(PROPERTY_TREEVIEW_PASSIVE_INDENTATION_SHAPE , new RectShape( Colors::PASSIVE_COLOR_2,Colors::NO_COLOR,true));
+	m.setGlobalValue(PROPERTY_TREEVIEW_DEFAULT_ENTRY_HEIGHT , 15);
 
 	// window
 	m.setDefaultShape(PROPERTY_WINDOW_RESIZER_SHAPE , new ResizerShape(Colors::DARK_COLOR,true));
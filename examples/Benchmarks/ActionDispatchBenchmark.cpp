@@ -0,0 +1,69 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/Button.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/StringIdentifier.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Action dispatch with thousands of registered actions
+ *
+ * Compares listeners registered for their action name (hashed dispatch)
+ * with wildcard listeners that compare the action name themselves, which
+ * is how all listeners were dispatched before named registration existed.
+ */
+
+static const size_t NUM_ACTIONS = 5000;
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	std::vector<Util::StringIdentifier> actionNames;
+	for(size_t i = 0; i < NUM_ACTIONS; ++i)
+		actionNames.emplace_back("ACTION_Benchmark_" + std::to_string(i));
+
+	size_t handledCount = 0;
+	const size_t repetitions = 2000;
+	{
+		GUI::GUI_Manager gui;
+		Util::Reference<GUI::Button> button = gui.createButton("button");
+		for(const auto & name : actionNames)
+			gui.addActionListener(name, [&handledCount](GUI::Component *, const Util::StringIdentifier &) {
+				++handledCount;
+				return true;
+			});
+		size_t i = 0;
+		GUIBenchmark::measure("named listeners (5000 actions)", repetitions, [&]() {
+			gui.componentActionPerformed(button.get(), actionNames[(i++ * 7919) % NUM_ACTIONS]);
+		});
+	}
+	{
+		GUI::GUI_Manager gui;
+		Util::Reference<GUI::Button> button = gui.createButton("button");
+		for(const auto & name : actionNames)
+			gui.addActionListener([&handledCount, name](GUI::Component *, const Util::StringIdentifier & actionName) {
+				if(actionName.toString() != name.toString())
+					return false;
+				++handledCount;
+				return true;
+			});
+		size_t i = 0;
+		GUIBenchmark::measure("wildcard listeners comparing names (5000 actions)", repetitions, [&]() {
+			gui.componentActionPerformed(button.get(), actionNames[(i++ * 7919) % NUM_ACTIONS]);
+		});
+	}
+	std::cout << "handled actions: " << handledCount << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Base/Animator.h>
+#include <Base/TweenAnimation.h>
+#include <Components/Container.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Scaling of the GUI::Animator with thousands of concurrent animations
+ *
+ * Every component gets a position and a rect tween. The benchmark measures
+ * a frame (GUI::Animator::execute), stopping the animations of single
+ * components and canceling single animations by handle.
+ */
+
+static void runBenchmark(GUI::GUI_Manager & gui, size_t componentCount) {
+	const std::string suffix = " (" + std::to_string(2 * componentCount) + " animations)";
+	GUI::Animator animator;
+	std::vector<Util::Reference<GUI::Container>> components;
+	std::vector<GUI::Animator::handle_t> handles;
+	for(size_t i = 0; i < componentCount; ++i) {
+		GUI::Container * c = gui.createContainer(Geometry::Rect(0, 0, 10, 10));
+		components.emplace_back(c);
+		handles.push_back(animator.add(GUI::createPositionTween(c, Geometry::Vec2(100, 100), 1000.0f), 0.0f));
+		animator.add(GUI::createRectTween(c, Geometry::Rect(10, 10, 50, 50), 1000.0f, GUI::EASE_IN_OUT_QUAD), 0.0f);
+	}
+
+	float time = 0.0f;
+	GUIBenchmark::measure("execute one frame" + suffix, 100, [&]() {
+		time += 0.016f;
+		animator.execute(time);
+	});
+	// stop the animations of every second component, one component at a time
+	GUIBenchmark::measure("stopAnimations of half of the components" + suffix, 1, [&]() {
+		for(size_t i = 0; i < componentCount; i += 2)
+			animator.stopAnimations(components[i].get());
+	});
+	GUIBenchmark::measure("cancel the remaining position tweens by handle" + suffix, 1, [&]() {
+		for(size_t i = 1; i < componentCount; i += 2)
+			animator.cancel(handles[i]);
+	});
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	for(size_t count = 1000; count <= 64000; count *= 4)
+		runBenchmark(gui, count);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#ifndef GUI_BENCHMARK_H
+#define GUI_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @file
+ * @brief Helper for the benchmarks of the GUI library
+ *
+ * The benchmarks run headless (a GUI::GUI_Manager without event context and
+ * window) unless stated otherwise, and print the average duration of each
+ * measured operation.
+ */
+namespace GUIBenchmark {
+
+//! Execute @p fun @p repetitions times, print and return the average duration in milliseconds.
+template<typename fun_t>
+double measure(const std::string & name, size_t repetitions, fun_t fun) {
+	const auto start = std::chrono::steady_clock::now();
+	for(size_t i = 0; i < repetitions; ++i)
+		fun();
+	const double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+	std::cout << std::left << std::setw(56) << name << std::right << std::fixed << std::setprecision(3)
+				<< std::setw(12) << duration << " ms" << std::endl;
+	return duration;
+}
+
+}
+
+#endif // GUI_BENCHMARK_H
@@ -0,0 +1,69 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/Label.h>
+#include <Components/ListView.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Inserting 100k entries into a GUI::ListView
+ *
+ * Compares the batch operations (insertContents, removeContents,
+ * replaceContents) with adding the entries one by one.
+ */
+
+static const size_t NUM_ENTRIES = 100000;
+
+static std::vector<GUI::Component::Ref> createEntries(GUI::GUI_Manager & gui, size_t count) {
+	std::vector<GUI::Component::Ref> entries;
+	entries.reserve(count);
+	for(size_t i = 0; i < count; ++i)
+		entries.emplace_back(gui.createLabel("entry " + std::to_string(i)));
+	return entries;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::ListView> listView = gui.createListView();
+	listView->setRect(Geometry::Rect(0, 0, 400, 600));
+
+	auto entries = createEntries(gui, NUM_ENTRIES);
+	GUIBenchmark::measure("insertContents: 100k entries as one batch", 1, [&]() {
+		listView->insertContents(0, entries);
+		listView->layout();
+	});
+	auto moreEntries = createEntries(gui, NUM_ENTRIES / 10);
+	GUIBenchmark::measure("insertContents: 10k entries in the middle", 1, [&]() {
+		listView->insertContents(NUM_ENTRIES / 2, moreEntries);
+		listView->layout();
+	});
+	GUIBenchmark::measure("removeContents: 10k entries from the middle", 1, [&]() {
+		listView->removeContents(NUM_ENTRIES / 2, NUM_ENTRIES / 10);
+		listView->layout();
+	});
+	GUIBenchmark::measure("replaceContents: 100k entries", 1, [&]() {
+		listView->replaceContents(createEntries(gui, NUM_ENTRIES));
+		listView->layout();
+	});
+
+	listView->clearContents();
+	GUIBenchmark::measure("addContent: 100k entries one by one", 1, [&]() {
+		for(const auto & entry : entries)
+			listView->addContent(entry);
+		listView->layout();
+	});
+	return EXIT_SUCCESS;
+}
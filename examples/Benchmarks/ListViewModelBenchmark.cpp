@@ -0,0 +1,75 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/AbstractListViewModel.h>
+#include <Components/Label.h>
+#include <Components/ListView.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+/**
+ * @file
+ * @brief GUI::ListView in model mode with 1M rows
+ *
+ * Measures setting the model, scrolling through the list, keyboard-like
+ * cursor movement and marking all rows. Only the rows in view are
+ * represented by components.
+ */
+
+static const size_t NUM_ROWS = 1000000;
+
+class LogModel : public GUI::AbstractListViewModel {
+	public:
+		size_t getRowCount() const override {
+			return NUM_ROWS;
+		}
+		GUI::Component::Ref createRow(GUI::GUI_Manager & gui) override {
+			return gui.createLabel("");
+		}
+		void updateRow(GUI::Component & row, size_t index) override {
+			static_cast<GUI::Label &>(row).setText("log entry " + std::to_string(index));
+		}
+		std::string getRowText(size_t index) const override {
+			return "log entry " + std::to_string(index);
+		}
+};
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::ListView> listView = gui.createListView();
+	listView->setRect(Geometry::Rect(0, 0, 400, 600));
+
+	GUIBenchmark::measure("setModel and first layout (1M rows)", 1, [&]() {
+		listView->setModel(new LogModel);
+		listView->layout();
+	});
+	std::cout << "row components: " << listView->getContentsCount() << std::endl;
+
+	size_t step = 0;
+	GUIBenchmark::measure("scroll to a random position and layout", 1000, [&]() {
+		const float y = static_cast<float>((step++ * 7919) % NUM_ROWS) * listView->getEntryHeight();
+		listView->setScrollingPosition(Geometry::Vec2(0, y));
+		listView->layout();
+	});
+	GUIBenchmark::measure("move the cursor by one row and layout", 1000, [&]() {
+		listView->moveCursor(1);
+		listView->layout();
+	});
+	GUIBenchmark::measure("mark all rows", 10, [&]() {
+		listView->clearMarkings(true);
+		listView->markAll();
+	});
+	std::cout << "row components: " << listView->getContentsCount() << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/AbstractListViewModel.h>
+#include <Components/Label.h>
+#include <Components/ListView.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Frequent row height updates in a GUI::ListView
+ *
+ * Every frame changes the heights of some rows (e.g. log entries expanding
+ * to several lines) and layouts the list, once with 100k entries as
+ * components and once with 1M rows of a model.
+ */
+
+static const size_t UPDATES_PER_FRAME = 10;
+
+class TextModel : public GUI::AbstractListViewModel {
+	public:
+		size_t getRowCount() const override {
+			return 1000000;
+		}
+		GUI::Component::Ref createRow(GUI::GUI_Manager & gui) override {
+			return gui.createLabel("");
+		}
+		void updateRow(GUI::Component & row, size_t index) override {
+			static_cast<GUI::Label &>(row).setText("row " + std::to_string(index));
+		}
+};
+
+static void runFrames(GUI::ListView & listView, const std::string & name) {
+	const size_t count = listView.getEntryCount();
+	size_t step = 0;
+	GUIBenchmark::measure(name, 1000, [&]() {
+		for(size_t i = 0; i < UPDATES_PER_FRAME; ++i, ++step)
+			listView.setRowHeight((step * 7919) % count, 15.0f + static_cast<float>(step % 4) * 15.0f);
+		listView.setScrollingPosition(Geometry::Vec2(0, listView.getRowOffset((step * 104729) % count)));
+		listView.layout();
+	});
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	{
+		Util::Reference<GUI::ListView> listView = gui.createListView();
+		listView->setRect(Geometry::Rect(0, 0, 400, 600));
+		std::vector<GUI::Component::Ref> entries;
+		for(size_t i = 0; i < 100000; ++i)
+			entries.emplace_back(gui.createLabel("entry " + std::to_string(i)));
+		listView->insertContents(0, entries);
+		listView->layout();
+		runFrames(*listView.get(), "10 height updates, scroll and layout (100k entries)");
+	}
+	{
+		Util::Reference<GUI::ListView> listView = gui.createListView();
+		listView->setRect(Geometry::Rect(0, 0, 400, 600));
+		listView->setModel(new TextModel);
+		listView->layout();
+		runFrames(*listView.get(), "10 height updates, scroll and layout (1M model rows)");
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Base/Layouters/FlowLayouter.h>
+#include <Components/Container.h>
+#include <Components/Label.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+/**
+ * @file
+ * @brief Scaling of the parallel layout
+ *
+ * A dashboard of independent pages (GUI::Component::INDEPENDENT_LAYOUT),
+ * each containing many labels arranged by a GUI::FlowLayouter, is layouted
+ * with an increasing number of layout threads.
+ */
+
+static const size_t NUM_PAGES = 64;
+static const size_t LABELS_PER_PAGE = 1000;
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::Container> dashboard = gui.createContainer(Geometry::Rect(0, 0, 4000, 4000));
+	for(size_t p = 0; p < NUM_PAGES; ++p) {
+		GUI::Container * page = gui.createContainer(Geometry::Rect(0, 0, 500, 500), GUI::Component::INDEPENDENT_LAYOUT);
+		page->addLayouter(new GUI::FlowLayouter);
+		for(size_t i = 0; i < LABELS_PER_PAGE; ++i)
+			page->addContent(gui.createLabel("value " + std::to_string(p * LABELS_PER_PAGE + i)));
+		dashboard->addContent(page);
+	}
+
+	const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for(size_t threads = 1; threads <= maxThreads; threads *= 2) {
+		gui.setLayoutThreadCount(threads);
+		GUIBenchmark::measure("layout 64 pages with 64k labels, " + std::to_string(threads) + " thread(s)", 20, [&]() {
+			dashboard->invalidateSubtreeLayout();
+			dashboard->layout();
+		});
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Base/MinMaxPyramid.h>
+#include <Components/Plot.h>
+#include <GUI_Manager.h>
+#include <Util/Graphics/Color.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file
+ * @brief A GUI::Plot with 10M samples
+ *
+ * 10M samples are appended in blocks of 10k samples. Then the visible range
+ * is zoomed from all samples to 1000 samples; every frame fits the y range and
+ * queries the minimum and maximum of the samples of each of the 1000 pixel
+ * columns (as the plot does for drawing), compared with scanning the visible
+ * samples. Finally, 1000 samples per frame are streamed into a following plot.
+ */
+
+static const size_t SAMPLE_COUNT = 10000000;
+static const size_t BLOCK_SIZE = 10000;
+static const size_t COLUMN_COUNT = 1000;
+
+static std::vector<float> createBlock(size_t first) {
+	std::vector<float> block(BLOCK_SIZE);
+	for(size_t i = 0; i < BLOCK_SIZE; ++i)
+		block[i] = std::sin(static_cast<float>(first + i) * 0.001f) + static_cast<float>((first + i) % 97) * 0.01f;
+	return block;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::Plot> plot = gui.createPlot(Geometry::Rect(0, 0, COLUMN_COUNT, 400));
+	const size_t series = plot->addSeries(Util::Color4ub(255, 0, 0, 255));
+
+	GUIBenchmark::measure("append 10M samples", 1, [&]() {
+		for(size_t first = 0; first < SAMPLE_COUNT; first += BLOCK_SIZE)
+			plot->appendSamples(series, createBlock(first));
+	});
+	const GUI::MinMaxPyramid & samples = plot->getSamples(series);
+
+	// the visible range of frame i shrinks geometrically from all samples to 1000 samples
+	const size_t frameCount = 100;
+	const auto getVisibleCount = [&](size_t frame) {
+		return static_cast<size_t>(SAMPLE_COUNT * std::pow(static_cast<double>(COLUMN_COUNT) / SAMPLE_COUNT, static_cast<double>(frame) / (frameCount - 1)));
+	};
+	float sum = 0.0f;
+	size_t frame = 0;
+	GUIBenchmark::measure("zoom frame: fit y range and query 1000 columns (pyramid)", frameCount, [&]() {
+		const size_t visibleCount = getVisibleCount(frame++);
+		const size_t first = (SAMPLE_COUNT - visibleCount) / 2;
+		plot->setXRange(first * plot->getSampleInterval(), (first + visibleCount) * plot->getSampleInterval());
+		plot->fitYRange();
+		for(size_t column = 0; column < COLUMN_COUNT; ++column) {
+			float min, max;
+			if(samples.getRange(first + visibleCount * column / COLUMN_COUNT, first + visibleCount * (column + 1) / COLUMN_COUNT, min, max))
+				sum += max - min;
+		}
+	});
+	frame = 0;
+	GUIBenchmark::measure("zoom frame: scan the visible samples", frameCount, [&]() {
+		const size_t visibleCount = getVisibleCount(frame++);
+		const size_t first = (SAMPLE_COUNT - visibleCount) / 2;
+		float min = samples.get(first);
+		float max = min;
+		for(size_t i = first; i < first + visibleCount; ++i) {
+			min = std::min(min, samples.get(i));
+			max = std::max(max, samples.get(i));
+		}
+		sum += max - min;
+	});
+
+	Util::Reference<GUI::Plot> streamingPlot = gui.createPlot(Geometry::Rect(0, 0, COLUMN_COUNT, 400));
+	const size_t streamingSeries = streamingPlot->addSeries(Util::Color4ub(0, 0, 255, 255));
+	streamingPlot->setXRange(0, 100000 * streamingPlot->getSampleInterval());
+	streamingPlot->setFollowing(true);
+	size_t streamed = 0;
+	std::vector<float> values(1000);
+	GUIBenchmark::measure("stream 1000 samples per frame and fit the y range", 10000, [&]() {
+		for(auto & value : values)
+			value = std::sin(static_cast<float>(streamed++) * 0.001f);
+		streamingPlot->appendSamples(streamingSeries, values);
+		streamingPlot->fitYRange();
+	});
+	std::cout << "checksum: " << sum << ", streamed samples: " << streamingPlot->getSamples(streamingSeries).size() << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Base/PostQueue.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @brief Posting tasks from background threads to the GUI thread
+ *
+ * Several producer threads post small tasks while the consumer executes
+ * them in frames with a time budget, as GUI::GUI_Manager::display() does.
+ * The lock-free GUI::PostQueue is compared with a mutex protected deque.
+ */
+
+static const size_t NUM_PRODUCERS = 4;
+static const size_t TASKS_PER_PRODUCER = 250000;
+static const double FRAME_BUDGET = 0.004;
+
+static double now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//! The queue used before: every post and every pop takes the lock.
+struct LockedQueue {
+	std::mutex mutex;
+	std::deque<std::function<void ()>> tasks;
+
+	void post(std::function<void ()> task) {
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	size_t execute(double timeBudget, const std::function<double ()> & clock) {
+		const double start = clock();
+		size_t count = 0;
+		while(true) {
+			std::function<void ()> task;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if(tasks.empty())
+					break;
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+			task();
+			++count;
+			if(clock() - start > timeBudget)
+				break;
+		}
+		return count;
+	}
+};
+
+//! Post and execute the tasks; prints the number of frames and the time the producers were busy posting.
+template<typename queue_t>
+static void run(queue_t & queue, const std::string & name) {
+	size_t executed = 0;
+	std::atomic<double> postingDuration(0.0);
+	std::vector<std::thread> producers;
+	GUIBenchmark::measure(name, 1, [&]() {
+		for(size_t p = 0; p < NUM_PRODUCERS; ++p) {
+			producers.emplace_back([&]() {
+				const double start = now();
+				for(size_t i = 0; i < TASKS_PER_PRODUCER; ++i)
+					queue.post([&executed]() { ++executed; });
+				const double duration = now() - start;
+				double previous = postingDuration.load();
+				while(duration > previous && !postingDuration.compare_exchange_weak(previous, duration)) {
+				}
+			});
+		}
+		size_t frames = 0;
+		while(executed < NUM_PRODUCERS * TASKS_PER_PRODUCER) {
+			queue.execute(FRAME_BUDGET, now);
+			++frames;
+		}
+		for(auto & producer : producers)
+			producer.join();
+		std::cout << "  frames: " << frames << ", longest producer: " << postingDuration.load() * 1000.0 << " ms" << std::endl;
+	});
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	{
+		GUI::PostQueue queue;
+		run(queue, "PostQueue: 4 producers, 1M tasks");
+		const auto stats = queue.getStatistics();
+		std::cout << "  executed: " << stats.executedCount << ", frames over budget: " << stats.budgetExceededCount
+					<< ", max pending: " << stats.maxPendingCount << std::endl;
+	}
+	{
+		LockedQueue queue;
+		run(queue, "mutex and deque: 4 producers, 1M tasks");
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/Button.h>
+#include <Components/Container.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+
+/**
+ * @file
+ * @brief Full-tree GUI::GUI_Manager::selectFirst on 50k components
+ *
+ * The only selectable component is the last leaf, so the whole tree is
+ * traversed. The kind-tag based implementation is compared with the same
+ * traversal using dynamic_cast.
+ */
+
+static const size_t NUM_COMPONENTS = 50000;
+static const size_t BRANCHING = 8;
+
+//! Add containers below @p parent until @p remaining components have been created.
+static void buildTree(GUI::GUI_Manager & gui, GUI::Container * parent, size_t & remaining, size_t depth) {
+	for(size_t i = 0; i < BRANCHING && remaining > 0; ++i) {
+		--remaining;
+		auto * child = new GUI::Container(gui);
+		parent->addContent(child);
+		if(depth > 0)
+			buildTree(gui, child, remaining, depth - 1);
+	}
+}
+
+//! The traversal of GUI_Manager::selectFirst using RTTI.
+static bool selectFirstDynamicCast(GUI::Component * c) {
+	if(c == nullptr)
+		return false;
+	if(c->isSelectable()) {
+		c->select();
+		return true;
+	}
+	auto * con = dynamic_cast<GUI::Container *>(c);
+	if(con == nullptr)
+		return false;
+	for(const auto & child : con->getChildren()) {
+		if(selectFirstDynamicCast(child.get()))
+			return true;
+	}
+	return false;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+
+	Util::Reference<GUI::Container> root = gui.createContainer(Geometry::Rect(0, 0, 100, 100));
+	size_t remaining = NUM_COMPONENTS - 1;
+	while(remaining > 0)
+		buildTree(gui, root.get(), remaining, 5);
+	root->addContent(gui.createButton("last"));
+
+	const size_t repetitions = 200;
+	GUIBenchmark::measure("selectFirst (50k components, castTo)", repetitions, [&]() {
+		gui.unselectAll();
+		gui.selectFirst(root.get());
+	});
+	GUIBenchmark::measure("selectFirst (50k components, dynamic_cast)", repetitions, [&]() {
+		gui.unselectAll();
+		selectFirstDynamicCast(root.get());
+	});
+	root->destroyContents();
+	return EXIT_SUCCESS;
+}
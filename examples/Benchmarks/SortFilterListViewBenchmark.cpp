@@ -0,0 +1,101 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/AbstractListViewModel.h>
+#include <Components/Label.h>
+#include <Components/ListView.h>
+#include <Components/SortFilterListViewModel.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @brief Filtering and sorting a GUI::ListView with 1M model rows
+ *
+ * A GUI::SortFilterListViewModel shows the rows of a source with 1M values.
+ * Alternating filters and sortings are applied synchronously (on the GUI's
+ * thread) and asynchronously (by the background thread, until the result is
+ * applied by executing the posted tasks); 1000 marked rows are kept at their
+ * source rows.
+ */
+
+static const size_t ROW_COUNT = 1000000;
+
+class ValueModel : public GUI::AbstractListViewModel {
+	public:
+		std::vector<uint32_t> values;
+		ValueModel() : values(ROW_COUNT) {
+			for(size_t i = 0; i < ROW_COUNT; ++i)
+				values[i] = static_cast<uint32_t>((i * 2654435761u) % ROW_COUNT);
+		}
+		size_t getRowCount() const override {
+			return values.size();
+		}
+		GUI::Component::Ref createRow(GUI::GUI_Manager & gui) override {
+			return gui.createLabel("");
+		}
+		void updateRow(GUI::Component & row, size_t index) override {
+			static_cast<GUI::Label &>(row).setText(std::to_string(values[index]));
+		}
+};
+
+static void run(GUI::GUI_Manager & gui, GUI::SortFilterListViewModel & model, const ValueModel & source, const std::string & name) {
+	const auto clock = []() {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	};
+	size_t step = 0;
+	GUIBenchmark::measure(name, 10, [&]() {
+		const uint32_t divisor = 2 + static_cast<uint32_t>(step % 3);
+		model.setFilter([&source, divisor](size_t row) {
+			return source.values[row] % divisor != 0;
+		});
+		if(step % 2 == 0) {
+			model.setSorting([&source](size_t row1, size_t row2) {
+				return source.values[row1] < source.values[row2];
+			});
+		} else {
+			model.setSorting(nullptr);
+		}
+		++step;
+		while(model.isEvaluating()) {
+			if(gui.getPostQueue().execute(1.0, clock) == 0)
+				std::this_thread::yield();
+		}
+	});
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::ListView> listView = gui.createListView();
+	listView->setRect(Geometry::Rect(0, 0, 400, 600));
+	Util::Reference<ValueModel> source = new ValueModel;
+	Util::Reference<GUI::SortFilterListViewModel> model = new GUI::SortFilterListViewModel(*listView.get(), source.get());
+	listView->setModel(model.get());
+	std::vector<size_t> marked;
+	for(size_t i = 0; i < 1000; ++i)
+		marked.push_back(i * 997);
+	listView->setMarkedIndices(marked);
+	listView->layout();
+
+	model->setAsyncThreshold(ROW_COUNT + 1);
+	run(gui, *model.get(), *source.get(), "filter and sort synchronously (1M rows)");
+	model->setAsyncThreshold(0);
+	run(gui, *model.get(), *source.get(), "filter and sort in the background (1M rows)");
+	std::cout << "rows: " << model->getRowCount() << ", marked: " << listView->getMarkedIndices().size() << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Components/Component.h>
+#include <Components/TreeView.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Opening, collapsing and marking entries of a GUI::TreeView
+ *
+ * A wide tree (1000 entries with 100 children each) and a deep tree (a chain
+ * of 1000 entries with 10 leaves each) are created. An entry in the middle is
+ * collapsed and opened again before each layout. Afterwards, 10k entries are
+ * marked and unmarked in marking order.
+ */
+
+typedef GUI::TreeView::TreeViewEntry TreeViewEntry;
+
+//! Add a label to @p parent and return the entry created for it.
+static TreeViewEntry * addEntry(GUI::GUI_Manager & gui, TreeViewEntry & parent, const std::string & text) {
+	parent.addContent(gui.createLabel(text));
+	return GUI::castTo<TreeViewEntry>(parent.getLastChild());
+}
+
+static void runToggle(GUI::TreeView & treeView, TreeViewEntry & entry, const std::string & name) {
+	treeView.layout();
+	GUIBenchmark::measure(name, 1000, [&]() {
+		entry.collapse();
+		treeView.layout();
+		entry.open();
+		treeView.layout();
+	});
+}
+
+static void runMarking(GUI::TreeView & treeView, const std::vector<TreeViewEntry *> & entries, const std::string & name) {
+	GUIBenchmark::measure(name, 10, [&]() {
+		for(auto entry : entries)
+			treeView.markEntry(entry);
+		for(auto entry : entries)
+			treeView.unmarkEntry(entry);
+	});
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	{
+		Util::Reference<GUI::TreeView> treeView = gui.createTreeView(Geometry::Rect(0, 0, 400, 600));
+		std::vector<TreeViewEntry *> entries;
+		for(size_t i = 0; i < 1000; ++i) {
+			TreeViewEntry * entry = addEntry(gui, *treeView->getRootEntry(), "entry " + std::to_string(i));
+			for(size_t j = 0; j < 100; ++j)
+				entries.push_back(addEntry(gui, *entry, "leaf " + std::to_string(j)));
+		}
+		TreeViewEntry * middle = GUI::castTo<TreeViewEntry>(entries[entries.size() / 2]->getParent());
+		runToggle(*treeView.get(), *middle, "collapse and open (wide tree, 100k entries)");
+		entries.resize(10000);
+		runMarking(*treeView.get(), entries, "mark and unmark 10k entries (wide tree)");
+	}
+	{
+		Util::Reference<GUI::TreeView> treeView = gui.createTreeView(Geometry::Rect(0, 0, 400, 600));
+		std::vector<TreeViewEntry *> chain;
+		TreeViewEntry * parent = treeView->getRootEntry();
+		for(size_t i = 0; i < 1000; ++i) {
+			TreeViewEntry * entry = addEntry(gui, *parent, "level " + std::to_string(i));
+			for(size_t j = 0; j < 10; ++j)
+				addEntry(gui, *entry, "leaf " + std::to_string(j));
+			chain.push_back(entry);
+			parent = entry;
+		}
+		runToggle(*treeView.get(), *chain[chain.size() / 2], "collapse and open (deep tree, depth 1000)");
+		runMarking(*treeView.get(), chain, "mark and unmark 1000 entries (deep tree)");
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Base/TypeAheadIndex.h>
+#include <Components/Label.h>
+#include <Components/ListView.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @brief Type-ahead search in a GUI::ListView with 100k entries
+ *
+ * The labels of the entries are collected into the list's type-ahead index
+ * (finding the Label of each entry), prefixes of growing length are searched,
+ * and the entries sharing a label (100 entries for each of 1000 labels) are
+ * cycled, which orders them by their position in the list.
+ */
+
+static const size_t ENTRY_COUNT = 100000;
+static const size_t LABEL_COUNT = 1000;
+
+static std::string getLabel(size_t i) {
+	return "Entry " + std::to_string((i * 7919) % LABEL_COUNT);
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::ListView> listView = gui.createListView();
+	std::vector<GUI::Component::Ref> entries;
+	for(size_t i = 0; i < ENTRY_COUNT; ++i)
+		entries.emplace_back(gui.createLabel(getLabel(i)));
+	listView->insertContents(0, entries);
+	GUI::TypeAheadIndex & index = listView->getTypeAheadIndex();
+
+	GUIBenchmark::measure("index 100k entries", 10, [&]() {
+		index.clear();
+		for(const auto & entry : entries)
+			index.set(reinterpret_cast<GUI::TypeAheadIndex::id_t>(entry.get()), GUI::TypeAheadIndex::findLabel(entry.get()));
+	});
+
+	size_t found = 0;
+	GUIBenchmark::measure("find 1000 prefixes", 100, [&]() {
+		GUI::TypeAheadIndex::id_t id;
+		for(size_t i = 0; i < LABEL_COUNT; ++i) {
+			const std::string prefix = GUI::TypeAheadIndex::normalize(getLabel(i));
+			if(index.find(prefix.substr(0, 1 + i % prefix.length()), id))
+				++found;
+		}
+	});
+
+	const std::string prefix = GUI::TypeAheadIndex::normalize(getLabel(0));
+	GUI::TypeAheadIndex::id_t current = 0;
+	index.find(prefix, current);
+	GUIBenchmark::measure("cycle through 100 entries with equal labels", 100, [&]() {
+		for(size_t i = 0; i < ENTRY_COUNT / LABEL_COUNT; ++i)
+			index.findNext(prefix, current, current);
+	});
+	std::cout << "found prefixes: " << found << ", entry after cycling: "
+			  << listView->getEntryIndex(reinterpret_cast<GUI::Component *>(current)) << std::endl;
+	return EXIT_SUCCESS;
+}
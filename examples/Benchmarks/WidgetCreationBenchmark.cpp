@@ -0,0 +1,69 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include "Benchmark.h"
+#include <Base/PoolAllocator.h>
+#include <Base/Properties.h>
+#include <Components/ComponentPropertyIds.h>
+#include <Components/Container.h>
+#include <Components/Label.h>
+#include <GUI_Manager.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @file
+ * @brief Creation and destruction of 100k widgets
+ *
+ * Builds a property-sheet like tree (rows of labels with a display
+ * property each) and destroys it again. The statistics of the
+ * GUI::PoolAllocator show how many allocations were served from the pools.
+ */
+
+// three components per row
+static const size_t NUM_ROWS = 100000 / 3;
+
+static void buildSheet(GUI::GUI_Manager & gui, GUI::Container * sheet) {
+	for(size_t i = 0; i < NUM_ROWS; ++i) {
+		auto * row = gui.createContainer(Geometry::Rect(0, 0, 200, 15));
+		auto * name = gui.createLabel(Geometry::Rect(0, 0, 100, 15), "name");
+		name->addProperty(new GUI::ColorProperty(GUI::PROPERTY_TEXT_COLOR, Util::Color4ub(200, 200, 200, 255)));
+		row->addContent(name);
+		row->addContent(gui.createLabel(Geometry::Rect(100, 0, 100, 15), "value"));
+		sheet->addContent(row);
+	}
+}
+
+static void printStatistics(const std::string & title) {
+	const auto stats = GUI::PoolAllocator::getDefault().getStatistics();
+	std::cout << title << ": allocations " << stats.allocationCount << ", oversized " << stats.oversizedCount
+				<< ", used " << stats.usedBytes / 1024 << " KiB, reserved " << stats.reservedBytes / 1024
+				<< " KiB in " << stats.chunkCount << " chunks" << std::endl;
+}
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::Container> sheet = gui.createContainer(Geometry::Rect(0, 0, 200, 200));
+
+	// the first run fills the pools
+	GUIBenchmark::measure("create 100k widgets (cold pools)", 1, [&]() { buildSheet(gui, sheet.get()); });
+	printStatistics("after creation");
+	GUIBenchmark::measure("destroy 100k widgets", 1, [&]() { sheet->destroyContents(); });
+	printStatistics("after destruction");
+
+	const size_t repetitions = 5;
+	GUIBenchmark::measure("create and destroy 100k widgets (warm pools)", repetitions, [&]() {
+		buildSheet(gui, sheet.get());
+		sheet->destroyContents();
+	});
+	printStatistics("after warm runs");
+	return EXIT_SUCCESS;
+}
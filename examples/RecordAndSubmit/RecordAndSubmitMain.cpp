@@ -0,0 +1,87 @@
+/*
+	This file is part of the GUI library.
+	Copyright (C) 2013 Benjamin Eikel <benjamin@eikel.org>
+	
+	This library is subject to the terms of the Mozilla Public License, v. 2.0.
+	You should have received a copy of the MPL along with this library; see the 
+	file LICENSE. If not, you can obtain one at http://mozilla.org/MPL/2.0/.
+*/
+#include <Base/DrawList.h>
+#include <Base/ImageData.h>
+#include <Base/RenderThread.h>
+#include <Components/Image.h>
+#include <GUI_Manager.h>
+#include <Util/Graphics/Bitmap.h>
+#include <Util/References.h>
+#include <Util/Util.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+/**
+ * @file
+ * @brief Headless test of recording frames and submitting them on another thread
+ *
+ * The GUI's thread records frames with GUI::GUI_Manager::recordFrame() and
+ * passes them to a GUI::RenderThread. The render thread does not draw (no
+ * graphics context is needed); it checks the recorded lists instead.
+ * After publishing a frame, the GUI's thread immediately overwrites the
+ * data of an image for the next frame. Every frame has to contain an
+ * unchanged copy of the data that was current while the frame was recorded.
+ * Run it with ThreadSanitizer to detect remaining data races.
+ */
+
+static const int NUM_FRAMES = 500;
+
+int main(int /*argc*/, char */*argv*/[]) {
+	Util::init();
+	GUI::GUI_Manager gui;
+	Util::Reference<GUI::Image> image = gui.createImage(Geometry::Rect(0, 0, 64, 64));
+	gui.registerWindow(image.get());
+	GUI::ImageData * imageData = image->getImageData();
+	const Util::Reference<Util::Bitmap> bitmap = image->getBitmap();
+
+	std::atomic<int> submittedFrames(0);
+	std::atomic<int> errors(0);
+	int lastValue = 0;
+	GUI::RenderThread renderThread([&](const GUI::DrawList & list) {
+		bool found = false;
+		for(const auto & upload : list.getTextureUploads()) {
+			if(upload.texture.get() != imageData)
+				continue;
+			found = true;
+			const uint8_t * pixels = upload.data->data();
+			const uint8_t value = pixels[0];
+			// the copy must neither be torn nor contain the data of a later frame
+			if(std::any_of(pixels, pixels + upload.data->getDataSize(), [value](uint8_t p) { return p != value; })) {
+				std::cerr << "Frame " << submittedFrames << ": texture data changed during the submission." << std::endl;
+				++errors;
+			}
+			if(value != (lastValue % 255) + 1) {
+				std::cerr << "Frame " << submittedFrames << ": unexpected texture data " << static_cast<int>(value) << "." << std::endl;
+				++errors;
+			}
+			lastValue = value;
+		}
+		if(!found) {
+			std::cerr << "Frame " << submittedFrames << ": the changed texture data is missing." << std::endl;
+			++errors;
+		}
+		++submittedFrames;
+	});
+
+	for(int frame = 0; frame < NUM_FRAMES; ++frame) {
+		uint8_t * pixels = bitmap->data();
+		std::fill(pixels, pixels + bitmap->getDataSize(), static_cast<uint8_t>((frame % 255) + 1));
+		image->dataChanged();
+		renderThread.publish(gui.recordFrame(Geometry::Vec2i(256, 256)));
+		// prepare the next frame while this one is submitted
+		std::fill(pixels, pixels + bitmap->getDataSize(), static_cast<uint8_t>(0));
+	}
+	renderThread.waitIdle();
+
+	std::cout << submittedFrames << " frames submitted, " << errors << " errors." << std::endl;
+	return (errors == 0 && submittedFrames == NUM_FRAMES) ? EXIT_SUCCESS : EXIT_FAILURE;
+}